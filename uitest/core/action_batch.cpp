@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "action_batch.h"
+
+#include "cancel_token.h"
+#include "event_clock.h"
+#include "utils/log.h"
+
+namespace OHOS::UiTest {
+using namespace std;
+
+struct BatchOpName {
+    const char* name;
+    BatchOpType type;
+};
+
+static constexpr BatchOpName OP_NAMES[] = {
+    { "click", BatchOpType::CLICK },
+    { "doubleClick", BatchOpType::DOUBLE_CLICK },
+    { "longClick", BatchOpType::LONG_CLICK },
+    { "swipe", BatchOpType::SWIPE },
+    { "key", BatchOpType::KEY },
+    { "combineKeys", BatchOpType::COMBINE_KEYS },
+    { "pressBack", BatchOpType::PRESS_BACK },
+    { "delay", BatchOpType::DELAY },
+    { "waitForIdle", BatchOpType::WAIT_FOR_IDLE },
+    { "find", BatchOpType::FIND },
+    { "assertExist", BatchOpType::ASSERT_EXIST },
+    { "clickComponent", BatchOpType::CLICK_COMPONENT },
+    { "inputText", BatchOpType::INPUT_TEXT },
+};
+static constexpr const size_t MIN_COMBINE_KEYS = 2;
+static constexpr const size_t MAX_COMBINE_KEYS = 3;
+static constexpr const uint32_t BATCH_IDLE_MS = 200;
+
+bool ActionBatch::ParseOpType(const string& name, BatchOpType& type)
+{
+    for (const auto& item : OP_NAMES) {
+        if (name == item.name) {
+            type = item.type;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* ActionBatch::GetOpName(BatchOpType type)
+{
+    for (const auto& item : OP_NAMES) {
+        if (item.type == type) {
+            return item.name;
+        }
+    }
+    return "unknown";
+}
+
+bool ActionBatch::Append(BatchOp&& op, string& err)
+{
+    int32_t index = static_cast<int32_t>(ops_.size());
+    switch (op.type) {
+        case BatchOpType::COMBINE_KEYS:
+            if (op.keys.size() < MIN_COMBINE_KEYS || op.keys.size() > MAX_COMBINE_KEYS) {
+                err = "step " + to_string(index) + ": combineKeys needs 2 or 3 keys";
+                return false;
+            }
+            break;
+        case BatchOpType::CLICK_COMPONENT:
+        case BatchOpType::INPUT_TEXT:
+            if (op.ref < 0 || op.ref >= index || ops_[op.ref].type != BatchOpType::FIND) {
+                err = "step " + to_string(index) + ": ref must point to an earlier find step";
+                return false;
+            }
+            break;
+        default:
+            break;
+    }
+    ops_.emplace_back(move(op));
+    return true;
+}
+
+size_t ActionBatch::Size() const
+{
+    return ops_.size();
+}
+
+bool ActionBatch::RunStep(Driver& driver, const BatchOp& op, vector<unique_ptr<Component>>& found)
+{
+    switch (op.type) {
+        case BatchOpType::CLICK:
+            driver.Click(op.from.x, op.from.y);
+            return true;
+        case BatchOpType::DOUBLE_CLICK:
+            driver.DoubleClick(op.from.x, op.from.y);
+            return true;
+        case BatchOpType::LONG_CLICK:
+            driver.LongClick(op.from.x, op.from.y);
+            return true;
+        case BatchOpType::SWIPE:
+            driver.Swipe(op.from.x, op.from.y, op.to.x, op.to.y, op.speed);
+            return true;
+        case BatchOpType::KEY:
+            driver.TriggerKey(op.keys.empty() ? 0 : op.keys[0]);
+            return true;
+        case BatchOpType::COMBINE_KEYS:
+            driver.TriggerCombineKeys(op.keys[0], op.keys[1], op.keys.size() == MAX_COMBINE_KEYS ? op.keys[2] : -1);
+            return true;
+        case BatchOpType::PRESS_BACK:
+            driver.PressBack();
+            return true;
+        case BatchOpType::DELAY:
+            return true;
+        case BatchOpType::WAIT_FOR_IDLE:
+            return driver.WaitForIdle(op.ms > 0 ? op.ms : BATCH_IDLE_MS, op.timeoutMs);
+        case BatchOpType::FIND:
+            found.back() = op.timeoutMs > 0 ? driver.WaitForComponent(op.on, op.timeoutMs) :
+                driver.FindComponent(op.on);
+            return found.back() != nullptr;
+        case BatchOpType::ASSERT_EXIST:
+            return driver.AssertComponentExist(op.on);
+        case BatchOpType::CLICK_COMPONENT:
+            if (!found[op.ref]) {
+                return false;
+            }
+            found[op.ref]->Click();
+            return true;
+        case BatchOpType::INPUT_TEXT:
+            if (!found[op.ref]) {
+                return false;
+            }
+            found[op.ref]->InputText(op.text);
+            return true;
+        default:
+            return false;
+    }
+}
+
+BatchResult ActionBatch::Run(Driver& driver)
+{
+    HILOG_DEBUG("ActionBatch::Run steps=%{public}zu", ops_.size());
+    BatchResult result;
+    result.steps.reserve(ops_.size());
+    // one slot per step, only FIND steps fill theirs
+    vector<unique_ptr<Component>> found;
+    found.reserve(ops_.size());
+    auto& clock = EventClock::GetInstance();
+    int64_t beginUs = clock.NowUs();
+    for (size_t i = 0; i < ops_.size(); i++) {
+        const auto& op = ops_[i];
+        found.emplace_back(nullptr);
+        int64_t startUs = clock.NowUs();
+        if (op.type == BatchOpType::DELAY) {
+            // relative to the end of the previous step, so the ui always gets the full ms however long that
+            // step ran. the delays of a batch therefore add to the time of its steps, they do not absorb it
+            clock.SleepUntilUs(startUs + MsToUs(op.ms));
+        }
+        // a stopped batch fails at the step it was about to run
+        bool success = !CancelToken::CurrentStopped() && RunStep(driver, op, found);
+        int64_t endUs = clock.NowUs();
+        BatchStepResult step;
+        step.type = op.type;
+        step.success = success;
+        step.startUs = startUs - beginUs;
+        step.durationUs = endUs - startUs;
+        result.steps.emplace_back(step);
+        if (!success) {
+            HILOG_ERROR("ActionBatch step %{public}zu (%{public}s) failed", i, GetOpName(op.type));
+            result.success = false;
+            result.failedStep = static_cast<int32_t>(i);
+            break;
+        }
+    }
+    result.totalUs = clock.NowUs() - beginUs;
+    HILOG_DEBUG("ActionBatch::Run end, success=%{public}d totalUs=%{public}lld", result.success,
+        static_cast<long long>(result.totalUs));
+    return result;
+}
+} // namespace OHOS::UiTest
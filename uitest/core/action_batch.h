@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ACTION_BATCH_H
+#define ACTION_BATCH_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "driver.h"
+
+namespace OHOS::UiTest {
+enum class BatchOpType : int32_t {
+    CLICK = 0,
+    DOUBLE_CLICK,
+    LONG_CLICK,
+    SWIPE,
+    KEY,
+    COMBINE_KEYS,
+    PRESS_BACK,
+    DELAY,
+    WAIT_FOR_IDLE,
+    FIND,
+    ASSERT_EXIST,
+    CLICK_COMPONENT,
+    INPUT_TEXT,
+};
+
+/**
+ * One step of a batch. Only the fields used by the op type are meaningful,
+ * ref is the index of an earlier FIND step whose component is the target.
+ **/
+struct BatchOp {
+    BatchOpType type = BatchOpType::DELAY;
+    Point from;
+    Point to;
+    uint32_t speed = 0;
+    vector<int32_t> keys;
+    uint32_t ms = 0;
+    uint32_t timeoutMs = 0;
+    On on;
+    int32_t ref = -1;
+    string text;
+};
+
+struct BatchStepResult {
+    BatchOpType type = BatchOpType::DELAY;
+    bool success = false;
+    int64_t startUs = 0;
+    int64_t durationUs = 0;
+};
+
+struct BatchResult {
+    bool success = true;
+    int32_t failedStep = -1;
+    int64_t totalUs = 0;
+    vector<BatchStepResult> steps;
+};
+
+/**
+ * A list of driver operations executed on the native worker in one go.
+ * Execution stops at the first failed step.
+ **/
+class ActionBatch {
+public:
+    static bool ParseOpType(const string& name, BatchOpType& type);
+    static const char* GetOpName(BatchOpType type);
+
+    // check and append one op, false with reason in err if it is invalid
+    bool Append(BatchOp&& op, string& err);
+    size_t Size() const;
+    BatchResult Run(Driver& driver);
+
+private:
+    bool RunStep(Driver& driver, const BatchOp& op, vector<unique_ptr<Component>>& found);
+    vector<BatchOp> ops_;
+};
+} // namespace OHOS::UiTest
+
+#endif // ACTION_BATCH_H
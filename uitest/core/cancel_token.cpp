@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cancel_token.h"
+
+#include <thread>
+
+namespace OHOS::UiTest {
+using namespace std;
+
+static thread_local CancelToken* g_currentToken = nullptr;
+
+CancelToken::CancelToken(uint32_t timeoutMs)
+{
+    if (timeoutMs > 0) {
+        hasDeadline_ = true;
+        deadline_ = chrono::steady_clock::now() + chrono::milliseconds(timeoutMs);
+    }
+}
+
+void CancelToken::Cancel()
+{
+    {
+        lock_guard<mutex> guard(lock_);
+        cancelled_ = true;
+    }
+    cond_.notify_all();
+}
+
+CancelReason CancelToken::GetReason() const
+{
+    if (cancelled_) {
+        return CANCEL_ABORTED;
+    }
+    if (hasDeadline_ && chrono::steady_clock::now() >= deadline_) {
+        return CANCEL_TIMEOUT;
+    }
+    return CANCEL_NONE;
+}
+
+bool CancelToken::IsStopped() const
+{
+    return GetReason() != CANCEL_NONE;
+}
+
+bool CancelToken::WaitUntil(chrono::steady_clock::time_point until)
+{
+    bool deadlineFirst = hasDeadline_ && deadline_ < until;
+    unique_lock<mutex> lock(lock_);
+    cond_.wait_until(lock, deadlineFirst ? deadline_ : until, [this]() { return cancelled_.load(); });
+    lock.unlock();
+    return !IsStopped();
+}
+
+CancelToken* CancelToken::Current()
+{
+    return g_currentToken;
+}
+
+bool CancelToken::CurrentStopped()
+{
+    return g_currentToken != nullptr && g_currentToken->IsStopped();
+}
+
+bool CancelToken::SleepUntil(chrono::steady_clock::time_point until)
+{
+    if (g_currentToken != nullptr) {
+        return g_currentToken->WaitUntil(until);
+    }
+    this_thread::sleep_until(until);
+    return true;
+}
+
+CancelScope::CancelScope(CancelToken* token) : previous_(g_currentToken)
+{
+    g_currentToken = token;
+}
+
+CancelScope::~CancelScope()
+{
+    g_currentToken = previous_;
+}
+} // namespace OHOS::UiTest
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CANCEL_TOKEN_H
+#define CANCEL_TOKEN_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace OHOS::UiTest {
+enum CancelReason : int32_t {
+    CANCEL_NONE = 0,
+    CANCEL_ABORTED,
+    CANCEL_TIMEOUT
+};
+
+/**
+ * Cooperative cancellation of one driver operation, by an explicit Cancel() or a deadline.
+ * The operation binds its token to the executing thread with a CancelScope, the native loops
+ * poll CurrentStopped() between steps and the waits of EventClock wake up as soon as it stops.
+ * Deadlines follow the steady clock, so they also hold when EventClock runs virtual time.
+ **/
+class CancelToken {
+public:
+    CancelToken() = default;
+    // timeoutMs counts from now, 0 means no deadline
+    explicit CancelToken(uint32_t timeoutMs);
+    void Cancel();
+    CancelReason GetReason() const;
+    bool IsStopped() const;
+    // block until the time point, false if the token stopped first
+    bool WaitUntil(std::chrono::steady_clock::time_point until);
+
+    // token bound to the calling thread, nullptr outside of any CancelScope
+    static CancelToken* Current();
+    static bool CurrentStopped();
+    // sleep on the calling thread, returns early (false) when the current token stops
+    static bool SleepUntil(std::chrono::steady_clock::time_point until);
+
+private:
+    std::atomic<bool> cancelled_ { false };
+    bool hasDeadline_ = false;
+    std::chrono::steady_clock::time_point deadline_;
+    std::mutex lock_;
+    std::condition_variable cond_;
+};
+
+// binds a token to the calling thread for the lifetime of the scope
+class CancelScope {
+public:
+    explicit CancelScope(CancelToken* token);
+    ~CancelScope();
+
+private:
+    CancelToken* previous_;
+};
+} // namespace OHOS::UiTest
+
+#endif // CANCEL_TOKEN_H
@@ -18,22 +18,55 @@
 #include <future>
 #include <vector>
 #include <math.h>
+#include <cfloat>
 #include <chrono>
+#include <atomic>
+#include <functional>
+#include <algorithm>
 #include "ability_delegator/ability_delegator_registry.h"
 #include "accessibility_node.h"
 #include "core/event/key_event.h"
 #include "core/event/touch_event.h"
 #include "ui_content.h"
 #include "utils/log.h"
+#include "cancel_token.h"
+#include "event_clock.h"
+#include "event_inject.h"
+#include "gesture_trace.h"
+#include "inject_limiter.h"
+#include "key_script.h"
+#include "touch_event_builder.h"
+#include "ui_metrics.h"
 
 namespace OHOS::UiTest {
 using namespace std;
 
 static constexpr const int32_t DOUBLE_CLICK = 2;
-static constexpr const char UPPER_A = 'A';
-static constexpr const char LOWER_A = 'a';
-static constexpr const char DEF_NUMBER = '0';
 static constexpr const int32_t DELAY_TIME = 100;
+static constexpr const uint32_t MIN_TAP_GAP_MS = 40;
+static constexpr const uint32_t MIN_GESTURE_MS = 100;
+static constexpr const uint32_t MAX_GESTURE_FINGERS = 10;
+static constexpr const float FINGER_SPACING = 80.0f;
+static constexpr const float HALF_TURN_DEGREES = 180.0f;
+static constexpr const int32_t WHEEL_TICK_DISTANCE = 60;
+static constexpr const int32_t WHEEL_TICKS_PER_STROKE = 5;
+static constexpr const uint32_t STROKE_REST_MS = 100;
+static constexpr const uint32_t KEY_BURST_SIZE = 16;
+static constexpr const int32_t KEY_BURST_INTERVAL = 20;
+static constexpr const size_t MAX_CLEAR_KEYS = 256;
+static constexpr const float BOUNDS_TOLERANCE = 1.0f;
+static constexpr const uint32_t IDLE_POLL_MIN_MS = 8;
+static constexpr const uint32_t IDLE_POLL_MAX_MS = 128;
+static constexpr const uint32_t SETTLE_IDLE_MS = 32;
+static constexpr const uint32_t SETTLE_TIMEOUT_MS = 1000;
+static constexpr const uint32_t WAIT_POLL_MIN_MS = 16;
+static constexpr const uint32_t WAIT_POLL_MAX_MS = 250;
+static constexpr const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static constexpr const uint64_t FNV_PRIME = 1099511628211ULL;
+static std::atomic<bool> g_idleSettle = false;
+// nesting of the open InjectBatch scopes of this thread, and whether the outermost one injected anything
+static thread_local uint32_t g_injectBatchDepth = 0;
+static thread_local bool g_injectBatchUsed = false;
 constexpr size_t INDEX_ZERO = 0;
 constexpr size_t INDEX_ONE = 1;
 constexpr size_t INDEX_TWO = 2;
@@ -41,89 +74,134 @@ constexpr size_t INDEX_THREE = 3;
 constexpr size_t INDEX_FOUR = 4;
 constexpr size_t INDEX_FIVE = 5;
 constexpr size_t INDEX_SIX = 6;
-// CombineKey
-// int32_t metaKey 参数取值: CTRL = 1,    SHIFT = 2,    ALT = 4,    META = 8,
-constexpr int32_t KEY_CTRL = 1;
-constexpr int32_t KEY_SHIFT = 2;
-constexpr int32_t KEY_ALT = 4;
-constexpr int32_t KEY_META = 8;
 
-int32_t Findkeycode(const char ch, int32_t& metaKey, int32_t& keycode)
+Ace::Platform::UIContent* GetUIContent()
 {
-    metaKey = 0;
-    if (isupper(ch)) {
-        metaKey = 2; // int32_t metaKey 参数取值: CTRL = 1,    SHIFT = 2,    ALT = 4,    META = 8,
-        keycode = static_cast<int32_t>(ch - UPPER_A) + static_cast<int32_t>(Ace::KeyCode::KEY_A);
-        return 0;
+    auto delegator = AppExecFwk::AbilityDelegatorRegistry::GetAbilityDelegator();
+    if (delegator == nullptr) {
+        HILOG_ERROR("Driver GetUIContent failed. delegator is not initialized");
+        return nullptr;
     }
+    auto topAbility = delegator->GetCurrentTopAbility();
+    CHECK_NULL_RETURN(topAbility, nullptr);
+    return delegator->GetUIContent(topAbility->instanceId_);
+}
 
-    if(islower(ch)) {
-        keycode = static_cast<int32_t>(ch - LOWER_A) + static_cast<int32_t>(Ace::KeyCode::KEY_A);
-        return 0;
+// backpressure: return once the ui thread has consumed the batch injected after beforeHash was taken,
+// that is the tree is no longer the one before it, or timeoutMs elapsed. a batch without visible effect
+// always runs into the timeout
+static void WaitInjectConsumed(uint64_t beforeHash, uint32_t timeoutMs)
+{
+    auto& clock = EventClock::GetInstance();
+    const int64_t deadlineUs = clock.NowUs() + MsToUs(timeoutMs);
+    Driver driver;
+    OHOS::Ace::Platform::ComponentInfo info;
+    uint32_t interval = IDLE_POLL_MIN_MS;
+    bool consumed = false;
+    while (!CancelToken::CurrentStopped()) {
+        int64_t nowUs = clock.NowUs();
+        if (nowUs >= deadlineUs) {
+            break;
+        }
+        clock.SleepUntilUs(min(nowUs + MsToUs(interval), deadlineUs));
+        if (driver.CaptureSnapshot(info) != beforeHash) {
+            consumed = true;
+            break;
+        }
+        interval = min(interval * 2, IDLE_POLL_MAX_MS);
+    }
+    auto& metrics = UiMetrics::GetInstance();
+    metrics.Add(METRIC_BACKPRESSURE_WAIT_COUNT, 1);
+    if (!consumed && !CancelToken::CurrentStopped()) {
+        metrics.Add(METRIC_BACKPRESSURE_TIMEOUT_COUNT, 1);
     }
+}
 
-    if (isdigit(ch)) {
-        keycode = static_cast<int32_t>(ch - DEF_NUMBER) + static_cast<int32_t>(Ace::KeyCode::KEY_0);
-        return 0;
+InjectBatch::InjectBatch() : outermost_(g_injectBatchDepth++ == 0)
+{
+    if (outermost_) {
+        Arm();
     }
+}
 
-    if (isspace(ch)) { // 空格
-        keycode = static_cast<int32_t>(Ace::KeyCode::KEY_SPACE);
-        return 0;
+InjectBatch::~InjectBatch()
+{
+    if (outermost_) {
+        Wait();
     }
-    HILOG_DEBUG("Please enter lowercase letters and numbers or space.");
-    return -1;
+    g_injectBatchDepth--;
 }
 
-bool TextToKeyCodeCheck(string text)
+bool InjectBatch::Flush()
 {
-    if (!text.empty()) {
-        vector<char> chars(text.begin(), text.end()); // decompose to sing-char input sequence
-        for (auto ch : chars) {
-            int32_t metaKey, keycode;
-            if (Findkeycode(ch, metaKey, keycode) == -1) {
-                return false;
-            }
-        }
+    if (!outermost_ || !armed_) {
+        return false;
     }
+    Wait();
+    Arm();
     return true;
 }
 
-int64_t getCurrentTimeMillis()
+void InjectBatch::Arm()
 {
-    auto now = std::chrono::system_clock::now();
-    return std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+    g_injectBatchUsed = false;
+    auto& limiter = InjectLimiter::GetInstance();
+    armed_ = limiter.IsBackpressure();
+    if (armed_) {
+        timeoutMs_ = limiter.GetBackpressureTimeoutMs();
+        OHOS::Ace::Platform::ComponentInfo info;
+        beforeHash_ = Driver().CaptureSnapshot(info);
+    }
 }
 
-inline Ace::TimeStamp TimeStamp(int64_t currentTimeMillis)
+void InjectBatch::Wait()
 {
-    return Ace::TimeStamp(std::chrono::milliseconds(currentTimeMillis));
+    if (armed_ && g_injectBatchUsed) {
+        WaitInjectConsumed(beforeHash_, timeoutMs_);
+    }
 }
 
-Ace::Platform::UIContent* GetUIContent()
+// every injection goes through the rate limiter and counts against the open InjectBatch
+template<typename Inject>
+static bool LimitedInject(uint32_t eventCount, Inject&& inject)
 {
-    auto delegator = AppExecFwk::AbilityDelegatorRegistry::GetAbilityDelegator();
-    if (delegator == nullptr) {
-        HILOG_ERROR("Driver GetUIContent failed. delegator is not initialized");
-        return nullptr;
-    }
-    auto topAbility = delegator->GetCurrentTopAbility();
-    CHECK_NULL_RETURN(topAbility, nullptr);
-    return delegator->GetUIContent(topAbility->instanceId_);
+    InjectLimiter::GetInstance().Acquire(eventCount);
+    InjectBatch batch;
+    g_injectBatchUsed = true;
+    return inject();
+}
+
+bool InjectTouchEvents(Ace::Platform::UIContent* uiContent, const vector<Ace::TouchEvent>& events)
+{
+    CHECK_NULL_RETURN(uiContent, false);
+    return LimitedInject(events.size(), [uiContent, &events]() {
+        GestureRecorder::GetInstance().RecordTouch(events);
+        return uiContent->ProcessBasicEvent(events);
+    });
+}
+
+bool InjectKeyEvent(Ace::Platform::UIContent* uiContent, int32_t keyCode, int32_t keyAction, int32_t repeatTime,
+    int32_t metaKey, const string& msg)
+{
+    CHECK_NULL_RETURN(uiContent, false);
+    return LimitedInject(1, [&]() {
+        GestureRecorder::GetInstance().RecordKey(keyCode, keyAction, repeatTime, metaKey, msg);
+        // ProcessKeyEvent 接口参数: int32_t keyCode, int32_t keyAction, int32_t repeatTime, int64_t timeStamp = 0,
+        // int64_t timeStampStart = 0, int32_t metaKey = 0, int32_t sourceDevice = 0, int32_t deviceId = 0
+        return uiContent->ProcessKeyEvent(keyCode, keyAction, repeatTime, 0, 0, metaKey, 0, 0, msg);
+    });
 }
 
-static void PackagingEvent(Ace::TouchEvent& event, Ace::TimeStamp time, Ace::TouchType type, const Point& point, int id = 0)
+bool InjectBackPressed(Ace::Platform::UIContent* uiContent)
 {
-    event.id = id;
-    event.time = time;
-    event.type = type;
-    event.x = point.x;
-    event.y = point.y;
-    event.screenX = point.x;
-    event.screenY = point.y;
-    event = event.UpdatePointers();
+    CHECK_NULL_RETURN(uiContent, false);
+    return LimitedInject(1, [uiContent]() {
+        GestureRecorder::GetInstance().RecordBack();
+        return uiContent->ProcessBackPressed();
+    });
 }
 
+
 Rect GetBounds(const OHOS::Ace::Platform::ComponentInfo& component)
 {
     Rect rect;
@@ -147,7 +225,7 @@ void Driver::PressBack()
     HILOG_DEBUG("Driver::PressBack called");
     auto uicontent = GetUIContent();
     CHECK_NULL_VOID(uicontent);
-    uicontent->ProcessBackPressed();
+    InjectBackPressed(uicontent);
 }
 
 void Driver::TriggerKey(int keyCode)
@@ -159,93 +237,71 @@ void Driver::TriggerKey(int keyCode)
     }
     HILOG_DEBUG("Driver::TriggerKey: %{public}d", keyCode);
     UiOpArgs options;
-    uiContent->ProcessKeyEvent(static_cast<int32_t>(keyCode), static_cast<int32_t>(Ace::KeyAction::DOWN),
+    InjectBatch batch;
+    InjectKeyEvent(uiContent, static_cast<int32_t>(keyCode), static_cast<int32_t>(Ace::KeyAction::DOWN),
         options.clickHoldMs_);
-    uiContent->ProcessKeyEvent(static_cast<int32_t>(keyCode), static_cast<int32_t>(Ace::KeyAction::UP), 0);
+    InjectKeyEvent(uiContent, static_cast<int32_t>(keyCode), static_cast<int32_t>(Ace::KeyAction::UP), 0);
 }
 
-bool IsCombineKey(int key)
+// send the compiled strokes in one pass, each one when the event clock reaches its offset
+static void DispatchKeyStrokes(Ace::Platform::UIContent* uiContent, const vector<KeyStroke>& strokes)
 {
-    bool flag = false;
-    switch (key)
-    {
-    case static_cast<int32_t>(Ace::KeyCode::KEY_CTRL_LEFT):
-        flag = true;
-        break;
-    case static_cast<int32_t>(Ace::KeyCode::KEY_CTRL_RIGHT):
-        flag = true;
-        break;
-    case static_cast<int32_t>(Ace::KeyCode::KEY_SHIFT_LEFT):
-        flag = true;
-        break;
-    case static_cast<int32_t>(Ace::KeyCode::KEY_SHIFT_RIGHT):
-        flag = true;
-        break;
-    case static_cast<int32_t>(Ace::KeyCode::KEY_ALT_LEFT):
-        flag = true;
-        break;
-    case static_cast<int32_t>(Ace::KeyCode::KEY_ALT_RIGHT):
-        flag = true;
-        break;
-    case static_cast<int32_t>(Ace::KeyCode::KEY_META_LEFT):
-        flag = true;
-        break;
-    case static_cast<int32_t>(Ace::KeyCode::KEY_META_RIGHT):
-        flag = true;
-        break;
-    default:
-        break;
-    }
-    return flag;
-}
-
-int GetMetaKeyValue(int key)
-{
-    int mataKey = -1;
-    if (key == static_cast<int32_t>(Ace::KeyCode::KEY_CTRL_LEFT) ||
-        key == static_cast<int32_t>(Ace::KeyCode::KEY_CTRL_RIGHT)) {
-        mataKey = KEY_CTRL;
-    } else if (key == static_cast<int32_t>(Ace::KeyCode::KEY_SHIFT_LEFT) ||
-        key == static_cast<int32_t>(Ace::KeyCode::KEY_SHIFT_RIGHT)) {
-        mataKey = KEY_SHIFT;
-    } else if (key == static_cast<int32_t>(Ace::KeyCode::KEY_ALT_LEFT) ||
-        key == static_cast<int32_t>(Ace::KeyCode::KEY_ALT_RIGHT)) {
-        mataKey = KEY_ALT;
-    } else if (key == static_cast<int32_t>(Ace::KeyCode::KEY_META_LEFT) ||
-        key == static_cast<int32_t>(Ace::KeyCode::KEY_META_RIGHT)) {
-        mataKey = KEY_META;
-    }
-    return mataKey;
+    auto& clock = EventClock::GetInstance();
+    int64_t startUs = clock.NowUs();
+    InjectBatch batch;
+    vector<int32_t> pressed;
+    for (const auto& stroke : strokes) {
+        clock.SleepUntilUs(startUs + stroke.offsetUs);
+        if (CancelToken::CurrentStopped()) {
+            break;
+        }
+        InjectKeyEvent(uiContent, stroke.keyCode, stroke.keyAction, 0, stroke.metaKey);
+        if (stroke.keyAction == static_cast<int32_t>(Ace::KeyAction::DOWN)) {
+            pressed.push_back(stroke.keyCode);
+        } else {
+            pressed.erase(remove(pressed.begin(), pressed.end(), stroke.keyCode), pressed.end());
+        }
+    }
+    // a cancelled chord must not leave keys held down
+    for (auto it = pressed.rbegin(); it != pressed.rend(); it++) {
+        InjectKeyEvent(uiContent, *it, static_cast<int32_t>(Ace::KeyAction::UP), 0);
+    }
 }
 
 void Driver::TriggerCombineKeys(int key0, int key1, int key2)
 {
-    auto uiContent = GetUIContent();
-    CHECK_NULL_VOID(uiContent);
     if (key0 == -1 || key1 == -1) {
         return;
     }
-    Driver driver;
     HILOG_DEBUG("Driver::TriggerCombineKeys: %{public}d %{public}d %{public}d", key0, key1, key2);
-    if (IsCombineKey(key0) && IsCombineKey(key1) && key2 != -1) {
-        int metaKey0 = GetMetaKeyValue(key0);
-        int metaKey1 = GetMetaKeyValue(key1);
-        uiContent->ProcessKeyEvent(key2, static_cast<int32_t>(Ace::KeyAction::DOWN), 0, 0, 0, metaKey0 | metaKey1);
-        uiContent->ProcessKeyEvent(key2, static_cast<int32_t>(Ace::KeyAction::UP), 0, 0, 0, metaKey0 | metaKey1);
-    } else if (IsCombineKey(key0)) {
-        int metaKey0 = GetMetaKeyValue(key0);
-        uiContent->ProcessKeyEvent(key1, static_cast<int32_t>(Ace::KeyAction::DOWN), 0, 0, 0, metaKey0);
-        uiContent->ProcessKeyEvent(key1, static_cast<int32_t>(Ace::KeyAction::UP), 0, 0, 0, metaKey0);
-    } else {
-        uiContent->ProcessKeyEvent(static_cast<int32_t>(key0), static_cast<int32_t>(Ace::KeyAction::DOWN), 0);
-        uiContent->ProcessKeyEvent(static_cast<int32_t>(key1), static_cast<int32_t>(Ace::KeyAction::DOWN), 0);
-        uiContent->ProcessKeyEvent(static_cast<int32_t>(key2), static_cast<int32_t>(Ace::KeyAction::DOWN), 0);
-        driver.DelayMs(DELAY_TIME);
-        uiContent->ProcessKeyEvent(static_cast<int32_t>(key0), static_cast<int32_t>(Ace::KeyAction::UP), 0);
-        uiContent->ProcessKeyEvent(static_cast<int32_t>(key1), static_cast<int32_t>(Ace::KeyAction::UP), 0);
-        uiContent->ProcessKeyEvent(static_cast<int32_t>(key2), static_cast<int32_t>(Ace::KeyAction::UP), 0);
+    vector<int32_t> keys = { key0, key1 };
+    if (key2 != -1) {
+        keys.push_back(key2);
     }
-    driver.DelayMs(DELAY_TIME);
+    vector<KeyStroke> strokes;
+    KeyScript::CompileChord(keys, strokes);
+    TriggerKeyStrokes(strokes);
+}
+
+bool Driver::TriggerKeys(const string& script)
+{
+    HILOG_DEBUG("Driver::TriggerKeys: %{public}s", script.c_str());
+    vector<KeyStroke> strokes;
+    string err;
+    if (!KeyScript::Compile(script, strokes, err)) {
+        HILOG_ERROR("Driver::TriggerKeys %{public}s", err.c_str());
+        return false;
+    }
+    TriggerKeyStrokes(strokes);
+    return true;
+}
+
+void Driver::TriggerKeyStrokes(const vector<KeyStroke>& strokes)
+{
+    auto uiContent = GetUIContent();
+    CHECK_NULL_VOID(uiContent);
+    DispatchKeyStrokes(uiContent, strokes);
+    WaitForSettle();
 }
 
 static bool CompareTouchEventTimeStamp(Ace::TouchEvent &event1, Ace::TouchEvent &event2)
@@ -263,6 +319,74 @@ static bool CompareTouchEventTimeStamp(Ace::TouchEvent &event1, Ace::TouchEvent
     }
 }
 
+static int64_t EventTimeUs(const Ace::TouchEvent& event)
+{
+    return chrono::duration_cast<chrono::microseconds>(event.time.time_since_epoch()).count();
+}
+
+// a cancelled gesture must not leave fingers on the screen, lift the ones still pressed
+// after the first dispatched events with CANCEL
+static void CancelPressedPointers(Ace::Platform::UIContent* uiContent, const vector<Ace::TouchEvent>& events,
+    size_t dispatched)
+{
+    vector<const Ace::TouchEvent*> pressed;
+    for (size_t index = 0; index < dispatched; index++) {
+        const auto& event = events[index];
+        auto it = find_if(pressed.begin(), pressed.end(), [&event](auto last) { return last->id == event.id; });
+        bool lifted = event.type == Ace::TouchType::UP || event.type == Ace::TouchType::CANCEL;
+        if (it == pressed.end() && !lifted) {
+            pressed.push_back(&event);
+        } else if (it != pressed.end() && lifted) {
+            pressed.erase(it);
+        } else if (it != pressed.end()) {
+            *it = &event;
+        }
+    }
+    if (pressed.empty()) {
+        return;
+    }
+    auto now = Ace::TimeStamp(chrono::microseconds(EventClock::GetInstance().NowUs()));
+    vector<Ace::TouchEvent> cancels;
+    cancels.reserve(pressed.size());
+    for (auto last : pressed) {
+        auto& event = cancels.emplace_back(*last);
+        event.type = Ace::TouchType::CANCEL;
+        event.time = now;
+        for (auto& pointer : event.pointers) {
+            pointer.isPressed = false;
+        }
+    }
+    HILOG_INFO("cancel %{public}zu pressed pointers of a stopped gesture", cancels.size());
+    InjectTouchEvents(uiContent, cancels);
+}
+
+// deliver the time ordered events in one pass, events sharing a timestamp are injected together
+// when the event clock reaches it, so the timing does not depend on the caller
+static bool DispatchTimedEvents(const vector<Ace::TouchEvent>& events)
+{
+    auto uiContent = GetUIContent();
+    CHECK_NULL_RETURN(uiContent, false);
+    auto& clock = EventClock::GetInstance();
+    // the whole gesture is one backpressure batch, its timestamp groups are not waited for one by one
+    InjectBatch batch;
+    vector<Ace::TouchEvent> group;
+    size_t index = 0;
+    while (index < events.size()) {
+        int64_t dueUs = EventTimeUs(events[index]);
+        group.clear();
+        while (index < events.size() && EventTimeUs(events[index]) == dueUs) {
+            group.push_back(events[index++]);
+        }
+        clock.SleepUntilUs(dueUs);
+        if (CancelToken::CurrentStopped()) {
+            CancelPressedPointers(uiContent, events, index - group.size());
+            return false;
+        }
+        InjectTouchEvents(uiContent, group);
+    }
+    return true;
+}
+
 bool Driver::InjectMultiPointerAction(PointerMatrix& pointers, uint32_t speed)
 {
     HILOG_DEBUG("Driver::InjectMultiPointerAction begin. ");
@@ -277,87 +401,65 @@ bool Driver::InjectMultiPointerAction(PointerMatrix& pointers, uint32_t speed)
         actionSpeed = options.defaultVelocityPps_;
     }
 
-    std::vector<Ace::TouchEvent> injectEvents;
-    std::vector<int64_t> multiPointerActionEndTimeMillis;
-    std::vector<int64_t> multiPointerActionHoldTimeMillis;
-    auto now = std::chrono::steady_clock::now();
-    int64_t timeMills = 120000;
-    int64_t curTimeMillis =
-                std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() - timeMills;
+    const uint16_t stepCount = options.swipeStepsCounts_;
+    if (stepCount <= 0) {
+        HILOG_ERROR("Driver::InjectMultiPointerAction ignored. steps is illegal");
+        return false;
+    }
+    // DOWN and UP per finger plus stepCount MOVEs per segment, reserved once
+    size_t eventCount = 0;
     for (auto&& it : pointers.fingerPointMap_) {
         if (it.second.size() == 0) {
             return false;
         }
-        Ace::TouchEvent downEvent;
-        PackagingEvent(downEvent, TimeStamp(curTimeMillis), Ace::TouchType::DOWN, it.second.begin()->second, it.first);
-        injectEvents.push_back(downEvent);
-        multiPointerActionHoldTimeMillis.push_back(0);
+        eventCount += INDEX_TWO + (it.second.size() - 1) * stepCount;
     }
     auto it2 = pointers.fingerPointMap_.begin();
     int size2 = it2->second.size();
     if (size2 <= 1) {
         return false;
     }
+    TouchEventBuilder builder(eventCount);
+    std::vector<int64_t> multiPointerActionEndTimeUs;
+    int64_t curTimeUs = EventClock::GetInstance().NowUs();
+    for (auto&& it : pointers.fingerPointMap_) {
+        builder.Add(Ace::TouchType::DOWN, curTimeUs, it.second.begin()->second, it.first);
+    }
     for (auto&& it : pointers.fingerPointMap_) {
         auto start = it.second.begin();
         auto end = it.second.end();
-        int64_t endTimeMillis = curTimeMillis;
+        int64_t endTimeUs = curTimeUs;
         Point pointTmp {-1, -1};
         for (auto iter = start; iter != end; iter++) {
             if (iter == start) {
                 pointTmp = iter->second; // first run value
             }
-            
-            int startX = pointTmp.x;
-            int endX = iter->second.x;
-            int startY = pointTmp.y;
-            int endY = iter->second.y;
-            const int distanceX = endX - startX;
-            const int distanceY = endY - startY;
+
+            const int distanceX = iter->second.x - pointTmp.x;
+            const int distanceY = iter->second.y - pointTmp.y;
             const int distance = sqrt(distanceX * distanceX + distanceY * distanceY);
-            const uint32_t timeCostMs = (uint32_t)((distance * 1000) / actionSpeed);
+            const int64_t timeCostUs = static_cast<int64_t>(distance) * US_PER_SECOND / actionSpeed;
             if (distance < 1) {
                 HILOG_DEBUG("Driver::InjectMultiPointerAction this step ignored. distance value is illegal");
                 continue;
             }
 
-            const uint16_t steps = options.swipeStepsCounts_;
-            if (steps <= 0) {
-                HILOG_ERROR("Driver::InjectMultiPointerAction ignored. steps is illegal");
-                return false;
-            }
-            const uint32_t timeUnitMs = timeCostMs / steps;
-            for (uint16_t step = 1; step <= steps; step++) {
-                const float pointX = startX + (distanceX * step) / steps;
-                const float pointY = startY + (distanceY * step) / steps;
-                const uint32_t timeOffsetMs = timeUnitMs * (step - 1);
-                Ace::TouchEvent moveEvent;
-                PackagingEvent(moveEvent, TimeStamp(endTimeMillis + timeOffsetMs), Ace::TouchType::MOVE, {pointX, pointY}, it.first);
-                injectEvents.push_back(moveEvent);
-                multiPointerActionHoldTimeMillis.push_back(timeUnitMs);
-            }
-            endTimeMillis += timeCostMs;
+            // step i of the segment is sent at (i - 1) time units after the segment start
+            const int64_t timeUnitUs = timeCostUs / stepCount;
+            builder.AddMoves({ pointTmp, iter->second }, endTimeUs - timeUnitUs, timeUnitUs * stepCount,
+                stepCount, stepCount, it.first);
+            endTimeUs += timeCostUs;
             pointTmp = iter->second; // next run value
         }
-        multiPointerActionEndTimeMillis.push_back(endTimeMillis);
+        multiPointerActionEndTimeUs.push_back(endTimeUs);
     }
     for (auto&& it : pointers.fingerPointMap_) {
-        Ace::TouchEvent upEvent;
-        PackagingEvent(upEvent, TimeStamp(multiPointerActionEndTimeMillis[it.first]), Ace::TouchType::UP, it.second.rbegin()->second, it.first);
-        injectEvents.push_back(upEvent);
+        builder.Add(Ace::TouchType::UP, multiPointerActionEndTimeUs[it.first], it.second.rbegin()->second, it.first);
     }
+    auto& injectEvents = builder.Events();
     std::sort(injectEvents.begin(), injectEvents.end(), CompareTouchEventTimeStamp);
-    for (int eventIndex = 0; eventIndex < injectEvents.size(); eventIndex++) {
-        auto multiPointerActionEvent = injectEvents[eventIndex];
-        auto uiContent = GetUIContent();
-        CHECK_NULL_RETURN(uiContent, false);
-        std::vector<Ace::TouchEvent> touchEvents;
-        touchEvents.push_back(multiPointerActionEvent);
-        uiContent->ProcessBasicEvent(touchEvents);
-        touchEvents.clear();
-        if (multiPointerActionHoldTimeMillis.size() - 1 > eventIndex) {
-            DelayMs(multiPointerActionHoldTimeMillis[eventIndex]);
-        }
+    if (!DispatchTimedEvents(injectEvents)) {
+        return false;
     }
     HILOG_DEBUG("Driver::InjectMultiPointerAction end. ");
     return true;
@@ -367,80 +469,241 @@ void Driver::DelayMs(int dur)
 {
     HILOG_DEBUG("Driver::DelayMs duration=%d", dur);
     if (dur > 0) {
-        this_thread::sleep_for(chrono::milliseconds(dur));
+        EventClock::GetInstance().SleepForUs(MsToUs(dur));
     }
 }
 
-void Driver::Click(int x, int y)
+static inline uint64_t HashBytes(uint64_t hash, const void* data, size_t len)
 {
-    HILOG_DEBUG("Driver::Click x=%d, y=%d", x, y);
-    std::vector<Ace::TouchEvent> clickEvents;
-    int64_t currentTimeMillis = getCurrentTimeMillis();
+    auto bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+}
 
-    Ace::TouchEvent downEvent;
-    PackagingEvent(downEvent, TimeStamp(currentTimeMillis), Ace::TouchType::DOWN, { x, y });
-    clickEvents.push_back(downEvent);
+static uint64_t HashComponentIdentity(const OHOS::Ace::Platform::ComponentInfo& info, uint64_t hash)
+{
+    hash = HashBytes(hash, info.compid.data(), info.compid.length());
+    hash = HashBytes(hash, info.type.data(), info.type.length());
+    hash = HashBytes(hash, info.text.data(), info.text.length());
+    const int32_t bounds[] = { static_cast<int32_t>(info.left), static_cast<int32_t>(info.top),
+        static_cast<int32_t>(info.width), static_cast<int32_t>(info.height) };
+    return HashBytes(hash, bounds, sizeof(bounds));
+}
 
-    Ace::TouchEvent upEvent;
-    UiOpArgs options;
-    PackagingEvent(upEvent, TimeStamp(currentTimeMillis + options.clickHoldMs_), Ace::TouchType::UP, { x, y });
-    clickEvents.push_back(upEvent);
+uint64_t HashComponentNode(const OHOS::Ace::Platform::ComponentInfo& info)
+{
+    return HashComponentIdentity(info, FNV_OFFSET_BASIS);
+}
+
+// hash of everything a test can observe from a node, children included
+static uint64_t HashComponentTree(const OHOS::Ace::Platform::ComponentInfo& info, uint64_t hash)
+{
+    hash = HashComponentIdentity(info, hash);
+    const uint8_t flags[] = { info.clickable, info.longClickable, info.scrollable, info.enabled, info.focused,
+        info.selected, info.checked, info.checkable };
+    hash = HashBytes(hash, flags, sizeof(flags));
+    const uint32_t childCount = info.children.size();
+    hash = HashBytes(hash, &childCount, sizeof(childCount));
+    for (auto& child : info.children) {
+        hash = HashComponentTree(child, hash);
+    }
+    return hash;
+}
 
+uint64_t Driver::CaptureSnapshot(OHOS::Ace::Platform::ComponentInfo& info)
+{
     auto uiContent = GetUIContent();
-    CHECK_NULL_VOID(uiContent);
+    CHECK_NULL_RETURN(uiContent, 0);
+    info = OHOS::Ace::Platform::ComponentInfo();
+    uiContent->GetAllComponents(0, info);
+    UiMetrics::GetInstance().Add(METRIC_SNAPSHOT_COUNT, 1);
+    return HashComponentTree(info, FNV_OFFSET_BASIS);
+}
 
-    uiContent->ProcessBasicEvent(clickEvents);
+bool Driver::WaitForIdle(uint32_t idleMs, uint32_t timeoutMs)
+{
+    HILOG_DEBUG("Driver::WaitForIdle idleMs=%{public}u timeoutMs=%{public}u", idleMs, timeoutMs);
+    auto start = chrono::steady_clock::now();
+    auto deadline = start + chrono::milliseconds(timeoutMs);
+    OHOS::Ace::Platform::ComponentInfo info;
+    uint64_t lastHash = CaptureSnapshot(info);
+    auto stableSince = chrono::steady_clock::now();
+    uint32_t interval = IDLE_POLL_MIN_MS;
+    bool idle = false;
+    while (true) {
+        auto now = chrono::steady_clock::now();
+        auto idleAt = stableSince + chrono::milliseconds(idleMs);
+        if (now >= idleAt) {
+            idle = true;
+            break;
+        }
+        if (now >= deadline) {
+            break;
+        }
+        // never sleep past the point where the tree would be considered idle, or past the deadline
+        auto wakeup = min(now + chrono::milliseconds(interval), min(idleAt, deadline));
+        if (!CancelToken::SleepUntil(wakeup)) {
+            break;
+        }
+        uint64_t hash = CaptureSnapshot(info);
+        if (hash != lastHash) {
+            lastHash = hash;
+            stableSince = chrono::steady_clock::now();
+            interval = IDLE_POLL_MIN_MS;
+        } else {
+            interval = min(interval * 2, IDLE_POLL_MAX_MS);
+        }
+    }
+    auto waited = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    auto& metrics = UiMetrics::GetInstance();
+    metrics.Add(METRIC_IDLE_WAIT_COUNT, 1);
+    metrics.Add(METRIC_IDLE_WAIT_MS, waited);
+    if (!idle) {
+        metrics.Add(METRIC_IDLE_TIMEOUT_COUNT, 1);
+    }
+    HILOG_DEBUG("Driver::WaitForIdle idle=%{public}d waited=%{public}lld", idle, static_cast<long long>(waited));
+    return idle;
 }
 
-void Driver::DoubleClick(int x, int y)
+void Driver::SetIdleSettle(bool enable)
 {
-    HILOG_DEBUG("Driver::Click x=%d, y=%d", x, y);
-    std::vector<Ace::TouchEvent> clickEvents;
-    int64_t currentTimeMillis = getCurrentTimeMillis();
+    HILOG_DEBUG("Driver::SetIdleSettle %{public}d", enable);
+    g_idleSettle = enable;
+}
+
+void Driver::WaitForSettle()
+{
+    if (!g_idleSettle) {
+        DelayMs(DELAY_TIME);
+        return;
+    }
+    auto start = chrono::steady_clock::now();
+    WaitForIdle(SETTLE_IDLE_MS, SETTLE_TIMEOUT_MS);
+    auto waited = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    // compared with the fixed delay used when idle settle is off
+    if (waited < DELAY_TIME) {
+        UiMetrics::GetInstance().Add(METRIC_SETTLE_SAVED_MS, DELAY_TIME - waited);
+    } else {
+        UiMetrics::GetInstance().Add(METRIC_SETTLE_EXTRA_MS, waited - DELAY_TIME);
+    }
+}
+
+bool Driver::StartRecording(const string& path)
+{
+    HILOG_DEBUG("Driver::StartRecording %{public}s", path.c_str());
+    OHOS::Ace::Platform::ComponentInfo root;
+    CaptureSnapshot(root);
+    return GestureRecorder::GetInstance().Start(path, static_cast<int32_t>(root.width),
+        static_cast<int32_t>(root.height));
+}
+
+bool Driver::StopRecording()
+{
+    HILOG_DEBUG("Driver::StopRecording");
+    return GestureRecorder::GetInstance().Stop();
+}
+
+bool Driver::Replay(const string& path, float speed)
+{
+    HILOG_DEBUG("Driver::Replay %{public}s speed:%{public}f", path.c_str(), speed);
+    OHOS::Ace::Platform::ComponentInfo root;
+    CaptureSnapshot(root);
+    ReplayOptions options;
+    options.speed = speed;
+    options.screenWidth = static_cast<int32_t>(root.width);
+    options.screenHeight = static_cast<int32_t>(root.height);
+    GestureReplayer replayer;
+    return replayer.Replay(path, options);
+}
 
-    for (int i = 0; i < DOUBLE_CLICK; i++) {
-        Ace::TouchEvent downEvent;
-        PackagingEvent(downEvent, TimeStamp(currentTimeMillis), Ace::TouchType::DOWN, { x, y });
-        clickEvents.push_back(downEvent);
+shared_ptr<OrderedExecutor> Driver::GetExecutor()
+{
+    // only called from the js thread, no lock needed
+    if (executor_ == nullptr) {
+        executor_ = make_shared<OrderedExecutor>();
+    }
+    return executor_;
+}
 
-        Ace::TouchEvent upEvent;
-        UiOpArgs options;
-        PackagingEvent(upEvent, TimeStamp(currentTimeMillis + options.clickHoldMs_), Ace::TouchType::UP, { x, y });
-        clickEvents.push_back(upEvent);
+// append taps DOWN..UP at point, each tap starts intervalMs after the previous one
+static void BuildTapEvents(TouchEventBuilder& builder, const Point& point, int64_t startUs,
+    uint32_t taps, uint32_t holdMs, uint32_t intervalMs)
+{
+    // keep a gap between UP and the next DOWN, otherwise the taps merge into one press
+    int64_t periodUs = max(MsToUs(intervalMs), MsToUs(holdMs) + MsToUs(MIN_TAP_GAP_MS));
+    for (uint32_t i = 0; i < taps; i++) {
+        int64_t downUs = startUs + periodUs * i;
+        builder.Add(Ace::TouchType::DOWN, downUs, point);
+        builder.Add(Ace::TouchType::UP, downUs + MsToUs(holdMs), point);
     }
+}
 
-    auto uiContent = GetUIContent();
-    CHECK_NULL_VOID(uiContent);
+void Driver::MultiClick(int x, int y, uint32_t taps, uint32_t holdMs, uint32_t intervalMs)
+{
+    HILOG_DEBUG("Driver::MultiClick x=%d, y=%d, taps=%u, hold=%u, interval=%u", x, y, taps, holdMs, intervalMs);
+    if (taps == 0 || taps > MAX_TAPS) {
+        HILOG_ERROR("Driver::MultiClick ignored, taps must be in [1, %{public}u]", MAX_TAPS);
+        return;
+    }
+    TouchEventBuilder builder(taps * INDEX_TWO);
+    BuildTapEvents(builder, { x, y }, EventClock::GetInstance().NowUs(), taps, holdMs, intervalMs);
+    DispatchTimedEvents(builder.Events());
+}
+
+void Driver::Click(int x, int y)
+{
+    HILOG_DEBUG("Driver::Click x=%d, y=%d", x, y);
+    UiOpArgs options;
+    MultiClick(x, y, 1, options.clickHoldMs_, 0);
+}
 
-    uiContent->ProcessBasicEvent(clickEvents);
+void Driver::DoubleClick(int x, int y)
+{
+    HILOG_DEBUG("Driver::DoubleClick x=%d, y=%d", x, y);
+    UiOpArgs options;
+    MultiClick(x, y, DOUBLE_CLICK, options.clickHoldMs_, options.doubleClickIntervalMs_);
 }
 
 void Driver::LongClick(int x, int y)
 {
-    HILOG_DEBUG("Driver::LongClick x=%d, y=%d", x, y);
-    std::vector<Ace::TouchEvent> clickEvents;
-    int64_t currentTimeMillis = getCurrentTimeMillis();
+    UiOpArgs options;
+    LongClick(x, y, options.longClickHoldMs_);
+}
 
-    Ace::TouchEvent downEvent;
-    PackagingEvent(downEvent, TimeStamp(currentTimeMillis), Ace::TouchType::DOWN, { x, y });
-    clickEvents.push_back(downEvent);
+void Driver::LongClick(int x, int y, uint32_t holdMs)
+{
+    HILOG_DEBUG("Driver::LongClick x=%d, y=%d, hold=%u", x, y, holdMs);
+    // a long press is a single tap held for holdMs, released with a proper UP
+    MultiClick(x, y, 1, holdMs, 0);
+}
+
+// a press moving from..to with steps - 1 MOVEs in between, relative to time 0, shared by the cache
+static TouchStream BuildLineStroke(const PointPair& line, int64_t timeCostUs, uint32_t steps)
+{
+    TouchEventBuilder builder(steps + 1);
+    builder.Add(Ace::TouchType::DOWN, 0, line.from);
+    builder.AddMoves(line, 0, timeCostUs, steps, steps - 1);
+    builder.Add(Ace::TouchType::UP, timeCostUs, line.to);
+    return make_shared<const vector<Ace::TouchEvent>>(builder.Take());
+}
 
+// inject a cached stroke starting now, the per thread buffer keeps its capacity (and the capacity of the
+// pointer vectors) across calls, so repeating the same stroke allocates nothing
+static void InjectStroke(const TouchStream& stream)
+{
     auto uiContent = GetUIContent();
     CHECK_NULL_VOID(uiContent);
-
-    uiContent->ProcessBasicEvent(clickEvents);
+    thread_local vector<Ace::TouchEvent> strokeEvents;
+    strokeEvents = *stream;
+    TouchEventBuilder::Retime(strokeEvents, EventClock::GetInstance().NowUs());
+    InjectTouchEvents(uiContent, strokeEvents);
 }
 
 void Driver::Swipe(int startx, int starty, int endx, int endy, uint32_t speed)
 {
     HILOG_DEBUG("Driver::Swipe from (%d, %d) to (%d, %d), speed:%d", startx, starty, endx, endy, speed);
-    std::vector<Ace::TouchEvent> swipeEvents;
-    int64_t currentTimeMillis = getCurrentTimeMillis();
-
-    Ace::TouchEvent downEvent;
-    PackagingEvent(downEvent, TimeStamp(currentTimeMillis), Ace::TouchType::DOWN, { startx, starty });
-    swipeEvents.push_back(downEvent);
-
     UiOpArgs options;
     uint32_t swipeSpeed = speed;
     if (speed < options.minSwipeVelocityPps_ || speed > options.maxSwipeVelocityPps_) {
@@ -450,47 +713,27 @@ void Driver::Swipe(int startx, int starty, int endx, int endy, uint32_t speed)
     const int distanceX = endx - startx;
     const int distanceY = endy - starty;
     const int distance = sqrt(distanceX * distanceX + distanceY * distanceY);
-    const uint32_t timeCostMs = (uint32_t)((distance * 1000) / swipeSpeed);
-
     if (distance < 1) {
         HILOG_ERROR("Driver::Swipe ignored. distance value is illegal");
         return;
     }
 
     const uint16_t steps = options.swipeStepsCounts_;
-
-    for (uint16_t step = 1; step < steps; step++) {
-        const float pointX = startx + (distanceX * step) / steps;
-        const float pointY = starty + (distanceY * step) / steps;
-        const uint32_t timeOffsetMs = (timeCostMs * step) / steps;
-
-        Ace::TouchEvent moveEvent;
-        moveEvent = moveEvent.UpdatePointers();
-        PackagingEvent(moveEvent, TimeStamp(currentTimeMillis + timeOffsetMs),
-            Ace::TouchType::MOVE, { pointX, pointY });
-        swipeEvents.push_back(moveEvent);
+    StrokeKey key = { STROKE_SWIPE, { { startx, starty }, { endx, endy } }, steps, swipeSpeed };
+    auto& cache = TouchStreamCache::GetInstance();
+    auto stream = cache.Find(key);
+    if (stream == nullptr) {
+        const int64_t timeCostUs = static_cast<int64_t>(distance) * US_PER_SECOND / swipeSpeed;
+        stream = BuildLineStroke(key.line, timeCostUs, steps);
+        cache.Store(key, stream);
     }
-
-    Ace::TouchEvent upEvent;
-    PackagingEvent(upEvent, TimeStamp(currentTimeMillis + timeCostMs), Ace::TouchType::UP, { endx, endy });
-    swipeEvents.push_back(upEvent);
-
-    auto uiContent = GetUIContent();
-    CHECK_NULL_VOID(uiContent);
-    uiContent->ProcessBasicEvent(swipeEvents);
+    InjectStroke(stream);
 }
 
 void Driver::Fling(const Point& from, const Point& to, int stepLen, uint32_t speed)
 {
     HILOG_DEBUG(
         "Driver::Fling from (%d, %d) to (%d, %d), stepLen:%d, speed:%d", from.x, from.y, to.x, to.y, stepLen, speed);
-    std::vector<Ace::TouchEvent> flingEvents;
-    int64_t currentTimeMillis = getCurrentTimeMillis();
-
-    Ace::TouchEvent downEvent;
-    PackagingEvent(downEvent, TimeStamp(currentTimeMillis), Ace::TouchType::DOWN, from);
-    flingEvents.push_back(downEvent);
-
     UiOpArgs options;
     uint32_t flingSpeed = speed;
 
@@ -501,30 +744,21 @@ void Driver::Fling(const Point& from, const Point& to, int stepLen, uint32_t spe
     const int distanceX = to.x - from.x;
     const int distanceY = to.y - from.y;
     const int distance = sqrt(distanceX * distanceX + distanceY * distanceY);
-    const uint32_t timeCostMs = (uint32_t)((distance * 1000) / flingSpeed);
     if (distance < stepLen || stepLen <= 0) {
         HILOG_ERROR("Driver::Fling ignored. stepLen is illegal");
         return;
     }
     const uint16_t steps = distance / stepLen;
 
-    for (uint16_t step = 1; step < steps; step++) {
-        const float pointX = from.x + (distanceX * step) / steps;
-        const float pointY = from.y + (distanceY * step) / steps;
-        const uint32_t timeOffsetMs = (timeCostMs * step) / steps;
-        Ace::TouchEvent moveEvent;
-        PackagingEvent(moveEvent, TimeStamp(currentTimeMillis + timeOffsetMs),
-            Ace::TouchType::MOVE, { pointX, pointY });
-        flingEvents.push_back(moveEvent);
+    StrokeKey key = { STROKE_FLING, { from, to }, steps, flingSpeed };
+    auto& cache = TouchStreamCache::GetInstance();
+    auto stream = cache.Find(key);
+    if (stream == nullptr) {
+        const int64_t timeCostUs = static_cast<int64_t>(distance) * US_PER_SECOND / flingSpeed;
+        stream = BuildLineStroke(key.line, timeCostUs, steps);
+        cache.Store(key, stream);
     }
-
-    Ace::TouchEvent upEvent;
-    PackagingEvent(upEvent, TimeStamp(currentTimeMillis + timeCostMs), Ace::TouchType::UP, to);
-    flingEvents.push_back(upEvent);
-
-    auto uiContent = GetUIContent();
-    CHECK_NULL_VOID(uiContent);
-    uiContent->ProcessBasicEvent(flingEvents);
+    InjectStroke(stream);
 }
 
 /* 默认左上角原点
@@ -591,26 +825,212 @@ void Driver::Fling(UiDirection direction, uint32_t speed)
         HILOG_ERROR("Driver::Fling direction ignored. distance is illegal");
         return;
     }
-    const uint32_t timeCostMs = (uint32_t)((distance * 1000) / flingSpeed);
+    const int64_t timeCostUs = static_cast<int64_t>(distance) * US_PER_SECOND / flingSpeed;
+
+    int64_t currentTimeUs = EventClock::GetInstance().NowUs();
+    TouchEventBuilder builder(INDEX_THREE);
+    builder.Add(Ace::TouchType::DOWN, currentTimeUs, from);
+    builder.Add(Ace::TouchType::MOVE, currentTimeUs + timeCostUs, { from.x + distanceX, from.y + distanceY });
+    builder.Add(Ace::TouchType::UP, currentTimeUs + timeCostUs, to);
+
+    InjectTouchEvents(uiContent, builder.Events());
+}
+
+// position of one finger at progress t in [0, 1]
+using FingerTrack = function<void(float t, float& x, float& y)>;
+
+// sample all tracks on the same steps into one time ordered buffer, then inject it in one timed dispatch
+static bool DispatchFingerTracks(const vector<FingerTrack>& tracks, float pathLength, uint32_t speed)
+{
+    if (tracks.empty() || tracks.size() > MAX_GESTURE_FINGERS) {
+        HILOG_ERROR("DispatchFingerTracks invalid finger count %{public}zu", tracks.size());
+        return false;
+    }
+    UiOpArgs options;
+    if (speed < options.minSwipeVelocityPps_ || speed > options.maxSwipeVelocityPps_) {
+        speed = options.defaultVelocityPps_;
+    }
+    const uint32_t steps = options.swipeStepsCounts_;
+    const int64_t durationUs = max(static_cast<int64_t>(pathLength * US_PER_SECOND / speed),
+        MsToUs(MIN_GESTURE_MS));
+    const int64_t startUs = EventClock::GetInstance().NowUs();
+    TouchEventBuilder builder(tracks.size() * (steps + INDEX_TWO));
+    auto append = [&tracks, &builder](int32_t finger, Ace::TouchType type, int64_t timeUs, float t) {
+        float x = 0.0f;
+        float y = 0.0f;
+        tracks[finger](t, x, y);
+        builder.Add(type, timeUs, { static_cast<int>(lround(x)), static_cast<int>(lround(y)) }, finger);
+    };
+    for (size_t finger = 0; finger < tracks.size(); finger++) {
+        append(finger, Ace::TouchType::DOWN, startUs, 0.0f);
+    }
+    for (uint32_t step = 1; step <= steps; step++) {
+        float t = static_cast<float>(step) / steps;
+        int64_t timeUs = startUs + durationUs * step / steps;
+        for (size_t finger = 0; finger < tracks.size(); finger++) {
+            append(finger, Ace::TouchType::MOVE, timeUs, t);
+        }
+    }
+    for (size_t finger = 0; finger < tracks.size(); finger++) {
+        append(finger, Ace::TouchType::UP, startUs + durationUs, 1.0f);
+    }
+    return DispatchTimedEvents(builder.Events());
+}
 
-    std::vector<Ace::TouchEvent> flingEvents;
-    int64_t currentTimeMillis = getCurrentTimeMillis();
-    Ace::TouchEvent downEvent;
-    PackagingEvent(downEvent, TimeStamp(currentTimeMillis), Ace::TouchType::DOWN, from);
-    flingEvents.push_back(downEvent);
+// track moving from + offset to to + offset along a straight line
+static FingerTrack LineTrack(const Point& from, const Point& to, float offsetX, float offsetY)
+{
+    return [from, to, offsetX, offsetY](float t, float& x, float& y) {
+        x = from.x + (to.x - from.x) * t + offsetX;
+        y = from.y + (to.y - from.y) * t + offsetY;
+    };
+}
+
+void Driver::MultiSwipe(uint32_t fingers, UiDirection direction, uint32_t speed)
+{
+    HILOG_DEBUG("Driver::MultiSwipe fingers:%{public}u direction:%{public}d", fingers, direction);
+    if (fingers == 0 || fingers > MAX_GESTURE_FINGERS) {
+        HILOG_ERROR("Driver::MultiSwipe invalid finger count");
+        return;
+    }
+    OHOS::Ace::Platform::ComponentInfo info;
+    CaptureSnapshot(info);
+    Point from, to;
+    CalculateDirection(info, direction, from, to);
+    // fingers side by side, perpendicular to the swipe and centered on its line
+    bool horizontal = (direction == UiDirection::LEFT || direction == UiDirection::RIGHT);
+    vector<FingerTrack> tracks;
+    for (uint32_t finger = 0; finger < fingers; finger++) {
+        float offset = (finger - (fingers - 1) / 2.0f) * FINGER_SPACING;
+        tracks.push_back(LineTrack(from, to, horizontal ? 0.0f : offset, horizontal ? offset : 0.0f));
+    }
+    float length = hypot(static_cast<float>(to.x - from.x), static_cast<float>(to.y - from.y));
+    DispatchFingerTracks(tracks, length, speed);
+    WaitForSettle();
+}
 
-    const float pointX = from.x + distanceX;
-    const float pointY = from.y + distanceY;
-    Ace::TouchEvent moveEvent;
-    PackagingEvent(moveEvent, TimeStamp(currentTimeMillis + timeCostMs),
-        Ace::TouchType::MOVE, { pointX, pointY });
-    flingEvents.push_back(moveEvent);
+void Driver::TwoFingerPan(const Point& from, const Point& to, uint32_t speed)
+{
+    HILOG_DEBUG("Driver::TwoFingerPan from (%d, %d) to (%d, %d)", from.x, from.y, to.x, to.y);
+    float length = hypot(static_cast<float>(to.x - from.x), static_cast<float>(to.y - from.y));
+    if (length < 1.0f) {
+        HILOG_ERROR("Driver::TwoFingerPan ignored. distance value is illegal");
+        return;
+    }
+    // the two fingers sit across the pan direction, half the spacing on each side of the line
+    float normalX = -(to.y - from.y) / length * FINGER_SPACING / INDEX_TWO;
+    float normalY = (to.x - from.x) / length * FINGER_SPACING / INDEX_TWO;
+    vector<FingerTrack> tracks = { LineTrack(from, to, normalX, normalY), LineTrack(from, to, -normalX, -normalY) };
+    DispatchFingerTracks(tracks, length, speed);
+    WaitForSettle();
+}
 
-    Ace::TouchEvent upEvent;
-    PackagingEvent(upEvent, TimeStamp(currentTimeMillis + timeCostMs), Ace::TouchType::UP, to);
-    flingEvents.push_back(upEvent);
+// append a pressed stroke: DOWN at from, held still holdUs, moved to to in moveUs, then resting restUs before UP,
+// the rest drops the release velocity to zero so the target does not fling. return the time of the UP
+static int64_t AppendStroke(TouchEventBuilder& builder, const PointPair& stroke, int64_t startUs,
+    int64_t holdUs, int64_t moveUs, int64_t restUs)
+{
+    UiOpArgs options;
+    const uint32_t steps = options.swipeStepsCounts_;
+    const int64_t moveStartUs = startUs + holdUs;
+    const int64_t upUs = moveStartUs + moveUs + restUs;
+    builder.Add(Ace::TouchType::DOWN, startUs, stroke.from);
+    builder.AddMoves(stroke, moveStartUs, moveUs, steps, steps);
+    builder.Add(Ace::TouchType::MOVE, upUs, stroke.to);
+    builder.Add(Ace::TouchType::UP, upUs, stroke.to);
+    return upUs;
+}
 
-    uiContent->ProcessBasicEvent(flingEvents);
+// events of one AppendStroke
+static size_t StrokeEventCount()
+{
+    UiOpArgs options;
+    return options.swipeStepsCounts_ + INDEX_THREE;
+}
+
+static uint32_t ClampSwipeSpeed(uint32_t speed)
+{
+    UiOpArgs options;
+    if (speed < options.minSwipeVelocityPps_ || speed > options.maxSwipeVelocityPps_) {
+        return options.defaultVelocityPps_;
+    }
+    return speed;
+}
+
+void Driver::MouseMove(int x, int y)
+{
+    HILOG_DEBUG("Driver::MouseMove x=%d, y=%d", x, y);
+    // no button pressed, a single MOVE positions the cursor and drives hover
+    TouchEventBuilder builder(1);
+    builder.SetSource(Ace::SourceType::MOUSE, Ace::SourceTool::MOUSE);
+    builder.Add(Ace::TouchType::MOVE, EventClock::GetInstance().NowUs(), { x, y });
+    DispatchTimedEvents(builder.Events());
+}
+
+void Driver::MouseClick(int x, int y)
+{
+    HILOG_DEBUG("Driver::MouseClick x=%d, y=%d", x, y);
+    UiOpArgs options;
+    TouchEventBuilder builder(INDEX_TWO);
+    builder.SetSource(Ace::SourceType::MOUSE, Ace::SourceTool::MOUSE);
+    BuildTapEvents(builder, { x, y }, EventClock::GetInstance().NowUs(), 1, options.clickHoldMs_, 0);
+    DispatchTimedEvents(builder.Events());
+    WaitForSettle();
+}
+
+void Driver::MouseScroll(int x, int y, int32_t wheelTicks, uint32_t speed)
+{
+    HILOG_DEBUG("Driver::MouseScroll x=%d, y=%d, ticks=%d", x, y, wheelTicks);
+    if (wheelTicks == 0) {
+        return;
+    }
+    // bounded before abs, abs(INT_MIN) is undefined
+    wheelTicks = clamp(wheelTicks, -MAX_WHEEL_TICKS, MAX_WHEEL_TICKS);
+    // UIContent has no axis event entry here, every wheel tick scrolls a fixed distance by a mouse stroke
+    // centered on (x, y), positive ticks scroll the content down like a wheel turned towards the user
+    const int32_t direction = wheelTicks > 0 ? -1 : 1;
+    const uint32_t totalTicks = static_cast<uint32_t>(abs(wheelTicks));
+    const uint32_t fullStrokes = totalTicks / WHEEL_TICKS_PER_STROKE;
+    const uint32_t restTicks = totalTicks % WHEEL_TICKS_PER_STROKE;
+    const int64_t usPerPixel = US_PER_SECOND / ClampSwipeSpeed(speed);
+    const size_t strokeEvents = StrokeEventCount();
+    TouchEventBuilder builder(strokeEvents * (fullStrokes + (restTicks > 0 ? 1 : 0)));
+    builder.SetSource(Ace::SourceType::MOUSE, Ace::SourceTool::MOUSE);
+    auto appendTicks = [&](uint32_t ticks, int64_t startUs) {
+        int32_t half = static_cast<int32_t>(ticks) * WHEEL_TICK_DISTANCE / INDEX_TWO;
+        PointPair stroke = { { x, y - direction * half }, { x, y + direction * half } };
+        return AppendStroke(builder, stroke, startUs, 0, usPerPixel * half * INDEX_TWO,
+            MsToUs(STROKE_REST_MS)) + MsToUs(MIN_TAP_GAP_MS);
+    };
+    int64_t startUs = EventClock::GetInstance().NowUs();
+    int64_t timeUs = startUs;
+    if (fullStrokes > 0) {
+        // every full stroke is the same, generate it once and repeat it shifted in time
+        int64_t periodUs = appendTicks(WHEEL_TICKS_PER_STROKE, startUs) - startUs;
+        for (uint32_t stroke = 1; stroke < fullStrokes; stroke++) {
+            builder.Repeat(0, strokeEvents, periodUs * stroke);
+        }
+        timeUs = startUs + periodUs * fullStrokes;
+    }
+    if (restTicks > 0) {
+        appendTicks(restTicks, timeUs);
+    }
+    DispatchTimedEvents(builder.Events());
+    WaitForSettle();
+}
+
+void Driver::Drag(const Point& from, const Point& to, uint32_t holdMs, uint32_t speed)
+{
+    HILOG_DEBUG("Driver::Drag from (%d, %d) to (%d, %d), hold:%u, speed:%u", from.x, from.y, to.x, to.y,
+        holdMs, speed);
+    float length = hypot(static_cast<float>(to.x - from.x), static_cast<float>(to.y - from.y));
+    // the press is held still for holdMs to pick the item up, then moved, then rests over the target to drop
+    int64_t moveUs = static_cast<int64_t>(length * US_PER_SECOND / ClampSwipeSpeed(speed));
+    TouchEventBuilder builder(StrokeEventCount());
+    AppendStroke(builder, { from, to }, EventClock::GetInstance().NowUs(), MsToUs(holdMs), moveUs,
+        MsToUs(STROKE_REST_MS));
+    DispatchTimedEvents(builder.Events());
+    WaitForSettle();
 }
 
 void Component::Click()
@@ -719,9 +1139,55 @@ unique_ptr<bool> Component::IsCheckable()
     return checkable;
 }
 
-void Component::InputText(const string& text)
+static void SendKeyPress(Ace::Platform::UIContent* uiContent, Ace::KeyCode keyCode, int32_t metaKey = 0)
+{
+    InjectBatch batch;
+    InjectKeyEvent(uiContent, static_cast<int32_t>(keyCode), static_cast<int32_t>(Ace::KeyAction::DOWN), 0, metaKey);
+    InjectKeyEvent(uiContent, static_cast<int32_t>(keyCode), static_cast<int32_t>(Ace::KeyAction::UP), 0, metaKey);
+}
+
+static void CommitTextByPaste(Ace::Platform::UIContent* uiContent, const string& text)
+{
+    // int32_t metaKey 参数取值: CTRL = 1,    SHIFT = 2,    ALT = 4,    META = 8,
+    InjectBatch batch;
+    InjectKeyEvent(uiContent, static_cast<int32_t>(Ace::KeyCode::KEY_V), static_cast<int32_t>(Ace::KeyAction::DOWN),
+        0, KEY_CTRL, text);
+    InjectKeyEvent(uiContent, static_cast<int32_t>(Ace::KeyCode::KEY_V), static_cast<int32_t>(Ace::KeyAction::UP),
+        0, KEY_CTRL, text);
+}
+
+static void CommitTextByKeys(Ace::Platform::UIContent* uiContent, const string& text)
+{
+    // key events are queued to the ui thread in order, so only pace between bursts instead of every character,
+    // in backpressure mode each burst is a batch the ui is waited for
+    Driver driver;
+    InjectBatch batch;
+    uint32_t keys = 0;
+    size_t i = 0;
+    while (i < text.length() && !CancelToken::CurrentStopped()) {
+        int32_t metaKey = 0;
+        int32_t keycode = 0;
+        if (!KeyScript::LookupChar(text[i], keycode, metaKey)) {
+            // characters without a key, e.g. non ascii, are committed by paste as one run
+            size_t end = i + 1;
+            while (end < text.length() && !KeyScript::LookupChar(text[end], keycode, metaKey)) {
+                end++;
+            }
+            CommitTextByPaste(uiContent, text.substr(i, end - i));
+            i = end;
+            continue;
+        }
+        SendKeyPress(uiContent, static_cast<Ace::KeyCode>(keycode), metaKey);
+        i++;
+        if (++keys % KEY_BURST_SIZE == 0 && i < text.length() && !batch.Flush()) {
+            driver.DelayMs(KEY_BURST_INTERVAL);
+        }
+    }
+}
+
+void Component::InputText(const string& text, bool paste)
 {
-    HILOG_DEBUG("Component::InputText %{public}s", text.c_str());
+    HILOG_DEBUG("Component::InputText %{public}s paste:%{public}d", text.c_str(), paste);
     ClearText();
     if (text.empty()) {
         return;
@@ -729,24 +1195,18 @@ void Component::InputText(const string& text)
     auto uiContent = GetUIContent();
     CHECK_NULL_VOID(uiContent);
     Driver driver;
-    if (TextToKeyCodeCheck(text)) {
-        for (uint32_t i = 0; i < text.length(); i++) {
-            int32_t metaKey, keycode;
-            Findkeycode(text[i], metaKey, keycode);
-            uiContent->ProcessKeyEvent(keycode, static_cast<int32_t>(Ace::KeyAction::DOWN), 0, 0, 0, metaKey);
-            uiContent->ProcessKeyEvent(keycode, static_cast<int32_t>(Ace::KeyAction::UP), 0, 0, 0, metaKey);
-            driver.DelayMs(DELAY_TIME);
-        }
+    if (!paste) {
+        CommitTextByKeys(uiContent, text);
     } else {
-        // ProcessKeyEvent 接口参数: int32_t keyCode, int32_t keyAction, int32_t repeatTime, int64_t timeStamp = 0,
-        // int64_t timeStampStart = 0, int32_t metaKey = 0, int32_t sourceDevice = 0, int32_t deviceId = 0
-        // int32_t metaKey 参数取值: CTRL = 1,    SHIFT = 2,    ALT = 4,    META = 8,
-        uiContent->ProcessKeyEvent(static_cast<int32_t>(Ace::KeyCode::KEY_V), static_cast<int32_t>(Ace::KeyAction::DOWN), 0, 0, 0, KEY_CTRL, 0, 0, text);
-        uiContent->ProcessKeyEvent(static_cast<int32_t>(Ace::KeyCode::KEY_V), static_cast<int32_t>(Ace::KeyAction::UP), 0, 0, 0, KEY_CTRL, 0, 0, text);
-        driver.DelayMs(DELAY_TIME);
+        // the whole text is committed at once, the cost does not depend on the text length
+        CommitTextByPaste(uiContent, text);
     }
+    driver.WaitForSettle();
     // Ace::KeyCode::KEY_ENTER 2054 回车键
-    componentInfo_.text = text;
+    {
+        lock_guard<mutex> guard(infoLock_);
+        componentInfo_.text = text;
+    }
     driver.TriggerKey(static_cast<int32_t>(Ace::KeyCode::KEY_ENTER));
 }
 
@@ -756,14 +1216,29 @@ void Component::ClearText()
     auto uiContent = GetUIContent();
     CHECK_NULL_VOID(uiContent);
 
-    uiContent->ProcessKeyEvent(static_cast<int32_t>(Ace::KeyCode::KEY_MOVE_END), static_cast<int32_t>(Ace::KeyAction::DOWN), 0);
-    uiContent->ProcessKeyEvent(static_cast<int32_t>(Ace::KeyCode::KEY_MOVE_END), static_cast<int32_t>(Ace::KeyAction::UP), 0);
+    // select all (Ctrl+A) and delete the selection at once
     Driver driver;
-    for (uint32_t i = 0; i < componentInfo_.text.length(); i++) {
-        uiContent->ProcessKeyEvent(static_cast<int32_t>(Ace::KeyCode::KEY_DEL), static_cast<int32_t>(Ace::KeyAction::DOWN), 0);
-        uiContent->ProcessKeyEvent(static_cast<int32_t>(Ace::KeyCode::KEY_DEL), static_cast<int32_t>(Ace::KeyAction::UP), 0);
-        driver.DelayMs(DELAY_TIME);
+    {
+        InjectBatch batch;
+        SendKeyPress(uiContent, Ace::KeyCode::KEY_A, KEY_CTRL);
+        SendKeyPress(uiContent, Ace::KeyCode::KEY_DEL);
+    }
+    driver.WaitForSettle();
+
+    if (Refresh() && !componentInfo_.text.empty()) {
+        // the field does not support select all, delete the live text with a bounded number of keys
+        size_t count = std::min(componentInfo_.text.length(), MAX_CLEAR_KEYS);
+        HILOG_DEBUG("Component::ClearText select all failed, delete %{public}zu keys", count);
+        {
+            InjectBatch batch;
+            SendKeyPress(uiContent, Ace::KeyCode::KEY_MOVE_END);
+            for (size_t i = 0; i < count; i++) {
+                SendKeyPress(uiContent, Ace::KeyCode::KEY_DEL);
+            }
+        }
+        driver.WaitForSettle();
     }
+    lock_guard<mutex> guard(infoLock_);
     componentInfo_.text.clear();
 }
 
@@ -806,7 +1281,7 @@ void Component::ScrollToTop(int speed)
     auto swipeTimes = std::abs((top - firstChildTop + firstHeight) / (endy - starty)) + 1;
     int step = 0;
     Driver driver;
-    while (step < swipeTimes) {
+    while (step < swipeTimes && !CancelToken::CurrentStopped()) {
         driver.Swipe(startx, starty, endx, endy, speed);
         step++;
     }
@@ -851,7 +1326,7 @@ void Component::ScrollToBottom(int speed)
     auto swipeTimes = std::abs((lastBottom - bottom + lastHeight) / (endy - starty)) + 1;
     int step = 0;
     Driver driver;
-    while (step < swipeTimes) {
+    while (step < swipeTimes && !CancelToken::CurrentStopped()) {
         driver.Swipe(startx, starty, endx, endy, speed);
         step++;
     }
@@ -912,9 +1387,10 @@ void Component::PinchOut(float scale)
 
     Driver driver;
     driver.InjectMultiPointerAction(pointers);
-    driver.DelayMs(DELAY_TIME);
+    driver.WaitForSettle();
 
     // set new
+    lock_guard<mutex> guard(infoLock_);
     componentInfo_.width = componentInfo_.width * scale;
     componentInfo_.height = componentInfo_.height * scale;
     componentInfo_.left = center.x - componentInfo_.width / 2;
@@ -960,9 +1436,10 @@ void Component::PinchIn(float scale)
 
     Driver driver;
     driver.InjectMultiPointerAction(pointers);
-    driver.DelayMs(DELAY_TIME);
+    driver.WaitForSettle();
 
     // set new
+    lock_guard<mutex> guard(infoLock_);
     componentInfo_.width = componentInfo_.width * scale;
     componentInfo_.height = componentInfo_.height * scale;
     componentInfo_.left = center.x - componentInfo_.width / 2;
@@ -972,8 +1449,119 @@ void Component::PinchIn(float scale)
         center.x, center.y);
 }
 
+void Component::Rotate(float degrees)
+{
+    HILOG_DEBUG("Component::Rotate degrees:%{public}f", degrees);
+    Point center = GetBoundsCenter();
+    float radius = max(min(componentInfo_.width, componentInfo_.height) / INDEX_FOUR, 1.0f);
+    float radians = degrees * static_cast<float>(M_PI) / HALF_TURN_DEGREES;
+    vector<FingerTrack> tracks;
+    // two fingers on opposite ends of a diameter, turning clockwise on screen for positive degrees
+    for (float start : { 0.0f, static_cast<float>(M_PI) }) {
+        tracks.push_back([center, radius, radians, start](float t, float& x, float& y) {
+            x = center.x + radius * cos(start + radians * t);
+            y = center.y + radius * sin(start + radians * t);
+        });
+    }
+    Driver driver;
+    DispatchFingerTracks(tracks, radius * fabs(radians), 0);
+    driver.WaitForSettle();
+}
+
+void Component::Pinch(float scale, float angle)
+{
+    HILOG_DEBUG("Component::Pinch scale:%{public}f angle:%{public}f", scale, angle);
+    if (scale <= 0.001f) {
+        HILOG_DEBUG("Component::Pinch scale[%f] invalid", scale);
+        return;
+    }
+    Point center = GetBoundsCenter();
+    float radians = angle * static_cast<float>(M_PI) / HALF_TURN_DEGREES;
+    float axisX = cos(radians);
+    float axisY = sin(radians);
+    // half length of the component along the axis, where the axis leaves the bounds
+    float halfW = fabs(axisX) > FLT_EPSILON ? componentInfo_.width / INDEX_TWO / fabs(axisX) : FLT_MAX;
+    float halfH = fabs(axisY) > FLT_EPSILON ? componentInfo_.height / INDEX_TWO / fabs(axisY) : FLT_MAX;
+    float halfExtent = min(halfW, halfH);
+    // spreading starts from half way to the edges, pinching starts at the edges
+    float fromRadius = scale >= 1.0f ? halfExtent / INDEX_TWO : halfExtent;
+    float toRadius = fromRadius * scale;
+    // both fingers stay inside the window, as the swipe paths do, a spread is cut short at the nearest edge
+    Driver driver;
+    OHOS::Ace::Platform::ComponentInfo root;
+    driver.CaptureSnapshot(root);
+    float edgeW = fabs(axisX) > FLT_EPSILON ?
+        min(center.x - root.left, root.left + root.width - 1 - center.x) / fabs(axisX) : FLT_MAX;
+    float edgeH = fabs(axisY) > FLT_EPSILON ?
+        min(center.y - root.top, root.top + root.height - 1 - center.y) / fabs(axisY) : FLT_MAX;
+    float windowRadius = max(min(edgeW, edgeH), 0.0f);
+    fromRadius = min(fromRadius, windowRadius);
+    toRadius = min(toRadius, windowRadius);
+    if (fromRadius > 0.0f) {
+        scale = toRadius / fromRadius;
+    }
+    vector<FingerTrack> tracks;
+    for (float sign : { -1.0f, 1.0f }) {
+        tracks.push_back([center, axisX, axisY, fromRadius, toRadius, sign](float t, float& x, float& y) {
+            float radius = fromRadius + (toRadius - fromRadius) * t;
+            x = center.x + sign * axisX * radius;
+            y = center.y + sign * axisY * radius;
+        });
+    }
+    DispatchFingerTracks(tracks, fabs(toRadius - fromRadius), 0);
+    driver.WaitForSettle();
+
+    // set new
+    lock_guard<mutex> guard(infoLock_);
+    componentInfo_.width = componentInfo_.width * scale;
+    componentInfo_.height = componentInfo_.height * scale;
+    componentInfo_.left = center.x - componentInfo_.width / 2;
+    componentInfo_.top = center.y - componentInfo_.height / 2;
+}
+
+static bool IsSameNode(const OHOS::Ace::Platform::ComponentInfo& info,
+    const OHOS::Ace::Platform::ComponentInfo& target)
+{
+    return info.compid == target.compid && info.type == target.type &&
+        std::abs(info.left - target.left) < BOUNDS_TOLERANCE && std::abs(info.top - target.top) < BOUNDS_TOLERANCE &&
+        std::abs(info.width - target.width) < BOUNDS_TOLERANCE &&
+        std::abs(info.height - target.height) < BOUNDS_TOLERANCE;
+}
+
+static const OHOS::Ace::Platform::ComponentInfo* FindSameNode(const OHOS::Ace::Platform::ComponentInfo& root,
+    const OHOS::Ace::Platform::ComponentInfo& target)
+{
+    if (IsSameNode(root, target)) {
+        return &root;
+    }
+    for (auto& child : root.children) {
+        auto node = FindSameNode(child, target);
+        if (node != nullptr) {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+bool Component::Refresh()
+{
+    auto uiContent = GetUIContent();
+    CHECK_NULL_RETURN(uiContent, false);
+    OHOS::Ace::Platform::ComponentInfo root;
+    uiContent->GetAllComponents(0, root);
+    auto node = FindSameNode(root, componentInfo_);
+    if (node == nullptr) {
+        HILOG_DEBUG("Component::Refresh node %{public}s not found", componentInfo_.compid.c_str());
+        return false;
+    }
+    lock_guard<mutex> guard(infoLock_);
+    componentInfo_ = *node;
+    return true;
+}
+
 void Component::SetComponentInfo(const OHOS::Ace::Platform::ComponentInfo& com)
 {
+    lock_guard<mutex> guard(infoLock_);
     componentInfo_ = com;
 }
 
@@ -982,6 +1570,41 @@ OHOS::Ace::Platform::ComponentInfo Component::GetComponentInfo()
     return componentInfo_;
 }
 
+void Component::SetExecutor(shared_ptr<OrderedExecutor> executor)
+{
+    executor_ = move(executor);
+}
+
+shared_ptr<OrderedExecutor> Component::GetExecutor() const
+{
+    return executor_;
+}
+
+ComponentAttributes Component::GetAttributes() const
+{
+    lock_guard<mutex> guard(infoLock_);
+    ComponentAttributes attributes;
+    attributes.id = componentInfo_.compid;
+    attributes.text = componentInfo_.text;
+    attributes.type = componentInfo_.type;
+    // same rounding as GetBounds() and GetBoundsCenter()
+    attributes.bounds.left = componentInfo_.left;
+    attributes.bounds.right = componentInfo_.left + componentInfo_.width;
+    attributes.bounds.top = componentInfo_.top;
+    attributes.bounds.bottom = componentInfo_.top + componentInfo_.height;
+    attributes.center.x = componentInfo_.left + componentInfo_.width / 2;
+    attributes.center.y = componentInfo_.top + componentInfo_.height / 2;
+    attributes.clickable = componentInfo_.clickable;
+    attributes.longClickable = componentInfo_.longClickable;
+    attributes.scrollable = componentInfo_.scrollable;
+    attributes.enabled = componentInfo_.enabled;
+    attributes.focused = componentInfo_.focused;
+    attributes.selected = componentInfo_.selected;
+    attributes.checked = componentInfo_.checked;
+    attributes.checkable = componentInfo_.checkable;
+    return attributes;
+}
+
 Point Component::GetBoundsCenter()
 {
     HILOG_DEBUG("Component::GetBoundsCenter");
@@ -993,6 +1616,12 @@ Point Component::GetBoundsCenter()
     return point;
 }
 
+void On::SetFlag(uint8_t flag, bool value)
+{
+    flagMask |= flag;
+    flagValue = value ? (flagValue | flag) : (flagValue & ~flag);
+}
+
 On* On::Text(const string& text, MatchPattern pattern)
 {
     HILOG_DEBUG("On::Text");
@@ -1027,6 +1656,7 @@ On* On::Enabled(bool enabled)
 {
     HILOG_DEBUG("On::Onenabled");
     this->enabled = std::make_shared<bool>(enabled);
+    SetFlag(FLAG_ENABLED, enabled);
     this->isEnter = true;
     return this;
 }
@@ -1035,6 +1665,7 @@ On* On::Focused(bool focused)
 {
     HILOG_DEBUG("Ons::Onfocused");
     this->focused = std::make_shared<bool>(focused);
+    SetFlag(FLAG_FOCUSED, focused);
     this->isEnter = true;
     return this;
 }
@@ -1043,6 +1674,7 @@ On* On::Selected(bool selected)
 {
     HILOG_DEBUG("Driver::Onselected");
     this->selected = std::make_shared<bool>(selected);
+    SetFlag(FLAG_SELECTED, selected);
     this->isEnter = true;
     return this;
 }
@@ -1051,6 +1683,7 @@ On* On::Clickable(bool clickable)
 {
     HILOG_DEBUG("Driver::Onclickable");
     this->clickable = std::make_shared<bool>(clickable);
+    SetFlag(FLAG_CLICKABLE, clickable);
     this->isEnter = true;
     return this;
 }
@@ -1059,6 +1692,7 @@ On* On::LongClickable(bool longClickable)
 {
     HILOG_DEBUG("Driver::OnlongClickable");
     this->longClickable = std::make_shared<bool>(longClickable);
+    SetFlag(FLAG_LONG_CLICKABLE, longClickable);
     this->isEnter = true;
     return this;
 }
@@ -1067,6 +1701,7 @@ On* On::Scrollable(bool scrollable)
 {
     HILOG_DEBUG("Driver::Onscrollable");
     this->scrollable = std::make_shared<bool>(scrollable);
+    SetFlag(FLAG_SCROLLABLE, scrollable);
     this->isEnter = true;
     return this;
 }
@@ -1075,6 +1710,7 @@ On* On::Checkable(bool checkable)
 {
     HILOG_DEBUG("Driver::Oncheckable");
     this->checkable = std::make_shared<bool>(checkable);
+    SetFlag(FLAG_CHECKABLE, checkable);
     this->isEnter = true;
     return this;
 }
@@ -1083,6 +1719,7 @@ On* On::Checked(bool checked)
 {
     HILOG_DEBUG("Driver::Onchecked");
     this->checked = std::make_shared<bool>(checked);
+    SetFlag(FLAG_CHECKED, checked);
     this->isEnter = true;
     return this;
 }
@@ -1128,46 +1765,36 @@ bool On::CompareText(const string& text) const
     return false;
 }
 
+static uint8_t PackFlags(const OHOS::Ace::Platform::ComponentInfo& info)
+{
+    uint8_t flags = 0;
+    flags |= info.clickable ? FLAG_CLICKABLE : 0;
+    flags |= info.longClickable ? FLAG_LONG_CLICKABLE : 0;
+    flags |= info.scrollable ? FLAG_SCROLLABLE : 0;
+    flags |= info.enabled ? FLAG_ENABLED : 0;
+    flags |= info.focused ? FLAG_FOCUSED : 0;
+    flags |= info.selected ? FLAG_SELECTED : 0;
+    flags |= info.checked ? FLAG_CHECKED : 0;
+    flags |= info.checkable ? FLAG_CHECKABLE : 0;
+    return flags;
+}
+
 bool operator == (const On& on, const OHOS::Ace::Platform::ComponentInfo& info)
 {
     if (!on.isEnter) {
         return false;
     }
-    bool res = true;
-    if (on.id) {
-        res = *on.id == info.compid && res;
-    }
-    if (on.text) {
-        res = on.CompareText(info.text) && res;
-    }
-    if (on.type) {
-        res = *on.type == info.type && res;
-    }
-    if (on.clickable) {
-        res = *on.clickable == info.clickable && res;
-    }
-    if (on.longClickable) {
-        res = *on.longClickable == info.longClickable && res;
-    }
-    if (on.scrollable) {
-        res = *on.scrollable == info.scrollable && res;
-    }
-    if (on.enabled) {
-        res = *on.enabled == info.enabled && res;
-    }
-    if (on.focused) {
-        res = *on.focused == info.focused && res;
-    }
-    if (on.selected) {
-        res = *on.selected == info.selected && res;
+    // all boolean conditions in one compare, before any string is looked at
+    if ((PackFlags(info) & on.flagMask) != on.flagValue) {
+        return false;
     }
-    if (on.checked) {
-        res = *on.checked == info.checked && res;
+    if (on.id && *on.id != info.compid) {
+        return false;
     }
-    if (on.checkable) {
-        res = *on.checkable == info.checkable && res;
+    if (on.type && *on.type != info.type) {
+        return false;
     }
-    return res;
+    return !on.text || on.CompareText(info.text);
 }
 
 bool IsRectOverlap(Rect& rect1, Rect& rect2)
@@ -1277,27 +1904,117 @@ unique_ptr<Component> GetComponentvalue(const On& on,
     return nullptr;
 }
 
-unique_ptr<Component> Driver::FindComponent(const On& on)
+static void CollectComponents(const On& on, OHOS::Ace::Platform::ComponentInfo& info,
+    vector<shared_ptr<Component>>& allComponents)
 {
-    HILOG_DEBUG("Driver::FindComponent begin");
-    auto component = make_unique<Component>();
-    OHOS::Ace::Platform::ComponentInfo info;
-    auto uiContent = GetUIContent();
-    CHECK_NULL_RETURN(uiContent, nullptr);
-    uiContent->GetAllComponents(0, info);
-    vector<shared_ptr<Component>> allComponents;
-    Rect infoRect = GetBounds(info);
     if (on.withIn) {
         On onWithIn = *(on.withIn.get());
         FindChildComponents(info, onWithIn, allComponents);
     } else {
+        Rect infoRect = GetBounds(info);
         GetAllComponentInfos(info, infoRect, allComponents, nullptr);
     }
-    HILOG_DEBUG("GetAllComponents ok, size = %d", allComponents.size());
+    HILOG_DEBUG("CollectComponents ok, size = %d", allComponents.size());
+}
+
+static unique_ptr<Component> FindComponentIn(const On& on, OHOS::Ace::Platform::ComponentInfo& info)
+{
+    vector<shared_ptr<Component>> allComponents;
+    CollectComponents(on, info, allComponents);
     vector<shared_ptr<Component>> componentsInRange = GetComponentsInRange(on, allComponents);
     return GetComponentvalue(on, componentsInRange);
 }
 
+unique_ptr<Component> Driver::FindComponent(const On& on)
+{
+    HILOG_DEBUG("Driver::FindComponent begin");
+    OHOS::Ace::Platform::ComponentInfo info;
+    auto uiContent = GetUIContent();
+    CHECK_NULL_RETURN(uiContent, nullptr);
+    uiContent->GetAllComponents(0, info);
+    return FindComponentIn(on, info);
+}
+
+// evaluate check on every changed snapshot until it returns true, polling faster right after a change
+static bool PollSnapshotUntil(Driver& driver, uint32_t timeoutMs,
+    const function<bool(OHOS::Ace::Platform::ComponentInfo&)>& check)
+{
+    auto deadline = chrono::steady_clock::now() + chrono::milliseconds(timeoutMs);
+    OHOS::Ace::Platform::ComponentInfo info;
+    uint64_t lastHash = 0;
+    bool first = true;
+    uint32_t interval = WAIT_POLL_MIN_MS;
+    while (true) {
+        uint64_t hash = driver.CaptureSnapshot(info);
+        if (first || hash != lastHash) {
+            first = false;
+            lastHash = hash;
+            interval = WAIT_POLL_MIN_MS;
+            if (check(info)) {
+                return true;
+            }
+        } else {
+            interval = min(interval + interval / 2u, WAIT_POLL_MAX_MS);
+        }
+        auto now = chrono::steady_clock::now();
+        if (now >= deadline) {
+            return false;
+        }
+        if (!CancelToken::SleepUntil(min(now + chrono::milliseconds(interval), deadline))) {
+            return false;
+        }
+    }
+}
+
+static uint32_t RecordWait(const char* tag, chrono::steady_clock::time_point start, bool found)
+{
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    auto& metrics = UiMetrics::GetInstance();
+    metrics.Add(METRIC_COMPONENT_WAIT_COUNT, 1);
+    metrics.Set(METRIC_COMPONENT_LAST_WAIT_MS, elapsed);
+    if (!found) {
+        metrics.Add(METRIC_COMPONENT_WAIT_TIMEOUT_COUNT, 1);
+    }
+    HILOG_DEBUG("%{public}s found=%{public}d elapsed=%{public}lld", tag, found, static_cast<long long>(elapsed));
+    return static_cast<uint32_t>(elapsed);
+}
+
+unique_ptr<Component> Driver::WaitForComponent(const On& on, uint32_t timeoutMs, uint32_t* waitedMs)
+{
+    HILOG_DEBUG("Driver::WaitForComponent timeoutMs=%{public}u", timeoutMs);
+    auto start = chrono::steady_clock::now();
+    unique_ptr<Component> component = nullptr;
+    // each snapshot is walked in place, nothing is collected or copied until the match is found
+    bool found = PollSnapshotUntil(*this, timeoutMs, [&on, &component](OHOS::Ace::Platform::ComponentInfo& info) {
+        auto match = ComponentWalker(on, info).Next();
+        if (match == nullptr) {
+            return false;
+        }
+        component = make_unique<Component>();
+        component->SetComponentInfo(*match);
+        return true;
+    });
+    uint32_t elapsed = RecordWait("Driver::WaitForComponent", start, found);
+    if (waitedMs != nullptr) {
+        *waitedMs = elapsed;
+    }
+    return component;
+}
+
+bool Driver::WaitForComponentDisappear(const On& on, uint32_t timeoutMs, uint32_t* waitedMs)
+{
+    HILOG_DEBUG("Driver::WaitForComponentDisappear timeoutMs=%{public}u", timeoutMs);
+    auto start = chrono::steady_clock::now();
+    bool gone = PollSnapshotUntil(*this, timeoutMs, [&on](OHOS::Ace::Platform::ComponentInfo& info) {
+        return ComponentWalker(on, info).Next() == nullptr;
+    });
+    uint32_t elapsed = RecordWait("Driver::WaitForComponentDisappear", start, gone);
+    if (waitedMs != nullptr) {
+        *waitedMs = elapsed;
+    }
+    return gone;
+}
+
 void GetComponentvalues(const On& on, vector<shared_ptr<Component>> &componentsInRange,
     vector<unique_ptr<Component>>& components)
 {
@@ -1319,21 +2036,161 @@ vector<unique_ptr<Component>> Driver::FindComponents(const On& on)
     vector<unique_ptr<Component>> components;
     OHOS::Ace::Platform::ComponentInfo info;
     auto uiContent = GetUIContent();
+    CHECK_NULL_RETURN(uiContent, components);
     uiContent->GetAllComponents(0, info);
-    Rect infoRect = GetBounds(info);
+    components = FindComponentsIn(on, info);
+    HILOG_DEBUG("Driver::FindComponents end");
+    return components;
+}
+
+vector<unique_ptr<Component>> Driver::FindComponentsIn(const On& on, OHOS::Ace::Platform::ComponentInfo& info)
+{
+    vector<unique_ptr<Component>> components;
     vector<shared_ptr<Component>> allComponents;
-    if (on.withIn) {
-        On onWithIn = *(on.withIn.get());
-        FindChildComponents(info, onWithIn, allComponents);
-    } else {
-        GetAllComponentInfos(info, infoRect, allComponents, nullptr);
-    }
+    CollectComponents(on, info, allComponents);
     vector<shared_ptr<Component>> componentsInRange = GetComponentsInRange(on, allComponents);
     GetComponentvalues(on, componentsInRange, components);
-    HILOG_DEBUG("Driver::FindComponents end");
     return components;
 }
 
+ComponentWalker::ComponentWalker(const On& on, OHOS::Ace::Platform::ComponentInfo& root) : on_(on)
+{
+    if (on_.isAfter) {
+        // the candidates start after the last isAfter match, one counting pass finds it
+        Start(root);
+        size_t index = 0;
+        for (auto node = NextCandidate(); node != nullptr; node = NextCandidate()) {
+            index++;
+            if (*on_.isAfter == *node) {
+                firstIndex_ = index;
+            }
+        }
+    }
+    Start(root);
+}
+
+void ComponentWalker::Start(OHOS::Ace::Platform::ComponentInfo& root)
+{
+    stack_.clear();
+    stack_.push_back({ &root, GetBounds(root), on_.withIn == nullptr });
+}
+
+OHOS::Ace::Platform::ComponentInfo* ComponentWalker::NextCandidate()
+{
+    while (!stack_.empty()) {
+        auto frame = stack_.back();
+        stack_.pop_back();
+        auto& children = frame.node->children;
+        Rect bounds = GetBounds(*frame.node);
+        if (!frame.inScope && *on_.withIn == *frame.node) {
+            // the withIn match itself is not a candidate, its whole subtree is
+            for (auto child = children.rbegin(); child != children.rend(); child++) {
+                stack_.push_back({ &*child, bounds, true });
+            }
+            continue;
+        }
+        // pushed in reverse, so the children come out in order, right after their parent
+        for (auto child = children.rbegin(); child != children.rend(); child++) {
+            stack_.push_back({ &*child, bounds, frame.inScope });
+        }
+        if (frame.inScope && IsRectOverlap(bounds, frame.parentBounds)) {
+            return frame.node;
+        }
+    }
+    return nullptr;
+}
+
+OHOS::Ace::Platform::ComponentInfo* ComponentWalker::Next()
+{
+    while (!done_) {
+        auto node = NextCandidate();
+        if (node == nullptr) {
+            done_ = true;
+            break;
+        }
+        size_t index = index_++;
+        if (on_.isBefore && *on_.isBefore == *node) {
+            // the first isBefore match is the last candidate, unless it is the first one
+            done_ = true;
+            if (index == 0) {
+                break;
+            }
+        }
+        if (index >= firstIndex_ && on_ == *node) {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+ComponentCursor::ComponentCursor(const On& on, OHOS::Ace::Platform::ComponentInfo&& snapshot)
+    : on_(on), snapshot_(move(snapshot)), walker_(on_, snapshot_)
+{
+    next_ = walker_.Next();
+}
+
+vector<unique_ptr<Component>> ComponentCursor::Next(size_t max)
+{
+    vector<unique_ptr<Component>> components;
+    while (next_ != nullptr && components.size() < max) {
+        // a match keeps its subtree, as in FindComponents, only what is handed out is copied
+        auto component = make_unique<Component>();
+        component->SetComponentInfo(*next_);
+        components.push_back(move(component));
+        next_ = walker_.Next();
+    }
+    return components;
+}
+
+bool ComponentCursor::Done() const
+{
+    return next_ == nullptr;
+}
+
+unique_ptr<ComponentCursor> Driver::FindComponentsCursor(const On& on)
+{
+    HILOG_DEBUG("Driver::FindComponentsCursor");
+    OHOS::Ace::Platform::ComponentInfo snapshot;
+    auto uiContent = GetUIContent();
+    if (uiContent != nullptr) {
+        uiContent->GetAllComponents(0, snapshot);
+    }
+    return make_unique<ComponentCursor>(on, move(snapshot));
+}
+
+ComponentColumns Driver::FindComponentColumns(const On& on, uint32_t columns)
+{
+    HILOG_DEBUG("Driver::FindComponentColumns columns:%{public}u", columns);
+    ComponentColumns result;
+    auto uiContent = GetUIContent();
+    CHECK_NULL_RETURN(uiContent, result);
+    OHOS::Ace::Platform::ComponentInfo info;
+    uiContent->GetAllComponents(0, info);
+    // the columns are filled straight from the snapshot, no component or attribute copy is made.
+    // the walk passes each node once, so a match can give its strings away
+    ComponentWalker walker(on, info);
+    for (auto node = walker.Next(); node != nullptr; node = walker.Next()) {
+        result.count++;
+        if (columns & COLUMN_ID) {
+            result.ids.emplace_back(move(node->compid));
+        }
+        if (columns & COLUMN_TEXT) {
+            result.texts.emplace_back(move(node->text));
+        }
+        if (columns & COLUMN_TYPE) {
+            result.types.emplace_back(move(node->type));
+        }
+        if (columns & COLUMN_BOUNDS) {
+            Rect bounds = GetBounds(*node);
+            result.bounds.insert(result.bounds.end(), { bounds.left, bounds.top, bounds.right, bounds.bottom });
+        }
+        if (columns & COLUMN_FLAGS) {
+            result.flags.push_back(PackFlags(*node));
+        }
+    }
+    return result;
+}
+
 unique_ptr<Component> Component::ScrollSearch(const On& on)
 {
     HILOG_DEBUG("Component::ScrollSearch");
@@ -1365,7 +2222,7 @@ unique_ptr<Component> Component::ScrollSearch(const On& on)
             return nullptr;
         }
         auto steps = distance / stepLen + 1;
-        for (int step = 0; step < steps; step++) {
+        for (int step = 0; step < steps && !CancelToken::CurrentStopped(); step++) {
             driver.Swipe(startX, startY, startX, startY + stepLen, 200);
         }
     }
@@ -1378,7 +2235,7 @@ unique_ptr<Component> Component::ScrollSearch(const On& on)
             return nullptr;
         }
         auto steps = distance / stepLen + 1;
-        for (int step = 0; step < steps; step++) {
+        for (int step = 0; step < steps && !CancelToken::CurrentStopped(); step++) {
             driver.Swipe(startX, startY, startX, startY - stepLen, 200);
         }
     }
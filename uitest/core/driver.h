@@ -18,7 +18,9 @@
 
 #include <memory>
 #include <map>
+#include <mutex>
 #include "component_info.h"
+#include "ordered_executor.h"
 
 namespace OHOS::UiTest {
 using namespace std;
@@ -95,6 +97,7 @@ public:
 
 class PointerMatrix;
 class Component;
+struct KeyStroke;
 
 class On {
 public:
@@ -131,9 +134,74 @@ public:
 
     bool CompareText(const string& text) const;
     bool isEnter = false;
+    // the boolean conditions compiled to ComponentFlag bits: which ones are checked, and their values
+    uint8_t flagMask = 0;
+    uint8_t flagValue = 0;
+    // node of the js selector intern tables, unique in the process, 0 when the On is not interned
+    uint32_t internId = 0;
+
+private:
+    void SetFlag(uint8_t flag, bool value);
+};
+
+// the cached attributes of a component without its children, copied out for the js thread
+struct ComponentAttributes {
+    string id;
+    string text;
+    string type;
+    Rect bounds;
+    Point center;
+    bool clickable = false;
+    bool longClickable = false;
+    bool scrollable = false;
+    bool enabled = false;
+    bool focused = false;
+    bool selected = false;
+    bool checked = false;
+    bool checkable = false;
+};
+
+// columns of FindComponentColumns, combined as a bit mask
+enum ComponentColumn : uint32_t {
+    COLUMN_ID = 1 << 0,
+    COLUMN_TEXT = 1 << 1,
+    COLUMN_TYPE = 1 << 2,
+    COLUMN_BOUNDS = 1 << 3,
+    COLUMN_FLAGS = 1 << 4,
+    COLUMN_ALL = (1 << 5) - 1
+};
+
+// bit i of a flags entry, in the order of ComponentAttributes
+enum ComponentFlag : uint8_t {
+    FLAG_CLICKABLE = 1 << 0,
+    FLAG_LONG_CLICKABLE = 1 << 1,
+    FLAG_SCROLLABLE = 1 << 2,
+    FLAG_ENABLED = 1 << 3,
+    FLAG_FOCUSED = 1 << 4,
+    FLAG_SELECTED = 1 << 5,
+    FLAG_CHECKED = 1 << 6,
+    FLAG_CHECKABLE = 1 << 7
+};
+
+/**
+ * Attributes of all matched components stored column by column, entry i of every column belongs
+ * to component i. bounds holds left, top, right, bottom of each component, 4 entries per component.
+ * Only the columns requested are filled.
+ **/
+struct ComponentColumns {
+    uint32_t count = 0;
+    vector<string> ids;
+    vector<string> texts;
+    vector<string> types;
+    vector<int32_t> bounds;
+    vector<uint8_t> flags;
 };
 
 bool operator == (const On& on, const OHOS::Ace::Platform::ComponentInfo& info);
+Rect GetBounds(const OHOS::Ace::Platform::ComponentInfo& component);
+bool IsRectOverlap(Rect& rect1, Rect& rect2);
+// hash of id, type, text and bounds of the node, children excluded, identifies it across snapshots
+uint64_t HashComponentNode(const OHOS::Ace::Platform::ComponentInfo& info);
 
 class Component {
 public:
@@ -151,7 +219,7 @@ public:
     unique_ptr<bool> IsSelected();
     unique_ptr<bool> IsChecked();
     unique_ptr<bool> IsCheckable();
-    void InputText(const string& text);
+    void InputText(const string& text, bool paste = true);
     void ClearText();
     void ScrollToTop(int speed);
     void ScrollToBottom(int speed);
@@ -159,14 +227,75 @@ public:
     Rect GetBounds();
     void PinchOut(float scale);
     void PinchIn(float scale);
+    // two finger rotation around the center, positive degrees turn clockwise
+    void Rotate(float degrees);
+    // two finger pinch along the axis at angle degrees from the x axis, scale > 1 spreads up to the window edges
+    void Pinch(float scale, float angle);
 
     void SetComponentInfo(const OHOS::Ace::Platform::ComponentInfo& com);
     OHOS::Ace::Platform::ComponentInfo GetComponentInfo();
     unique_ptr<Component> ScrollSearch(const On& on);
     Point GetBoundsCenter();
+    // re-read the cached info from the live ui tree, false if the node is gone
+    bool Refresh();
+    // operations of a component run on the executor of the driver that found it
+    void SetExecutor(shared_ptr<OrderedExecutor> executor);
+    shared_ptr<OrderedExecutor> GetExecutor() const;
+    // snapshot of the cached info, safe to call while an operation updates it on the executor
+    ComponentAttributes GetAttributes() const;
 private:
+    // guards writes of componentInfo_ and reads from other threads than the executor
+    mutable std::mutex infoLock_;
     OHOS::Ace::Platform::ComponentInfo componentInfo_;
     shared_ptr<Component> parentComponent_;
+    shared_ptr<OrderedExecutor> executor_;
+};
+
+/**
+ * The matches of an On in one snapshot, found by a depth first walk that copies no node. The candidates
+ * and their order are the ones of FindComponents: every node overlapping its parent, or the nodes below
+ * the withIn match, cut by isBefore and isAfter. The snapshot and on must outlive the walker.
+ **/
+class ComponentWalker {
+public:
+    ComponentWalker(const On& on, OHOS::Ace::Platform::ComponentInfo& root);
+    // the next match, nullptr once the walk is over
+    OHOS::Ace::Platform::ComponentInfo* Next();
+
+private:
+    struct Frame {
+        OHOS::Ace::Platform::ComponentInfo* node;
+        Rect parentBounds;
+        // the node is a candidate when it overlaps parentBounds, otherwise the withIn match is searched
+        bool inScope;
+    };
+    void Start(OHOS::Ace::Platform::ComponentInfo& root);
+    OHOS::Ace::Platform::ComponentInfo* NextCandidate();
+    const On& on_;
+    vector<Frame> stack_;
+    size_t index_ = 0;
+    size_t firstIndex_ = 0;
+    bool done_ = false;
+};
+
+/**
+ * FindComponents split into steps: the cursor holds one snapshot and walks it as Next() is called,
+ * so a consumer can use the first matches while the rest of the tree is not searched yet.
+ * Only the matches handed out are copied, one match is looked ahead so Done() is known.
+ **/
+class ComponentCursor {
+public:
+    ComponentCursor(const On& on, OHOS::Ace::Platform::ComponentInfo&& snapshot);
+    // up to max more matches, empty once the cursor is exhausted
+    vector<unique_ptr<Component>> Next(size_t max);
+    bool Done() const;
+
+private:
+    // declared in this order, the walker refers to the two members before it
+    On on_;
+    OHOS::Ace::Platform::ComponentInfo snapshot_;
+    ComponentWalker walker_;
+    OHOS::Ace::Platform::ComponentInfo* next_ = nullptr;
 };
 
 class Driver {
@@ -179,19 +308,64 @@ public:
 
     void TriggerKey(int keyCode);
     void TriggerCombineKeys(int key0, int key1, int key2 = -1);
+    // compile and send a key script such as "ctrl+shift+k alt+1 ENTER", false if it does not compile
+    bool TriggerKeys(const string& script);
+    void TriggerKeyStrokes(const vector<KeyStroke>& strokes);
     bool InjectMultiPointerAction(PointerMatrix& pointers, uint32_t speed = 0);
     
     void DelayMs(int dur);
     void Click(int x, int y);
     void DoubleClick(int x, int y);
     void LongClick(int x, int y);
+    void LongClick(int x, int y, uint32_t holdMs);
+    // taps times at (x, y), each held holdMs, successive taps start intervalMs apart, at most MAX_TAPS taps
+    static constexpr uint32_t MAX_TAPS = 100;
+    void MultiClick(int x, int y, uint32_t taps, uint32_t holdMs, uint32_t intervalMs);
     void Swipe(int startx, int starty, int endx, int endy, uint32_t speed);
     void Fling(const Point& from, const Point& to, int stepLen, uint32_t speed = 0);
     void Fling(UiDirection direction, uint32_t speed = 0);
+    void MultiSwipe(uint32_t fingers, UiDirection direction, uint32_t speed = 0);
+    void TwoFingerPan(const Point& from, const Point& to, uint32_t speed = 0);
+    void MouseMove(int x, int y);
+    void MouseClick(int x, int y);
+    // positive wheelTicks scroll the content under (x, y) down, negative ones up, clamped to MAX_WHEEL_TICKS.
+    // there is no axis event, the ticks are emulated by mouse button drags, which may select text or drag
+    // an item instead of scrolling when the component under (x, y) handles mouse drags itself
+    static constexpr int32_t MAX_WHEEL_TICKS = 1000;
+    void MouseScroll(int x, int y, int32_t wheelTicks, uint32_t speed = 0);
+    // press at from, hold still holdMs to pick up, move to to and drop
+    void Drag(const Point& from, const Point& to, uint32_t holdMs, uint32_t speed = 0);
     unique_ptr<Component> FindComponent(const On& on);
     vector<unique_ptr<Component>> FindComponents(const On& on);
+    // same match as FindComponents, only the attributes in columns (ComponentColumn mask) are kept
+    ComponentColumns FindComponentColumns(const On& on, uint32_t columns);
+    unique_ptr<ComponentCursor> FindComponentsCursor(const On& on);
+    // FindComponents on a snapshot taken by the caller
+    vector<unique_ptr<Component>> FindComponentsIn(const On& on, OHOS::Ace::Platform::ComponentInfo& info);
+    // wait on the worker until the component appears, nullptr if timeoutMs elapsed first,
+    // the time this wait took is stored in waitedMs when given
+    unique_ptr<Component> WaitForComponent(const On& on, uint32_t timeoutMs, uint32_t* waitedMs = nullptr);
+    // wait on the worker until no component matches on, false if timeoutMs elapsed first
+    bool WaitForComponentDisappear(const On& on, uint32_t timeoutMs, uint32_t* waitedMs = nullptr);
     void CalculateDirection(const OHOS::Ace::Platform::ComponentInfo& info,
         const UiDirection& direction, Point& from, Point& to);
+    // capture the whole ui tree into info, return the hash of the snapshot
+    uint64_t CaptureSnapshot(OHOS::Ace::Platform::ComponentInfo& info);
+    // wait until the ui tree keeps unchanged for idleMs, false if timeoutMs elapsed first
+    bool WaitForIdle(uint32_t idleMs, uint32_t timeoutMs);
+    // wait after an action, by ui idle detection if enabled, otherwise by a fixed delay
+    void WaitForSettle();
+    static void SetIdleSettle(bool enable);
+    // record every injected event into a binary trace at path, until StopRecording
+    bool StartRecording(const string& path);
+    bool StopRecording();
+    // replay a recorded trace, speed in [0.5, 10], coordinates follow the current screen size
+    bool Replay(const string& path, float speed = 1.0f);
+    // the thread running the operations of this driver one by one, created on first use
+    shared_ptr<OrderedExecutor> GetExecutor();
+
+private:
+    shared_ptr<OrderedExecutor> executor_;
 };
 
 class PointerMatrix {
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_clock.h"
+
+#include <chrono>
+#include <thread>
+
+#include "cancel_token.h"
+
+namespace OHOS::UiTest {
+using namespace std;
+
+EventClock& EventClock::GetInstance()
+{
+    static EventClock clock;
+    return clock;
+}
+
+int64_t EventClock::NowUs() const
+{
+    if (virtual_) {
+        return virtualNowUs_;
+    }
+    auto now = chrono::steady_clock::now();
+    return chrono::duration_cast<chrono::microseconds>(now.time_since_epoch()).count();
+}
+
+void EventClock::SleepForUs(int64_t us)
+{
+    if (us <= 0) {
+        return;
+    }
+    if (virtual_) {
+        AdvanceUs(us);
+        return;
+    }
+    // wakes early when the operation running on this thread is cancelled
+    CancelToken::SleepUntil(chrono::steady_clock::now() + chrono::microseconds(us));
+}
+
+void EventClock::SleepUntilUs(int64_t us)
+{
+    if (virtual_) {
+        // never move backwards when several threads sleep on the virtual timeline
+        int64_t now = virtualNowUs_;
+        while (now < us && !virtualNowUs_.compare_exchange_weak(now, us)) {}
+        return;
+    }
+    CancelToken::SleepUntil(chrono::steady_clock::time_point(chrono::microseconds(us)));
+}
+
+void EventClock::SetVirtual(bool enable, int64_t startUs)
+{
+    virtualNowUs_ = startUs;
+    virtual_ = enable;
+}
+
+bool EventClock::IsVirtual() const
+{
+    return virtual_;
+}
+
+void EventClock::AdvanceUs(int64_t us)
+{
+    virtualNowUs_ += us;
+}
+} // namespace OHOS::UiTest
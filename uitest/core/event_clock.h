@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_CLOCK_H
+#define EVENT_CLOCK_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace OHOS::UiTest {
+constexpr int64_t US_PER_MS = 1000;
+constexpr int64_t US_PER_SECOND = 1000000;
+
+constexpr int64_t MsToUs(int64_t ms)
+{
+    return ms * US_PER_MS;
+}
+
+/**
+ * Time base of all injected events, in microseconds.
+ * Monotonic by default, so wall clock changes cannot reorder a gesture. In virtual
+ * mode time only moves through Advance and the sleep helpers, which return at once,
+ * so generated event streams are deterministic and can run at any speed.
+ * Real sleeps return early when the operation running on the thread is cancelled (see CancelToken).
+ **/
+class EventClock {
+public:
+    static EventClock& GetInstance();
+    int64_t NowUs() const;
+    void SleepForUs(int64_t us);
+    void SleepUntilUs(int64_t us);
+    void SetVirtual(bool enable, int64_t startUs = 0);
+    bool IsVirtual() const;
+    void AdvanceUs(int64_t us);
+
+private:
+    EventClock() = default;
+    ~EventClock() = default;
+    std::atomic<bool> virtual_ { false };
+    std::atomic<int64_t> virtualNowUs_ { 0 };
+};
+} // namespace OHOS::UiTest
+
+#endif // EVENT_CLOCK_H
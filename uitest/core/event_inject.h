@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_INJECT_H
+#define EVENT_INJECT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "core/event/touch_event.h"
+#include "ui_content.h"
+
+namespace OHOS::UiTest {
+Ace::Platform::UIContent* GetUIContent();
+
+/**
+ * All events injected by the driver go through these helpers, so recording and
+ * other cross-cutting hooks only need to be installed here.
+ **/
+bool InjectTouchEvents(Ace::Platform::UIContent* uiContent, const std::vector<Ace::TouchEvent>& events);
+bool InjectKeyEvent(Ace::Platform::UIContent* uiContent, int32_t keyCode, int32_t keyAction, int32_t repeatTime,
+    int32_t metaKey = 0, const std::string& msg = "");
+bool InjectBackPressed(Ace::Platform::UIContent* uiContent);
+
+/**
+ * Scope of one gesture or key sequence. Injections made while scopes are open form one batch, in
+ * backpressure mode the ui is waited for once when the outermost scope closes, not after every event.
+ * An injection outside of any scope is a batch of its own.
+ **/
+class InjectBatch {
+public:
+    InjectBatch();
+    ~InjectBatch();
+    // wait for the events injected so far and start a new batch, false when the scope is nested
+    // or backpressure is off, the caller then paces by itself
+    bool Flush();
+
+private:
+    void Arm();
+    void Wait();
+    bool outermost_;
+    bool armed_ = false;
+    uint32_t timeoutMs_ = 0;
+    uint64_t beforeHash_ = 0;
+};
+} // namespace OHOS::UiTest
+
+#endif // EVENT_INJECT_H
@@ -0,0 +1,448 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gesture_trace.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "cancel_token.h"
+#include "event_clock.h"
+#include "event_inject.h"
+#include "touch_event_builder.h"
+#include "utils/log.h"
+
+namespace OHOS::UiTest {
+using namespace std;
+
+static constexpr const char TRACE_MAGIC[] = { 'U', 'I', 'T', 'R' };
+static constexpr const uint8_t TRACE_VERSION = 1;
+static constexpr const size_t TRACE_HEADER_SIZE = 16;
+static constexpr const size_t TRACE_FILE_BUFFER = 64 * 1024;
+static constexpr const size_t TRACE_RELEASE_CHUNK = 1024 * 1024;
+static constexpr const uint32_t TRACE_MAX_BATCH = 4096;
+static constexpr const uint32_t TRACE_MAX_MSG = 64 * 1024;
+static constexpr const uint8_t VARINT_MASK = 0x7f;
+static constexpr const uint8_t VARINT_MORE = 0x80;
+static constexpr const uint32_t VARINT_SHIFT = 7;
+static constexpr const uint32_t VARINT_MAX_SHIFT = 63;
+static constexpr const uint8_t TOUCH_TYPE_MASK = 0x0f;
+static constexpr const uint32_t SOURCE_TYPE_SHIFT = 4;
+static constexpr const uint32_t BYTE_BITS = 8;
+static constexpr const uint32_t BYTE_MASK = 0xff;
+
+static int64_t EventTimeUs(const Ace::TouchEvent& event)
+{
+    return chrono::duration_cast<chrono::microseconds>(event.time.time_since_epoch()).count();
+}
+
+static void PutVarint(vector<uint8_t>& buffer, uint64_t value)
+{
+    while (value > VARINT_MASK) {
+        buffer.push_back(static_cast<uint8_t>((value & VARINT_MASK) | VARINT_MORE));
+        value >>= VARINT_SHIFT;
+    }
+    buffer.push_back(static_cast<uint8_t>(value));
+}
+
+static void PutZigzag(vector<uint8_t>& buffer, int64_t value)
+{
+    PutVarint(buffer, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> VARINT_MAX_SHIFT));
+}
+
+static void PutUint32(vector<uint8_t>& buffer, uint32_t value)
+{
+    for (uint32_t i = 0; i < sizeof(uint32_t); i++) {
+        buffer.push_back(static_cast<uint8_t>((value >> (i * BYTE_BITS)) & BYTE_MASK));
+    }
+}
+
+GestureRecorder& GestureRecorder::GetInstance()
+{
+    static GestureRecorder recorder;
+    return recorder;
+}
+
+bool GestureRecorder::Start(const string& path, int32_t screenWidth, int32_t screenHeight)
+{
+    lock_guard<mutex> guard(lock_);
+    if (file_ != nullptr) {
+        HILOG_ERROR("GestureRecorder::Start already recording");
+        return false;
+    }
+    file_ = fopen(path.c_str(), "wb");
+    if (file_ == nullptr) {
+        HILOG_ERROR("GestureRecorder::Start open %{public}s failed", path.c_str());
+        return false;
+    }
+    setvbuf(file_, nullptr, _IOFBF, TRACE_FILE_BUFFER);
+    buffer_.clear();
+    buffer_.insert(buffer_.end(), begin(TRACE_MAGIC), end(TRACE_MAGIC));
+    buffer_.push_back(TRACE_VERSION);
+    buffer_.insert(buffer_.end(), TRACE_HEADER_SIZE - sizeof(TRACE_MAGIC) - 1 - sizeof(uint32_t) * 2, 0);
+    PutUint32(buffer_, static_cast<uint32_t>(max(screenWidth, 0)));
+    PutUint32(buffer_, static_cast<uint32_t>(max(screenHeight, 0)));
+    FlushRecord();
+    lastRecordUs_ = EventClock::GetInstance().NowUs();
+    lastX_ = 0;
+    lastY_ = 0;
+    recording_ = true;
+    HILOG_DEBUG("GestureRecorder::Start %{public}s %{public}d x %{public}d", path.c_str(), screenWidth, screenHeight);
+    return true;
+}
+
+bool GestureRecorder::Stop()
+{
+    lock_guard<mutex> guard(lock_);
+    recording_ = false;
+    if (file_ == nullptr) {
+        return false;
+    }
+    bool ok = fclose(file_) == 0;
+    file_ = nullptr;
+    buffer_.clear();
+    buffer_.shrink_to_fit();
+    HILOG_DEBUG("GestureRecorder::Stop ok=%{public}d", ok);
+    return ok;
+}
+
+bool GestureRecorder::IsRecording() const
+{
+    return recording_;
+}
+
+void GestureRecorder::BeginRecord(TraceRecordTag tag)
+{
+    int64_t now = EventClock::GetInstance().NowUs();
+    buffer_.clear();
+    buffer_.push_back(tag);
+    PutVarint(buffer_, static_cast<uint64_t>(max<int64_t>(now - lastRecordUs_, 0)));
+    lastRecordUs_ = now;
+}
+
+void GestureRecorder::FlushRecord()
+{
+    if (fwrite(buffer_.data(), 1, buffer_.size(), file_) != buffer_.size()) {
+        HILOG_ERROR("GestureRecorder write failed, recording stopped");
+        recording_ = false;
+    }
+}
+
+void GestureRecorder::RecordTouch(const vector<Ace::TouchEvent>& events)
+{
+    if (!recording_ || events.empty()) {
+        return;
+    }
+    lock_guard<mutex> guard(lock_);
+    if (file_ == nullptr) {
+        return;
+    }
+    BeginRecord(TRACE_TOUCH);
+    PutVarint(buffer_, events.size());
+    int64_t lastTimeUs = EventTimeUs(events.front());
+    for (const auto& event : events) {
+        int32_t x = static_cast<int32_t>(lround(event.x));
+        int32_t y = static_cast<int32_t>(lround(event.y));
+        int64_t timeUs = EventTimeUs(event);
+        buffer_.push_back(static_cast<uint8_t>((static_cast<uint32_t>(event.type) & TOUCH_TYPE_MASK) |
+            (static_cast<uint32_t>(event.sourceType) << SOURCE_TYPE_SHIFT)));
+        PutVarint(buffer_, static_cast<uint64_t>(max(event.id, 0)));
+        PutZigzag(buffer_, x - lastX_);
+        PutZigzag(buffer_, y - lastY_);
+        PutZigzag(buffer_, timeUs - lastTimeUs);
+        lastX_ = x;
+        lastY_ = y;
+        lastTimeUs = timeUs;
+    }
+    FlushRecord();
+}
+
+void GestureRecorder::RecordKey(int32_t keyCode, int32_t keyAction, int32_t repeatTime, int32_t metaKey,
+    const string& msg)
+{
+    if (!recording_) {
+        return;
+    }
+    lock_guard<mutex> guard(lock_);
+    if (file_ == nullptr) {
+        return;
+    }
+    BeginRecord(TRACE_KEY);
+    PutVarint(buffer_, static_cast<uint64_t>(max(keyCode, 0)));
+    buffer_.push_back(static_cast<uint8_t>(keyAction));
+    PutVarint(buffer_, static_cast<uint64_t>(max(repeatTime, 0)));
+    PutVarint(buffer_, static_cast<uint64_t>(max(metaKey, 0)));
+    PutVarint(buffer_, msg.size());
+    buffer_.insert(buffer_.end(), msg.begin(), msg.end());
+    FlushRecord();
+}
+
+void GestureRecorder::RecordBack()
+{
+    if (!recording_) {
+        return;
+    }
+    lock_guard<mutex> guard(lock_);
+    if (file_ == nullptr) {
+        return;
+    }
+    BeginRecord(TRACE_BACK);
+    FlushRecord();
+}
+
+class TraceReader {
+public:
+    TraceReader(const uint8_t* data, size_t size) : cur_(data), end_(data + size) {}
+
+    bool ReadByte(uint8_t& value)
+    {
+        if (cur_ >= end_) {
+            return false;
+        }
+        value = *cur_++;
+        return true;
+    }
+
+    bool ReadVarint(uint64_t& value)
+    {
+        value = 0;
+        for (uint32_t shift = 0; shift <= VARINT_MAX_SHIFT; shift += VARINT_SHIFT) {
+            uint8_t byte = 0;
+            if (!ReadByte(byte)) {
+                return false;
+            }
+            value |= static_cast<uint64_t>(byte & VARINT_MASK) << shift;
+            if ((byte & VARINT_MORE) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ReadZigzag(int64_t& value)
+    {
+        uint64_t raw = 0;
+        if (!ReadVarint(raw)) {
+            return false;
+        }
+        value = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+        return true;
+    }
+
+    bool Skip(size_t len)
+    {
+        if (static_cast<size_t>(end_ - cur_) < len) {
+            return false;
+        }
+        cur_ += len;
+        return true;
+    }
+
+    const uint8_t* Current() const
+    {
+        return cur_;
+    }
+
+    bool AtEnd() const
+    {
+        return cur_ >= end_;
+    }
+
+private:
+    const uint8_t* cur_;
+    const uint8_t* end_;
+};
+
+static uint32_t GetUint32(const uint8_t* data)
+{
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < sizeof(uint32_t); i++) {
+        value |= static_cast<uint32_t>(data[i]) << (i * BYTE_BITS);
+    }
+    return value;
+}
+
+struct ReplayState {
+    float speed = 1.0f;
+    float scaleX = 1.0f;
+    float scaleY = 1.0f;
+    int32_t lastX = 0;
+    int32_t lastY = 0;
+    vector<Ace::TouchEvent> events;
+};
+
+static bool ReplayTouch(TraceReader& reader, ReplayState& state)
+{
+    uint64_t count = 0;
+    if (!reader.ReadVarint(count) || count == 0 || count > TRACE_MAX_BATCH) {
+        return false;
+    }
+    state.events.clear();
+    state.events.reserve(count);
+    int64_t baseUs = EventClock::GetInstance().NowUs();
+    int64_t offsetUs = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        uint8_t flags = 0;
+        uint64_t id = 0;
+        int64_t dx = 0;
+        int64_t dy = 0;
+        int64_t dt = 0;
+        if (!reader.ReadByte(flags) || !reader.ReadVarint(id) || !reader.ReadZigzag(dx) ||
+            !reader.ReadZigzag(dy) || !reader.ReadZigzag(dt)) {
+            return false;
+        }
+        state.lastX += static_cast<int32_t>(dx);
+        state.lastY += static_cast<int32_t>(dy);
+        offsetUs += dt;
+        auto& event = state.events.emplace_back();
+        event.sourceType = static_cast<Ace::SourceType>(flags >> SOURCE_TYPE_SHIFT);
+        if (event.sourceType == Ace::SourceType::MOUSE) {
+            event.sourceTool = Ace::SourceTool::MOUSE;
+        }
+        Point point = { static_cast<int>(lround(state.lastX * state.scaleX)),
+            static_cast<int>(lround(state.lastY * state.scaleY)) };
+        auto timeUs = baseUs + static_cast<int64_t>(offsetUs / state.speed);
+        TouchEventBuilder::Fill(event, static_cast<Ace::TouchType>(flags & TOUCH_TYPE_MASK), timeUs, point,
+            static_cast<int32_t>(id));
+    }
+    auto uiContent = GetUIContent();
+    CHECK_NULL_RETURN(uiContent, false);
+    InjectTouchEvents(uiContent, state.events);
+    return true;
+}
+
+static bool ReplayKey(TraceReader& reader)
+{
+    uint64_t keyCode = 0;
+    uint8_t action = 0;
+    uint64_t repeatTime = 0;
+    uint64_t metaKey = 0;
+    uint64_t msgLen = 0;
+    if (!reader.ReadVarint(keyCode) || !reader.ReadByte(action) || !reader.ReadVarint(repeatTime) ||
+        !reader.ReadVarint(metaKey) || !reader.ReadVarint(msgLen) || msgLen > TRACE_MAX_MSG) {
+        return false;
+    }
+    string msg(reinterpret_cast<const char*>(reader.Current()), msgLen);
+    if (!reader.Skip(msgLen)) {
+        return false;
+    }
+    auto uiContent = GetUIContent();
+    CHECK_NULL_RETURN(uiContent, false);
+    InjectKeyEvent(uiContent, static_cast<int32_t>(keyCode), action, static_cast<int32_t>(repeatTime),
+        static_cast<int32_t>(metaKey), msg);
+    return true;
+}
+
+static bool ReplayRecords(TraceReader& reader, const uint8_t* base, ReplayState& state)
+{
+    auto& clock = EventClock::GetInstance();
+    int64_t startUs = clock.NowUs();
+    int64_t traceUs = 0;
+    const uint8_t* released = base;
+    long pageSize = sysconf(_SC_PAGESIZE);
+    while (!reader.AtEnd()) {
+        uint8_t tag = 0;
+        uint64_t delta = 0;
+        if (!reader.ReadByte(tag) || !reader.ReadVarint(delta)) {
+            return false;
+        }
+        traceUs += static_cast<int64_t>(delta);
+        clock.SleepUntilUs(startUs + static_cast<int64_t>(traceUs / state.speed));
+        if (CancelToken::CurrentStopped()) {
+            HILOG_INFO("GestureReplayer stopped");
+            return false;
+        }
+        bool ok = false;
+        switch (tag) {
+            case TRACE_TOUCH:
+                ok = ReplayTouch(reader, state);
+                break;
+            case TRACE_KEY:
+                ok = ReplayKey(reader);
+                break;
+            case TRACE_BACK: {
+                auto uiContent = GetUIContent();
+                ok = uiContent != nullptr && InjectBackPressed(uiContent);
+                break;
+            }
+            default:
+                HILOG_ERROR("GestureReplayer unknown record tag %{public}u", tag);
+                break;
+        }
+        if (!ok) {
+            return false;
+        }
+        // give the consumed pages back, the mapping of a long trace would otherwise stay resident
+        if (pageSize > 0 && static_cast<size_t>(reader.Current() - released) >= TRACE_RELEASE_CHUNK) {
+            size_t len = static_cast<size_t>(reader.Current() - released) / pageSize * pageSize;
+            madvise(const_cast<uint8_t*>(released), len, MADV_DONTNEED);
+            released += len;
+        }
+    }
+    return true;
+}
+
+bool GestureReplayer::Replay(const string& path, const ReplayOptions& options)
+{
+    if (options.speed < MIN_SPEED || options.speed > MAX_SPEED) {
+        HILOG_ERROR("GestureReplayer::Replay speed out of range");
+        return false;
+    }
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        HILOG_ERROR("GestureReplayer::Replay open %{public}s failed", path.c_str());
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < TRACE_HEADER_SIZE) {
+        HILOG_ERROR("GestureReplayer::Replay invalid trace file");
+        close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        HILOG_ERROR("GestureReplayer::Replay mmap failed");
+        return false;
+    }
+    madvise(addr, size, MADV_SEQUENTIAL);
+    const uint8_t* data = static_cast<const uint8_t*>(addr);
+    bool ok = false;
+    if (memcmp(data, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0 || data[sizeof(TRACE_MAGIC)] != TRACE_VERSION) {
+        HILOG_ERROR("GestureReplayer::Replay bad trace header");
+    } else {
+        uint32_t width = GetUint32(data + TRACE_HEADER_SIZE - sizeof(uint32_t) * 2);
+        uint32_t height = GetUint32(data + TRACE_HEADER_SIZE - sizeof(uint32_t));
+        ReplayState state;
+        state.speed = options.speed;
+        if (width > 0 && options.screenWidth > 0) {
+            state.scaleX = static_cast<float>(options.screenWidth) / width;
+        }
+        if (height > 0 && options.screenHeight > 0) {
+            state.scaleY = static_cast<float>(options.screenHeight) / height;
+        }
+        TraceReader reader(data + TRACE_HEADER_SIZE, size - TRACE_HEADER_SIZE);
+        ok = ReplayRecords(reader, data, state);
+    }
+    munmap(addr, size);
+    HILOG_DEBUG("GestureReplayer::Replay %{public}s ok=%{public}d", path.c_str(), ok);
+    return ok;
+}
+} // namespace OHOS::UiTest
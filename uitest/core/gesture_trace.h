@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GESTURE_TRACE_H
+#define GESTURE_TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "core/event/touch_event.h"
+
+namespace OHOS::UiTest {
+/*
+trace 文件格式(小端):
+header: magic "UITR" | version u8 | reserved u8 x3 | screenWidth u32 | screenHeight u32
+record: tag u8 | varint 距上一条记录的注入间隔(us) | payload
+    TOUCH: varint 事件数, 每个事件: u8 (type | sourceType << 4) | varint id |
+           zigzag x, y 相对上一个触摸点的差值 | zigzag 相对本批上一个事件的时间差(us)
+    KEY:   varint keyCode | u8 action | varint repeatTime | varint metaKey | varint msg 长度 | msg
+    BACK:  无 payload
+*/
+enum TraceRecordTag : uint8_t {
+    TRACE_TOUCH = 1,
+    TRACE_KEY,
+    TRACE_BACK,
+};
+
+/**
+ * Records the events injected by the driver into a binary trace file.
+ * Records are encoded into a small buffer and streamed to the file, so the
+ * memory used does not grow with the length of the recording.
+ **/
+class GestureRecorder {
+public:
+    static GestureRecorder& GetInstance();
+    bool Start(const std::string& path, int32_t screenWidth, int32_t screenHeight);
+    bool Stop();
+    bool IsRecording() const;
+    void RecordTouch(const std::vector<Ace::TouchEvent>& events);
+    void RecordKey(int32_t keyCode, int32_t keyAction, int32_t repeatTime, int32_t metaKey, const std::string& msg);
+    void RecordBack();
+
+private:
+    GestureRecorder() = default;
+    ~GestureRecorder() = default;
+    void BeginRecord(TraceRecordTag tag);
+    void FlushRecord();
+
+    std::atomic<bool> recording_ { false };
+    std::mutex lock_;
+    FILE* file_ = nullptr;
+    std::vector<uint8_t> buffer_;
+    int64_t lastRecordUs_ = 0;
+    int32_t lastX_ = 0;
+    int32_t lastY_ = 0;
+};
+
+struct ReplayOptions {
+    // 1.0 keeps the original timing, 2.0 replays twice as fast
+    float speed = 1.0f;
+    // screen size of the replay device, 0 keeps the recorded coordinates
+    int32_t screenWidth = 0;
+    int32_t screenHeight = 0;
+};
+
+/**
+ * Streams a trace back through the ui content with the recorded timing.
+ * The file is mapped and decoded sequentially, consumed pages are released
+ * so replaying a long trace runs in bounded memory.
+ **/
+class GestureReplayer {
+public:
+    static constexpr float MIN_SPEED = 0.5f;
+    static constexpr float MAX_SPEED = 10.0f;
+    bool Replay(const std::string& path, const ReplayOptions& options);
+};
+} // namespace OHOS::UiTest
+
+#endif // GESTURE_TRACE_H
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "inject_limiter.h"
+
+#include <algorithm>
+#include <atomic>
+#include "event_clock.h"
+#include "ui_metrics.h"
+
+namespace OHOS::UiTest {
+using namespace std;
+
+static constexpr const uint32_t DEFAULT_BURST_DIVISOR = 10;
+
+// counted on every injection, kept out of UiMetrics so injecting takes no lock but the limiter's own
+static atomic<int64_t> g_eventCount { 0 };
+static atomic<int64_t> g_throttleMs { 0 };
+static atomic<int64_t> g_requestedRate { 0 };
+static atomic<int64_t> g_achievedRate { 0 };
+
+InjectLimiter& InjectLimiter::GetInstance()
+{
+    static InjectLimiter limiter;
+    return limiter;
+}
+
+void InjectLimiter::Configure(const InjectLimitOptions& options)
+{
+    lock_guard<mutex> guard(lock_);
+    options_ = options;
+    if (options_.eventsPerSecond > 0 && options_.burst == 0) {
+        options_.burst = max(options_.eventsPerSecond / DEFAULT_BURST_DIVISOR, 1u);
+    }
+    tokens_ = options_.burst;
+    refillUs_ = EventClock::GetInstance().NowUs();
+    windowStartUs_ = -1;
+    windowEvents_ = 0;
+    g_requestedRate.store(options_.eventsPerSecond, memory_order_relaxed);
+    g_achievedRate.store(0, memory_order_relaxed);
+}
+
+InjectLimitOptions InjectLimiter::GetOptions()
+{
+    lock_guard<mutex> guard(lock_);
+    return options_;
+}
+
+bool InjectLimiter::IsBackpressure()
+{
+    lock_guard<mutex> guard(lock_);
+    return options_.backpressure;
+}
+
+uint32_t InjectLimiter::GetBackpressureTimeoutMs()
+{
+    lock_guard<mutex> guard(lock_);
+    return options_.backpressureTimeoutMs;
+}
+
+int64_t InjectLimiter::Acquire(uint32_t count)
+{
+    auto& clock = EventClock::GetInstance();
+    int64_t waitUs = 0;
+    {
+        lock_guard<mutex> guard(lock_);
+        int64_t nowUs = clock.NowUs();
+        if (options_.eventsPerSecond > 0) {
+            double rate = options_.eventsPerSecond;
+            tokens_ = min<double>(options_.burst, tokens_ + (nowUs - refillUs_) * rate / US_PER_SECOND);
+            refillUs_ = nowUs;
+            // take the tokens now, so concurrent callers queue up behind this batch instead of racing for refill
+            tokens_ -= count;
+            if (tokens_ < 0) {
+                waitUs = static_cast<int64_t>(-tokens_ * US_PER_SECOND / rate);
+            }
+        }
+        // the first batch opens the measuring window, later batches count against the time since it was sent
+        if (windowStartUs_ < 0) {
+            windowStartUs_ = nowUs + waitUs;
+        } else {
+            windowEvents_ += count;
+            UpdateRateMetrics(nowUs + waitUs);
+        }
+    }
+    clock.SleepForUs(waitUs);
+    g_eventCount.fetch_add(count, memory_order_relaxed);
+    if (waitUs > 0) {
+        g_throttleMs.fetch_add(waitUs / US_PER_MS, memory_order_relaxed);
+    }
+    return waitUs;
+}
+
+void InjectLimiter::DumpMetrics(map<string, int64_t>& metrics)
+{
+    metrics[METRIC_INJECT_EVENT_COUNT] = g_eventCount.load(memory_order_relaxed);
+    metrics[METRIC_INJECT_THROTTLE_MS] = g_throttleMs.load(memory_order_relaxed);
+    metrics[METRIC_INJECT_REQUESTED_RATE] = g_requestedRate.load(memory_order_relaxed);
+    metrics[METRIC_INJECT_ACHIEVED_RATE] = g_achievedRate.load(memory_order_relaxed);
+}
+
+void InjectLimiter::UpdateRateMetrics(int64_t nowUs)
+{
+    int64_t elapsedUs = nowUs - windowStartUs_;
+    if (elapsedUs <= 0) {
+        return;
+    }
+    g_achievedRate.store(windowEvents_ * US_PER_SECOND / elapsedUs, memory_order_relaxed);
+}
+} // namespace OHOS::UiTest
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INJECT_LIMITER_H
+#define INJECT_LIMITER_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace OHOS::UiTest {
+constexpr uint32_t BACKPRESSURE_TIMEOUT_MAX_MS = 60000;
+
+struct InjectLimitOptions {
+    // injected events per second, 0 means unlimited
+    uint32_t eventsPerSecond = 0;
+    // events that may be sent at once after the injection was quiet, 0 means one tenth of a second worth
+    uint32_t burst = 0;
+    // hold after every gesture or key sequence until the ui tree changed, at most backpressureTimeoutMs
+    bool backpressure = false;
+    // in (0, BACKPRESSURE_TIMEOUT_MAX_MS]
+    uint32_t backpressureTimeoutMs = 500;
+};
+
+/**
+ * Token bucket shared by every injection path, one token per touch or key event.
+ * A batch larger than the bucket is let through as debt, the next batch then waits until
+ * the debt is paid, so the long term rate never exceeds eventsPerSecond.
+ **/
+class InjectLimiter {
+public:
+    static InjectLimiter& GetInstance();
+    void Configure(const InjectLimitOptions& options);
+    InjectLimitOptions GetOptions();
+    // block until count events may be injected, return the time waited in microseconds
+    int64_t Acquire(uint32_t count);
+    bool IsBackpressure();
+    uint32_t GetBackpressureTimeoutMs();
+    // adds the injection counters under the METRIC_INJECT_ names
+    static void DumpMetrics(std::map<std::string, int64_t>& metrics);
+
+private:
+    InjectLimiter() = default;
+    ~InjectLimiter() = default;
+    void UpdateRateMetrics(int64_t nowUs);
+    InjectLimitOptions options_;
+    double tokens_ = 0.0;
+    int64_t refillUs_ = 0;
+    int64_t windowStartUs_ = -1;
+    int64_t windowEvents_ = 0;
+    std::mutex lock_;
+};
+} // namespace OHOS::UiTest
+
+#endif // INJECT_LIMITER_H
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "key_script.h"
+
+#include <array>
+#include <cctype>
+#include "core/event/key_event.h"
+#include "event_clock.h"
+
+namespace OHOS::UiTest {
+using namespace std;
+
+struct KeyName {
+    const char* name;
+    Ace::KeyCode keyCode;
+};
+
+static constexpr KeyName KEY_NAMES[] = {
+    { "ctrl", Ace::KeyCode::KEY_CTRL_LEFT },
+    { "control", Ace::KeyCode::KEY_CTRL_LEFT },
+    { "rctrl", Ace::KeyCode::KEY_CTRL_RIGHT },
+    { "shift", Ace::KeyCode::KEY_SHIFT_LEFT },
+    { "rshift", Ace::KeyCode::KEY_SHIFT_RIGHT },
+    { "alt", Ace::KeyCode::KEY_ALT_LEFT },
+    { "ralt", Ace::KeyCode::KEY_ALT_RIGHT },
+    { "meta", Ace::KeyCode::KEY_META_LEFT },
+    { "cmd", Ace::KeyCode::KEY_META_LEFT },
+    { "win", Ace::KeyCode::KEY_META_LEFT },
+    { "rmeta", Ace::KeyCode::KEY_META_RIGHT },
+    { "enter", Ace::KeyCode::KEY_ENTER },
+    { "return", Ace::KeyCode::KEY_ENTER },
+    { "tab", Ace::KeyCode::KEY_TAB },
+    { "space", Ace::KeyCode::KEY_SPACE },
+    { "esc", Ace::KeyCode::KEY_ESCAPE },
+    { "escape", Ace::KeyCode::KEY_ESCAPE },
+    { "backspace", Ace::KeyCode::KEY_DEL },
+    { "del", Ace::KeyCode::KEY_FORWARD_DEL },
+    { "delete", Ace::KeyCode::KEY_FORWARD_DEL },
+    { "insert", Ace::KeyCode::KEY_INSERT },
+    { "home", Ace::KeyCode::KEY_MOVE_HOME },
+    { "end", Ace::KeyCode::KEY_MOVE_END },
+    { "pageup", Ace::KeyCode::KEY_PAGE_UP },
+    { "pagedown", Ace::KeyCode::KEY_PAGE_DOWN },
+    { "up", Ace::KeyCode::KEY_DPAD_UP },
+    { "down", Ace::KeyCode::KEY_DPAD_DOWN },
+    { "left", Ace::KeyCode::KEY_DPAD_LEFT },
+    { "right", Ace::KeyCode::KEY_DPAD_RIGHT },
+    { "capslock", Ace::KeyCode::KEY_CAPS_LOCK },
+    { "menu", Ace::KeyCode::KEY_MENU },
+    { "back", Ace::KeyCode::KEY_BACK },
+    { "plus", Ace::KeyCode::KEY_PLUS },
+    { "comma", Ace::KeyCode::KEY_COMMA },
+    { "f1", Ace::KeyCode::KEY_F1 },
+    { "f2", Ace::KeyCode::KEY_F2 },
+    { "f3", Ace::KeyCode::KEY_F3 },
+    { "f4", Ace::KeyCode::KEY_F4 },
+    { "f5", Ace::KeyCode::KEY_F5 },
+    { "f6", Ace::KeyCode::KEY_F6 },
+    { "f7", Ace::KeyCode::KEY_F7 },
+    { "f8", Ace::KeyCode::KEY_F8 },
+    { "f9", Ace::KeyCode::KEY_F9 },
+    { "f10", Ace::KeyCode::KEY_F10 },
+    { "f11", Ace::KeyCode::KEY_F11 },
+    { "f12", Ace::KeyCode::KEY_F12 },
+};
+
+struct KeyMeta {
+    Ace::KeyCode keyCode;
+    int32_t metaKey;
+};
+
+static constexpr KeyMeta META_KEYS[] = {
+    { Ace::KeyCode::KEY_CTRL_LEFT, KEY_CTRL },
+    { Ace::KeyCode::KEY_CTRL_RIGHT, KEY_CTRL },
+    { Ace::KeyCode::KEY_SHIFT_LEFT, KEY_SHIFT },
+    { Ace::KeyCode::KEY_SHIFT_RIGHT, KEY_SHIFT },
+    { Ace::KeyCode::KEY_ALT_LEFT, KEY_ALT },
+    { Ace::KeyCode::KEY_ALT_RIGHT, KEY_ALT },
+    { Ace::KeyCode::KEY_META_LEFT, KEY_META },
+    { Ace::KeyCode::KEY_META_RIGHT, KEY_META },
+};
+
+struct AsciiKey {
+    int32_t keyCode = -1;
+    int32_t metaKey = 0;
+};
+
+static constexpr const size_t ASCII_SIZE = 128;
+using AsciiKeyTable = array<AsciiKey, ASCII_SIZE>;
+
+static constexpr void SetAsciiKey(AsciiKeyTable& table, char ch, Ace::KeyCode keyCode, int32_t metaKey = 0)
+{
+    table[static_cast<size_t>(ch)] = { static_cast<int32_t>(keyCode), metaKey };
+}
+
+static constexpr void SetAsciiRange(AsciiKeyTable& table, char first, char last, Ace::KeyCode firstKey, int32_t metaKey)
+{
+    for (char ch = first; ch <= last; ch++) {
+        table[static_cast<size_t>(ch)] = { static_cast<int32_t>(firstKey) + (ch - first), metaKey };
+    }
+}
+
+// US keyboard layout, shifted symbols carry KEY_SHIFT. Symbols use their main keyboard key, not the
+// phone keys (KEY_POUND, KEY_STAR, KEY_AT, KEY_PLUS), so the shift state matches a real keyboard
+static constexpr AsciiKeyTable MakeAsciiKeyTable()
+{
+    AsciiKeyTable table {};
+    SetAsciiRange(table, 'a', 'z', Ace::KeyCode::KEY_A, 0);
+    SetAsciiRange(table, 'A', 'Z', Ace::KeyCode::KEY_A, KEY_SHIFT);
+    SetAsciiRange(table, '0', '9', Ace::KeyCode::KEY_0, 0);
+    SetAsciiKey(table, ' ', Ace::KeyCode::KEY_SPACE);
+    SetAsciiKey(table, '\t', Ace::KeyCode::KEY_TAB);
+    SetAsciiKey(table, '\n', Ace::KeyCode::KEY_ENTER);
+    SetAsciiKey(table, '!', Ace::KeyCode::KEY_1, KEY_SHIFT);
+    SetAsciiKey(table, '"', Ace::KeyCode::KEY_APOSTROPHE, KEY_SHIFT);
+    SetAsciiKey(table, '#', Ace::KeyCode::KEY_3, KEY_SHIFT);
+    SetAsciiKey(table, '$', Ace::KeyCode::KEY_4, KEY_SHIFT);
+    SetAsciiKey(table, '%', Ace::KeyCode::KEY_5, KEY_SHIFT);
+    SetAsciiKey(table, '&', Ace::KeyCode::KEY_7, KEY_SHIFT);
+    SetAsciiKey(table, '\'', Ace::KeyCode::KEY_APOSTROPHE);
+    SetAsciiKey(table, '(', Ace::KeyCode::KEY_9, KEY_SHIFT);
+    SetAsciiKey(table, ')', Ace::KeyCode::KEY_0, KEY_SHIFT);
+    SetAsciiKey(table, '*', Ace::KeyCode::KEY_8, KEY_SHIFT);
+    SetAsciiKey(table, '+', Ace::KeyCode::KEY_EQUALS, KEY_SHIFT);
+    SetAsciiKey(table, ',', Ace::KeyCode::KEY_COMMA);
+    SetAsciiKey(table, '-', Ace::KeyCode::KEY_MINUS);
+    SetAsciiKey(table, '.', Ace::KeyCode::KEY_PERIOD);
+    SetAsciiKey(table, '/', Ace::KeyCode::KEY_SLASH);
+    SetAsciiKey(table, ':', Ace::KeyCode::KEY_SEMICOLON, KEY_SHIFT);
+    SetAsciiKey(table, ';', Ace::KeyCode::KEY_SEMICOLON);
+    SetAsciiKey(table, '<', Ace::KeyCode::KEY_COMMA, KEY_SHIFT);
+    SetAsciiKey(table, '=', Ace::KeyCode::KEY_EQUALS);
+    SetAsciiKey(table, '>', Ace::KeyCode::KEY_PERIOD, KEY_SHIFT);
+    SetAsciiKey(table, '?', Ace::KeyCode::KEY_SLASH, KEY_SHIFT);
+    SetAsciiKey(table, '@', Ace::KeyCode::KEY_2, KEY_SHIFT);
+    SetAsciiKey(table, '[', Ace::KeyCode::KEY_LEFT_BRACKET);
+    SetAsciiKey(table, '\\', Ace::KeyCode::KEY_BACKSLASH);
+    SetAsciiKey(table, ']', Ace::KeyCode::KEY_RIGHT_BRACKET);
+    SetAsciiKey(table, '^', Ace::KeyCode::KEY_6, KEY_SHIFT);
+    SetAsciiKey(table, '_', Ace::KeyCode::KEY_MINUS, KEY_SHIFT);
+    SetAsciiKey(table, '`', Ace::KeyCode::KEY_GRAVE);
+    SetAsciiKey(table, '{', Ace::KeyCode::KEY_LEFT_BRACKET, KEY_SHIFT);
+    SetAsciiKey(table, '|', Ace::KeyCode::KEY_BACKSLASH, KEY_SHIFT);
+    SetAsciiKey(table, '}', Ace::KeyCode::KEY_RIGHT_BRACKET, KEY_SHIFT);
+    SetAsciiKey(table, '~', Ace::KeyCode::KEY_GRAVE, KEY_SHIFT);
+    return table;
+}
+
+static constexpr AsciiKeyTable ASCII_KEYS = MakeAsciiKeyTable();
+static_assert(ASCII_KEYS['A'].metaKey == KEY_SHIFT && ASCII_KEYS['~'].keyCode == ASCII_KEYS['`'].keyCode,
+    "ascii key table is generated at compile time");
+
+static constexpr const int64_t CHORD_HOLD_US = MsToUs(100);
+static constexpr const int64_t CHORD_GAP_US = MsToUs(20);
+static constexpr const char CHORD_JOINER = '+';
+static constexpr const char CHORD_SEPARATOR = ',';
+
+int32_t KeyScript::GetMetaMask(int32_t keyCode)
+{
+    for (const auto& item : META_KEYS) {
+        if (static_cast<int32_t>(item.keyCode) == keyCode) {
+            return item.metaKey;
+        }
+    }
+    return 0;
+}
+
+int32_t KeyScript::LookupKey(const string& name)
+{
+    string lower;
+    lower.reserve(name.size());
+    for (char ch : name) {
+        lower.push_back(static_cast<char>(tolower(static_cast<unsigned char>(ch))));
+    }
+    int32_t keyCode = -1;
+    int32_t metaKey = 0;
+    // single unshifted characters such as "k", "1" or "/" name their own key
+    if (lower.size() == 1 && LookupChar(lower[0], keyCode, metaKey) && metaKey == 0) {
+        return keyCode;
+    }
+    for (const auto& item : KEY_NAMES) {
+        if (lower == item.name) {
+            return static_cast<int32_t>(item.keyCode);
+        }
+    }
+    return -1;
+}
+
+bool KeyScript::LookupChar(char ch, int32_t& keyCode, int32_t& metaKey)
+{
+    auto index = static_cast<unsigned char>(ch);
+    if (index >= ASCII_SIZE) {
+        return false;
+    }
+    keyCode = ASCII_KEYS[index].keyCode;
+    metaKey = ASCII_KEYS[index].metaKey;
+    return keyCode >= 0;
+}
+
+static void AppendChord(const vector<int32_t>& keys, vector<KeyStroke>& strokes, int64_t& offsetUs)
+{
+    int32_t metaKey = 0;
+    for (int32_t key : keys) {
+        metaKey |= KeyScript::GetMetaMask(key);
+        strokes.push_back({ key, static_cast<int32_t>(Ace::KeyAction::DOWN), metaKey, offsetUs });
+    }
+    offsetUs += CHORD_HOLD_US;
+    for (auto it = keys.rbegin(); it != keys.rend(); ++it) {
+        strokes.push_back({ *it, static_cast<int32_t>(Ace::KeyAction::UP), metaKey, offsetUs });
+        metaKey &= ~KeyScript::GetMetaMask(*it);
+    }
+    offsetUs += CHORD_GAP_US;
+}
+
+bool KeyScript::CompileChord(const vector<int32_t>& keys, vector<KeyStroke>& strokes)
+{
+    if (keys.empty()) {
+        return false;
+    }
+    int64_t offsetUs = strokes.empty() ? 0 : strokes.back().offsetUs + CHORD_GAP_US;
+    AppendChord(keys, strokes, offsetUs);
+    return true;
+}
+
+bool KeyScript::Compile(const string& script, vector<KeyStroke>& strokes, string& err)
+{
+    int64_t offsetUs = 0;
+    vector<int32_t> chord;
+    string name;
+    // a trailing separator flushes the last chord
+    string source = script + ' ';
+    for (size_t i = 0; i < source.size(); i++) {
+        char ch = source[i];
+        bool endOfChord = isspace(static_cast<unsigned char>(ch)) || ch == CHORD_SEPARATOR;
+        if (!endOfChord && ch != CHORD_JOINER) {
+            name.push_back(ch);
+            continue;
+        }
+        if (!name.empty()) {
+            int32_t keyCode = LookupKey(name);
+            if (keyCode < 0) {
+                err = "unknown key '" + name + "'";
+                return false;
+            }
+            chord.push_back(keyCode);
+            name.clear();
+        }
+        if (endOfChord && !chord.empty()) {
+            AppendChord(chord, strokes, offsetUs);
+            chord.clear();
+        }
+    }
+    if (strokes.empty()) {
+        err = "empty key script";
+        return false;
+    }
+    return true;
+}
+} // namespace OHOS::UiTest
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef KEY_SCRIPT_H
+#define KEY_SCRIPT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OHOS::UiTest {
+// int32_t metaKey 参数取值: CTRL = 1,    SHIFT = 2,    ALT = 4,    META = 8,
+constexpr int32_t KEY_CTRL = 1;
+constexpr int32_t KEY_SHIFT = 2;
+constexpr int32_t KEY_ALT = 4;
+constexpr int32_t KEY_META = 8;
+
+/**
+ * One compiled key event, offsetUs is its dispatch time relative to the start of the script.
+ **/
+struct KeyStroke {
+    int32_t keyCode = 0;
+    int32_t keyAction = 0;
+    int32_t metaKey = 0;
+    int64_t offsetUs = 0;
+};
+
+/**
+ * Compiles key chords into timed key events.
+ * A script is a list of chords separated by spaces or commas, the keys of a chord
+ * are joined by '+', e.g. "ctrl+shift+k, alt+1 ENTER". Key names are case insensitive,
+ * the '+' and ',' keys are written as "plus" and "comma".
+ * Keys of a chord go DOWN in order with the meta mask of the modifiers pressed so far,
+ * are held, then go UP in reverse order.
+ **/
+class KeyScript {
+public:
+    static bool Compile(const std::string& script, std::vector<KeyStroke>& strokes, std::string& err);
+    static bool CompileChord(const std::vector<int32_t>& keys, std::vector<KeyStroke>& strokes);
+    // keycode of a key name, -1 if unknown
+    static int32_t LookupKey(const std::string& name);
+    // meta mask of a modifier keycode, 0 for other keys
+    static int32_t GetMetaMask(int32_t keyCode);
+    // keycode and meta mask typing ch on a US layout, false for characters outside printable ASCII
+    static bool LookupChar(char ch, int32_t& keyCode, int32_t& metaKey);
+};
+} // namespace OHOS::UiTest
+
+#endif // KEY_SCRIPT_H
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "monkey.h"
+
+#include "core/event/key_event.h"
+#include "cancel_token.h"
+#include "event_clock.h"
+#include "event_inject.h"
+#include "gesture_trace.h"
+#include "key_script.h"
+#include "utils/log.h"
+
+namespace OHOS::UiTest {
+using namespace std;
+
+static constexpr const uint32_t MONKEY_TAP_HOLD_MS = 5;
+static constexpr const uint32_t MONKEY_SWIPE_SPEED = 12000;
+static constexpr const uint32_t MONKEY_MAX_TEXT = 8;
+static constexpr const uint32_t PERCENT = 100;
+static constexpr const uint32_t SWIPE_AXES = 2;
+static constexpr const char FIRST_PRINTABLE = ' ';
+static constexpr const char LAST_PRINTABLE = '~';
+static constexpr const Ace::KeyCode MONKEY_KEYS[] = {
+    Ace::KeyCode::KEY_DPAD_UP, Ace::KeyCode::KEY_DPAD_DOWN, Ace::KeyCode::KEY_DPAD_LEFT,
+    Ace::KeyCode::KEY_DPAD_RIGHT, Ace::KeyCode::KEY_TAB, Ace::KeyCode::KEY_ENTER, Ace::KeyCode::KEY_SPACE,
+    Ace::KeyCode::KEY_DEL, Ace::KeyCode::KEY_PAGE_UP, Ace::KeyCode::KEY_PAGE_DOWN,
+};
+static constexpr const char* ACTION_NAMES[MONKEY_ACTION_COUNT] = { "tap", "swipe", "key", "back", "text" };
+
+Monkey::Monkey(const MonkeyOptions& options) : options_(options), random_(options.seed)
+{
+    for (auto weight : options_.weights) {
+        totalWeight_ += weight;
+    }
+}
+
+const char* Monkey::GetActionName(MonkeyActionType type)
+{
+    return (type >= 0 && type < MONKEY_ACTION_COUNT) ? ACTION_NAMES[type] : "unknown";
+}
+
+// raw engine output modulo bound, unlike the std distributions it gives the same sequence on every libc++
+uint32_t Monkey::NextBelow(uint32_t bound)
+{
+    return bound == 0 ? 0 : static_cast<uint32_t>(random_() % bound);
+}
+
+MonkeyActionType Monkey::NextAction()
+{
+    uint32_t pick = NextBelow(totalWeight_);
+    for (int32_t type = 0; type < MONKEY_ACTION_COUNT; type++) {
+        if (pick < options_.weights[type]) {
+            return static_cast<MonkeyActionType>(type);
+        }
+        pick -= options_.weights[type];
+    }
+    return MONKEY_TAP;
+}
+
+Point Monkey::NextPoint(const Rect& area)
+{
+    uint32_t width = static_cast<uint32_t>(max(area.right - area.left, 1));
+    uint32_t height = static_cast<uint32_t>(max(area.bottom - area.top, 1));
+    return { area.left + static_cast<int>(NextBelow(width)), area.top + static_cast<int>(NextBelow(height)) };
+}
+
+void Monkey::CollectTargets(const OHOS::Ace::Platform::ComponentInfo& info)
+{
+    Rect rect = GetBounds(info);
+    // targets partly off screen are clipped, fully hidden ones are dropped
+    rect.left = max(rect.left, screen_.left);
+    rect.top = max(rect.top, screen_.top);
+    rect.right = min(rect.right, screen_.right);
+    rect.bottom = min(rect.bottom, screen_.bottom);
+    if (rect.right > rect.left && rect.bottom > rect.top && info.enabled) {
+        if (info.clickable || info.longClickable || info.checkable) {
+            clickables_.push_back(rect);
+        }
+        if (info.scrollable) {
+            scrollables_.push_back(rect);
+        }
+    }
+    for (auto& child : info.children) {
+        CollectTargets(child);
+    }
+}
+
+void Monkey::Refresh(Driver& driver, MonkeyResult& result)
+{
+    OHOS::Ace::Platform::ComponentInfo root;
+    states_.insert(driver.CaptureSnapshot(root));
+    result.snapshots++;
+    screen_ = GetBounds(root);
+    clickables_.clear();
+    scrollables_.clear();
+    CollectTargets(root);
+}
+
+void Monkey::Tap(Driver& driver)
+{
+    bool aimed = !clickables_.empty() && NextBelow(PERCENT) < options_.targetPercent;
+    Point point = NextPoint(aimed ? clickables_[NextBelow(clickables_.size())] : screen_);
+    driver.MultiClick(point.x, point.y, 1, MONKEY_TAP_HOLD_MS, 0);
+}
+
+void Monkey::Swipe(Driver& driver)
+{
+    bool aimed = !scrollables_.empty() && NextBelow(PERCENT) < options_.targetPercent;
+    const Rect& area = aimed ? scrollables_[NextBelow(scrollables_.size())] : screen_;
+    Point from = NextPoint(area);
+    Point to = NextPoint(area);
+    // along the scroll axis of a list, swipes across it rarely do anything
+    if (aimed) {
+        if (NextBelow(SWIPE_AXES) == 0) {
+            to.x = from.x;
+        } else {
+            to.y = from.y;
+        }
+    }
+    if (from.x == to.x && from.y == to.y) {
+        return;
+    }
+    driver.Swipe(from.x, from.y, to.x, to.y, MONKEY_SWIPE_SPEED);
+}
+
+void Monkey::Key()
+{
+    auto uiContent = GetUIContent();
+    CHECK_NULL_VOID(uiContent);
+    auto keyCode = static_cast<int32_t>(MONKEY_KEYS[NextBelow(sizeof(MONKEY_KEYS) / sizeof(MONKEY_KEYS[0]))]);
+    InjectBatch batch;
+    InjectKeyEvent(uiContent, keyCode, static_cast<int32_t>(Ace::KeyAction::DOWN), 0);
+    InjectKeyEvent(uiContent, keyCode, static_cast<int32_t>(Ace::KeyAction::UP), 0);
+}
+
+void Monkey::Back()
+{
+    auto uiContent = GetUIContent();
+    CHECK_NULL_VOID(uiContent);
+    InjectBackPressed(uiContent);
+}
+
+void Monkey::Text()
+{
+    auto uiContent = GetUIContent();
+    CHECK_NULL_VOID(uiContent);
+    uint32_t length = NextBelow(MONKEY_MAX_TEXT) + 1;
+    InjectBatch batch;
+    for (uint32_t i = 0; i < length; i++) {
+        char ch = static_cast<char>(FIRST_PRINTABLE + NextBelow(LAST_PRINTABLE - FIRST_PRINTABLE + 1));
+        int32_t keyCode = 0;
+        int32_t metaKey = 0;
+        if (!KeyScript::LookupChar(ch, keyCode, metaKey)) {
+            continue;
+        }
+        InjectKeyEvent(uiContent, keyCode, static_cast<int32_t>(Ace::KeyAction::DOWN), 0, metaKey);
+        InjectKeyEvent(uiContent, keyCode, static_cast<int32_t>(Ace::KeyAction::UP), 0, metaKey);
+    }
+}
+
+MonkeyResult Monkey::Run(Driver& driver)
+{
+    HILOG_INFO("Monkey::Run seed=%{public}llu actions=%{public}u rate=%{public}u",
+        static_cast<unsigned long long>(options_.seed), options_.actions, options_.actionsPerSecond);
+    MonkeyResult result;
+    if (totalWeight_ == 0) {
+        HILOG_ERROR("Monkey::Run all action weights are zero");
+        return result;
+    }
+    bool recording = !options_.tracePath.empty();
+    if (recording) {
+        OHOS::Ace::Platform::ComponentInfo root;
+        driver.CaptureSnapshot(root);
+        recording = GestureRecorder::GetInstance().Start(options_.tracePath, static_cast<int32_t>(root.width),
+            static_cast<int32_t>(root.height));
+    }
+    auto& clock = EventClock::GetInstance();
+    const int64_t startUs = clock.NowUs();
+    const int64_t periodUs = options_.actionsPerSecond > 0 ? US_PER_SECOND / options_.actionsPerSecond : 0;
+    const uint32_t interval = max(options_.snapshotInterval, 1u);
+    bool stale = true;
+    for (uint32_t i = 0; i < options_.actions; i++) {
+        // absolute schedule, a slow action is caught up by the next ones instead of shifting the rest
+        clock.SleepUntilUs(startUs + periodUs * i);
+        if (CancelToken::CurrentStopped()) {
+            HILOG_INFO("Monkey stopped after %{public}u actions", i);
+            break;
+        }
+        if (stale || i % interval == 0) {
+            Refresh(driver, result);
+            stale = false;
+        }
+        auto type = NextAction();
+        switch (type) {
+            case MONKEY_TAP:
+                Tap(driver);
+                break;
+            case MONKEY_SWIPE:
+                Swipe(driver);
+                break;
+            case MONKEY_KEY:
+                Key();
+                break;
+            case MONKEY_BACK:
+                Back();
+                // the page most likely changed, aim the next action at the new one
+                stale = true;
+                break;
+            default:
+                Text();
+                break;
+        }
+        result.actionCounts[type]++;
+        result.actions++;
+    }
+    if (recording) {
+        GestureRecorder::GetInstance().Stop();
+    }
+    result.totalUs = clock.NowUs() - startUs;
+    result.distinctStates = states_.size();
+    HILOG_INFO("Monkey::Run done actions=%{public}u states=%{public}u us=%{public}lld", result.actions,
+        result.distinctStates, static_cast<long long>(result.totalUs));
+    return result;
+}
+} // namespace OHOS::UiTest
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MONKEY_H
+#define MONKEY_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "driver.h"
+
+namespace OHOS::UiTest {
+enum MonkeyActionType : int32_t {
+    MONKEY_TAP = 0,
+    MONKEY_SWIPE,
+    MONKEY_KEY,
+    MONKEY_BACK,
+    MONKEY_TEXT,
+    MONKEY_ACTION_COUNT
+};
+
+struct MonkeyOptions {
+    // same seed, same app state, same action sequence
+    uint64_t seed = 0;
+    uint32_t actions = 1000;
+    // 0 runs the actions back to back
+    uint32_t actionsPerSecond = 100;
+    // relative weight of every MonkeyActionType
+    uint32_t weights[MONKEY_ACTION_COUNT] = { 50, 20, 10, 5, 15 };
+    // re-read the ui tree every snapshotInterval actions, and after every back
+    uint32_t snapshotInterval = 5;
+    // percentage of taps and swipes aimed at clickable or scrollable components, the others hit random points
+    uint32_t targetPercent = 80;
+    // when not empty, every injected event is recorded there, replayable by Driver::Replay
+    std::string tracePath;
+};
+
+struct MonkeyResult {
+    uint32_t actions = 0;
+    uint32_t distinctStates = 0;
+    uint32_t snapshots = 0;
+    int64_t totalUs = 0;
+    uint32_t actionCounts[MONKEY_ACTION_COUNT] = { 0 };
+};
+
+/**
+ * Native random input generator, runs a whole soak test on the worker without a round trip per action.
+ * Actions use short holds and strokes so hundreds of them fit in a second, targets are drawn from the
+ * last snapshot of the ui tree, and every distinct snapshot hash counts as a visited state.
+ **/
+class Monkey {
+public:
+    explicit Monkey(const MonkeyOptions& options);
+    MonkeyResult Run(Driver& driver);
+    static const char* GetActionName(MonkeyActionType type);
+
+private:
+    uint32_t NextBelow(uint32_t bound);
+    MonkeyActionType NextAction();
+    Point NextPoint(const Rect& area);
+    void Refresh(Driver& driver, MonkeyResult& result);
+    void CollectTargets(const OHOS::Ace::Platform::ComponentInfo& info);
+    void Tap(Driver& driver);
+    void Swipe(Driver& driver);
+    void Key();
+    void Back();
+    void Text();
+
+    MonkeyOptions options_;
+    std::mt19937_64 random_;
+    uint32_t totalWeight_ = 0;
+    Rect screen_ = { 0, 0, 0, 0 };
+    std::vector<Rect> clickables_;
+    std::vector<Rect> scrollables_;
+    std::unordered_set<uint64_t> states_;
+};
+} // namespace OHOS::UiTest
+
+#endif // MONKEY_H
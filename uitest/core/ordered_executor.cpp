@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ordered_executor.h"
+
+#include <thread>
+#include "event_clock.h"
+#include "ui_metrics.h"
+
+namespace OHOS::UiTest {
+using namespace std;
+
+MpscQueue::MpscQueue() : head_(&stub_), tail_(&stub_) {}
+
+void MpscQueue::Push(Node* node)
+{
+    node->next.store(nullptr, memory_order_relaxed);
+    Node* prev = head_.exchange(node, memory_order_acq_rel);
+    // between the exchange and this store the node is unreachable from tail_, Pop reports empty meanwhile
+    prev->next.store(node, memory_order_release);
+}
+
+MpscQueue::Node* MpscQueue::Pop()
+{
+    Node* tail = tail_;
+    Node* next = tail->next.load(memory_order_acquire);
+    if (tail == &stub_) {
+        if (next == nullptr) {
+            return nullptr;
+        }
+        tail_ = next;
+        tail = next;
+        next = next->next.load(memory_order_acquire);
+    }
+    if (next != nullptr) {
+        tail_ = next;
+        return tail;
+    }
+    if (tail != head_.load(memory_order_acquire)) {
+        return nullptr;
+    }
+    // tail is the last node, put the stub behind it so tail can be handed out
+    Push(&stub_);
+    next = tail->next.load(memory_order_acquire);
+    if (next != nullptr) {
+        tail_ = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+// counters of all executors, kept out of UiMetrics so posting and running a task take no lock
+static atomic<int64_t> g_taskCount { 0 };
+static atomic<int64_t> g_queueDepth { 0 };
+static atomic<int64_t> g_maxQueueDepth { 0 };
+static atomic<int64_t> g_waitUs { 0 };
+static atomic<int64_t> g_lastWaitUs { 0 };
+
+OrderedExecutor::OrderedExecutor() : queues_(make_shared<Queues>())
+{
+    thread(Loop, queues_).detach();
+}
+
+OrderedExecutor::~OrderedExecutor()
+{
+    {
+        lock_guard<mutex> guard(queues_->parkLock);
+        queues_->stop = true;
+    }
+    queues_->parkCond.notify_one();
+}
+
+struct FunctionTask {
+    MpscQueue::Node node;
+    function<void()> task;
+};
+
+static void RunFunctionTask(void* arg)
+{
+    unique_ptr<FunctionTask> task(static_cast<FunctionTask*>(arg));
+    task->task();
+}
+
+void OrderedExecutor::Post(function<void()> task, TaskPriority priority)
+{
+    auto functionTask = new FunctionTask();
+    functionTask->task = move(task);
+    functionTask->node.run = RunFunctionTask;
+    functionTask->node.arg = functionTask;
+    Post(&functionTask->node, priority);
+}
+
+void OrderedExecutor::Post(MpscQueue::Node* node, TaskPriority priority)
+{
+    node->enqueueUs = EventClock::GetInstance().NowUs();
+    queues_->queues[priority].Push(node);
+    uint32_t depth = queues_->pending.fetch_add(1, memory_order_acq_rel) + 1;
+    int64_t total = g_queueDepth.fetch_add(1, memory_order_relaxed) + 1;
+    int64_t peak = g_maxQueueDepth.load(memory_order_relaxed);
+    while (total > peak && !g_maxQueueDepth.compare_exchange_weak(peak, total, memory_order_relaxed)) {
+        // peak is reloaded by the failed exchange
+    }
+    if (depth == 1) {
+        // the worker only parks with nothing pending, taking the lock orders this wakeup after its check
+        lock_guard<mutex> guard(queues_->parkLock);
+        queues_->parkCond.notify_one();
+    }
+}
+
+uint32_t OrderedExecutor::GetDepth() const
+{
+    return queues_->pending.load(memory_order_acquire);
+}
+
+void OrderedExecutor::DumpMetrics(map<string, int64_t>& metrics)
+{
+    metrics[METRIC_EXECUTOR_TASK_COUNT] = g_taskCount.load(memory_order_relaxed);
+    metrics[METRIC_EXECUTOR_QUEUE_DEPTH] = g_queueDepth.load(memory_order_relaxed);
+    metrics[METRIC_EXECUTOR_MAX_QUEUE_DEPTH] = g_maxQueueDepth.load(memory_order_relaxed);
+    metrics[METRIC_EXECUTOR_WAIT_US] = g_waitUs.load(memory_order_relaxed);
+    metrics[METRIC_EXECUTOR_LAST_WAIT_US] = g_lastWaitUs.load(memory_order_relaxed);
+}
+
+MpscQueue::Node* OrderedExecutor::Take(Queues& queues)
+{
+    while (queues.pending.load(memory_order_acquire) > 0) {
+        for (auto& queue : queues.queues) {
+            if (auto node = queue.Pop()) {
+                return node;
+            }
+        }
+        // a producer is between its exchange and link, it finishes in a few instructions
+        this_thread::yield();
+    }
+    return nullptr;
+}
+
+void OrderedExecutor::Loop(shared_ptr<Queues> queues)
+{
+    while (true) {
+        {
+            unique_lock<mutex> lock(queues->parkLock);
+            queues->parkCond.wait(lock, [&queues]() {
+                return queues->pending.load(memory_order_acquire) > 0 || queues->stop;
+            });
+        }
+        auto node = Take(*queues);
+        if (node == nullptr) {
+            if (queues->stop) {
+                return;
+            }
+            continue;
+        }
+        int64_t waitUs = EventClock::GetInstance().NowUs() - node->enqueueUs;
+        g_taskCount.fetch_add(1, memory_order_relaxed);
+        g_waitUs.fetch_add(waitUs, memory_order_relaxed);
+        g_lastWaitUs.store(waitUs, memory_order_relaxed);
+        node->run(node->arg);
+        queues->pending.fetch_sub(1, memory_order_acq_rel);
+        g_queueDepth.fetch_sub(1, memory_order_relaxed);
+    }
+}
+} // namespace OHOS::UiTest
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ORDERED_EXECUTOR_H
+#define ORDERED_EXECUTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace OHOS::UiTest {
+enum TaskPriority : int32_t {
+    // cheap reads that do not touch the ui, run before any queued normal task
+    PRIORITY_HIGH = 0,
+    PRIORITY_NORMAL,
+    PRIORITY_COUNT
+};
+
+/**
+ * Intrusive multi producer single consumer queue (Vyukov), Push is wait free for any thread,
+ * Pop must only be called by the one consumer. Pop may miss a node whose Push is half done,
+ * the caller retries while it knows more nodes are pending.
+ **/
+class MpscQueue {
+public:
+    // owned by whoever pushes it, the queue only links it
+    struct Node {
+        std::atomic<Node*> next { nullptr };
+        int64_t enqueueUs = 0;
+        void (*run)(void* arg) = nullptr;
+        void* arg = nullptr;
+    };
+
+    MpscQueue();
+    void Push(Node* node);
+    Node* Pop();
+
+private:
+    std::atomic<Node*> head_;
+    Node* tail_;
+    Node stub_;
+};
+
+/**
+ * One worker thread running tasks in submission order, one FIFO per priority.
+ * Producers never block each other, the worker parks on a condition variable only when
+ * no task is pending. The queues belong to the worker, so the destructor does not wait: remaining
+ * tasks still run and the worker exits after them. It may therefore run on the worker itself,
+ * e.g. when a task holds the last reference to the executor.
+ **/
+class OrderedExecutor {
+public:
+    OrderedExecutor();
+    ~OrderedExecutor();
+    void Post(std::function<void()> task, TaskPriority priority = PRIORITY_NORMAL);
+    // posts without allocating, node->run(node->arg) is called once and the node is not touched afterwards,
+    // so run may hand the node's storage back to its owner
+    void Post(MpscQueue::Node* node, TaskPriority priority = PRIORITY_NORMAL);
+    uint32_t GetDepth() const;
+    // adds the counters of all executors of the process, under the METRIC_EXECUTOR_ names
+    static void DumpMetrics(std::map<std::string, int64_t>& metrics);
+
+private:
+    struct Queues {
+        MpscQueue queues[PRIORITY_COUNT];
+        std::atomic<uint32_t> pending { 0 };
+        std::atomic<bool> stop { false };
+        std::mutex parkLock;
+        std::condition_variable parkCond;
+    };
+    static void Loop(std::shared_ptr<Queues> queues);
+    static MpscQueue::Node* Take(Queues& queues);
+    std::shared_ptr<Queues> queues_;
+};
+} // namespace OHOS::UiTest
+
+#endif // ORDERED_EXECUTOR_H
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "touch_event_builder.h"
+
+#include <chrono>
+
+namespace OHOS::UiTest {
+using namespace std;
+
+static constexpr const size_t STREAM_CACHE_CAPACITY = 8;
+
+static inline Ace::TimeStamp ToTimeStamp(int64_t timeUs)
+{
+    return Ace::TimeStamp(chrono::microseconds(timeUs));
+}
+
+TouchEventBuilder::TouchEventBuilder(size_t capacity)
+{
+    events_.reserve(capacity);
+}
+
+void TouchEventBuilder::Reserve(size_t capacity)
+{
+    events_.reserve(capacity);
+}
+
+void TouchEventBuilder::SetSource(Ace::SourceType type, Ace::SourceTool tool)
+{
+    sourceType_ = type;
+    sourceTool_ = tool;
+}
+
+void TouchEventBuilder::Fill(Ace::TouchEvent& event, Ace::TouchType type, int64_t timeUs, const Point& point,
+    int32_t id)
+{
+    event.id = id;
+    event.time = ToTimeStamp(timeUs);
+    event.type = type;
+    event.x = point.x;
+    event.y = point.y;
+    event.screenX = point.x;
+    event.screenY = point.y;
+    // same pointer as UpdatePointers() builds, without copying the whole event
+    event.pointers.resize(1);
+    auto& pointer = event.pointers.front();
+    pointer.id = id;
+    pointer.x = event.x;
+    pointer.y = event.y;
+    pointer.screenX = event.screenX;
+    pointer.screenY = event.screenY;
+    pointer.downTime = event.time;
+    pointer.size = event.size;
+    pointer.force = event.force;
+    pointer.sourceTool = event.sourceTool;
+    pointer.isPressed = (type == Ace::TouchType::DOWN);
+}
+
+void TouchEventBuilder::Add(Ace::TouchType type, int64_t timeUs, const Point& point, int32_t id)
+{
+    auto& event = events_.emplace_back();
+    event.sourceType = sourceType_;
+    event.sourceTool = sourceTool_;
+    Fill(event, type, timeUs, point, id);
+}
+
+void TouchEventBuilder::AddMoves(const PointPair& line, int64_t startUs, int64_t durationUs, uint32_t steps,
+    uint32_t count, int32_t id)
+{
+    if (steps == 0) {
+        return;
+    }
+    const int distanceX = line.to.x - line.from.x;
+    const int distanceY = line.to.y - line.from.y;
+    const int stepCount = static_cast<int>(steps);
+    for (uint32_t step = 1; step <= count; step++) {
+        const int index = static_cast<int>(step);
+        Point point = { line.from.x + distanceX * index / stepCount, line.from.y + distanceY * index / stepCount };
+        Add(Ace::TouchType::MOVE, startUs + durationUs * step / steps, point, id);
+    }
+}
+
+void TouchEventBuilder::Repeat(size_t first, size_t count, int64_t offsetUs)
+{
+    if (first + count > events_.size()) {
+        return;
+    }
+    events_.reserve(events_.size() + count);
+    for (size_t index = first; index < first + count; index++) {
+        // reserved above, the source reference stays valid while appending
+        auto& event = events_.emplace_back(events_[index]);
+        event.time += chrono::microseconds(offsetUs);
+        for (auto& pointer : event.pointers) {
+            pointer.downTime += chrono::microseconds(offsetUs);
+        }
+    }
+}
+
+size_t TouchEventBuilder::Size() const
+{
+    return events_.size();
+}
+
+vector<Ace::TouchEvent>& TouchEventBuilder::Events()
+{
+    return events_;
+}
+
+vector<Ace::TouchEvent> TouchEventBuilder::Take()
+{
+    return move(events_);
+}
+
+void TouchEventBuilder::Retime(vector<Ace::TouchEvent>& events, int64_t offsetUs)
+{
+    const chrono::microseconds offset(offsetUs);
+    for (auto& event : events) {
+        event.time += offset;
+        for (auto& pointer : event.pointers) {
+            pointer.downTime += offset;
+        }
+    }
+}
+
+bool operator == (const StrokeKey& left, const StrokeKey& right)
+{
+    return left.kind == right.kind && left.line.from.x == right.line.from.x &&
+        left.line.from.y == right.line.from.y && left.line.to.x == right.line.to.x &&
+        left.line.to.y == right.line.to.y && left.steps == right.steps && left.speed == right.speed;
+}
+
+TouchStreamCache& TouchStreamCache::GetInstance()
+{
+    static TouchStreamCache cache;
+    return cache;
+}
+
+TouchStream TouchStreamCache::Find(const StrokeKey& key)
+{
+    lock_guard<mutex> guard(lock_);
+    for (auto it = entries_.begin(); it != entries_.end(); it++) {
+        if (it->first == key) {
+            entries_.splice(entries_.begin(), entries_, it);
+            return entries_.front().second;
+        }
+    }
+    return nullptr;
+}
+
+void TouchStreamCache::Store(const StrokeKey& key, TouchStream stream)
+{
+    lock_guard<mutex> guard(lock_);
+    entries_.emplace_front(key, move(stream));
+    if (entries_.size() > STREAM_CACHE_CAPACITY) {
+        entries_.pop_back();
+    }
+}
+
+void TouchStreamCache::Clear()
+{
+    lock_guard<mutex> guard(lock_);
+    entries_.clear();
+}
+} // namespace OHOS::UiTest
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TOUCH_EVENT_BUILDER_H
+#define TOUCH_EVENT_BUILDER_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "core/event/touch_event.h"
+#include "driver.h"
+
+namespace OHOS::UiTest {
+/**
+ * Builds a time ordered touch event stream in one buffer.
+ * The caller reserves the final event count up front, every event is constructed in place
+ * and its single pointer is filled directly, so no TouchEvent or pointer vector is copied.
+ **/
+class TouchEventBuilder {
+public:
+    TouchEventBuilder() = default;
+    explicit TouchEventBuilder(size_t capacity);
+    void Reserve(size_t capacity);
+    // source type and tool of the events added from now on
+    void SetSource(Ace::SourceType type, Ace::SourceTool tool);
+    void Add(Ace::TouchType type, int64_t timeUs, const Point& point, int32_t id = 0);
+    // MOVE events for steps 1..count of a line cut into steps, step i at startUs + durationUs * i / steps
+    void AddMoves(const PointPair& line, int64_t startUs, int64_t durationUs, uint32_t steps, uint32_t count,
+        int32_t id = 0);
+    // append the events [first, first + count) again, shifted by offsetUs
+    void Repeat(size_t first, size_t count, int64_t offsetUs);
+    size_t Size() const;
+    std::vector<Ace::TouchEvent>& Events();
+    std::vector<Ace::TouchEvent> Take();
+
+    // fill event as a single pointer event, the pointer is written in place instead of UpdatePointers()
+    static void Fill(Ace::TouchEvent& event, Ace::TouchType type, int64_t timeUs, const Point& point, int32_t id);
+    static void Retime(std::vector<Ace::TouchEvent>& events, int64_t offsetUs);
+
+private:
+    std::vector<Ace::TouchEvent> events_;
+    Ace::SourceType sourceType_ = Ace::SourceType::NONE;
+    Ace::SourceTool sourceTool_ = Ace::SourceTool::UNKNOWN;
+};
+
+enum StrokeKind : int32_t {
+    STROKE_SWIPE = 0,
+    STROKE_FLING,
+};
+
+// parameters fully determining a generated stroke, the stream is stored relative to time 0
+struct StrokeKey {
+    StrokeKind kind;
+    PointPair line;
+    int32_t steps;
+    uint32_t speed;
+};
+
+bool operator == (const StrokeKey& left, const StrokeKey& right);
+
+using TouchStream = std::shared_ptr<const std::vector<Ace::TouchEvent>>;
+
+/**
+ * Recently generated strokes, so a repeated gesture (e.g. the swipes of ScrollToTop) is
+ * copied and retimed instead of regenerated. Least recently used entries are dropped first.
+ **/
+class TouchStreamCache {
+public:
+    static TouchStreamCache& GetInstance();
+    TouchStream Find(const StrokeKey& key);
+    void Store(const StrokeKey& key, TouchStream stream);
+    void Clear();
+
+private:
+    TouchStreamCache() = default;
+    ~TouchStreamCache() = default;
+    std::list<std::pair<StrokeKey, TouchStream>> entries_;
+    std::mutex lock_;
+};
+} // namespace OHOS::UiTest
+
+#endif // TOUCH_EVENT_BUILDER_H
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ui_metrics.h"
+
+namespace OHOS::UiTest {
+using namespace std;
+
+UiMetrics& UiMetrics::GetInstance()
+{
+    static UiMetrics metrics;
+    return metrics;
+}
+
+void UiMetrics::Add(const string& name, int64_t delta)
+{
+    lock_guard<mutex> guard(lock_);
+    counters_[name] += delta;
+}
+
+void UiMetrics::Set(const string& name, int64_t value)
+{
+    lock_guard<mutex> guard(lock_);
+    counters_[name] = value;
+}
+
+int64_t UiMetrics::Get(const string& name)
+{
+    lock_guard<mutex> guard(lock_);
+    auto it = counters_.find(name);
+    return it == counters_.end() ? 0 : it->second;
+}
+
+map<string, int64_t> UiMetrics::Dump()
+{
+    lock_guard<mutex> guard(lock_);
+    return counters_;
+}
+
+void UiMetrics::Reset()
+{
+    lock_guard<mutex> guard(lock_);
+    counters_.clear();
+}
+} // namespace OHOS::UiTest
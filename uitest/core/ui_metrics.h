@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UI_METRICS_H
+#define UI_METRICS_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace OHOS::UiTest {
+// metric names, exported to js as the keys of driver.getMetrics()
+constexpr const char* METRIC_IDLE_WAIT_COUNT = "idleWaitCount";
+constexpr const char* METRIC_IDLE_WAIT_MS = "idleWaitMs";
+constexpr const char* METRIC_IDLE_TIMEOUT_COUNT = "idleTimeoutCount";
+constexpr const char* METRIC_SETTLE_SAVED_MS = "settleSavedMs";
+constexpr const char* METRIC_SETTLE_EXTRA_MS = "settleExtraMs";
+constexpr const char* METRIC_SNAPSHOT_COUNT = "snapshotCount";
+constexpr const char* METRIC_COMPONENT_WAIT_COUNT = "componentWaitCount";
+constexpr const char* METRIC_COMPONENT_WAIT_TIMEOUT_COUNT = "componentWaitTimeoutCount";
+constexpr const char* METRIC_COMPONENT_LAST_WAIT_MS = "componentLastWaitMs";
+constexpr const char* METRIC_INJECT_EVENT_COUNT = "injectEventCount";
+constexpr const char* METRIC_INJECT_REQUESTED_RATE = "injectRequestedRate";
+constexpr const char* METRIC_INJECT_ACHIEVED_RATE = "injectAchievedRate";
+constexpr const char* METRIC_INJECT_THROTTLE_MS = "injectThrottleMs";
+constexpr const char* METRIC_BACKPRESSURE_WAIT_COUNT = "backpressureWaitCount";
+constexpr const char* METRIC_BACKPRESSURE_TIMEOUT_COUNT = "backpressureTimeoutCount";
+constexpr const char* METRIC_EXECUTOR_TASK_COUNT = "executorTaskCount";
+constexpr const char* METRIC_EXECUTOR_QUEUE_DEPTH = "executorQueueDepth";
+constexpr const char* METRIC_EXECUTOR_MAX_QUEUE_DEPTH = "executorMaxQueueDepth";
+constexpr const char* METRIC_EXECUTOR_WAIT_US = "executorWaitUs";
+constexpr const char* METRIC_EXECUTOR_LAST_WAIT_US = "executorLastWaitUs";
+constexpr const char* METRIC_MONITOR_SNAPSHOT_COUNT = "monitorSnapshotCount";
+constexpr const char* METRIC_MONITOR_EVALUATE_COUNT = "monitorEvaluateCount";
+constexpr const char* METRIC_MONITOR_EVENT_COUNT = "monitorEventCount";
+
+/**
+ * Process wide counters of the driver, values are accumulated since the module is loaded.
+ **/
+class UiMetrics {
+public:
+    static UiMetrics& GetInstance();
+    void Add(const std::string& name, int64_t delta);
+    void Set(const std::string& name, int64_t value);
+    int64_t Get(const std::string& name);
+    std::map<std::string, int64_t> Dump();
+    void Reset();
+
+private:
+    UiMetrics() = default;
+    ~UiMetrics() = default;
+    std::map<std::string, int64_t> counters_;
+    std::mutex lock_;
+};
+} // namespace OHOS::UiTest
+
+#endif // UI_METRICS_H
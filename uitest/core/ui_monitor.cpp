@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ui_monitor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_set>
+#include "ui_metrics.h"
+#include "utils/log.h"
+
+namespace OHOS::UiTest {
+using namespace std;
+using OHOS::Ace::Platform::ComponentInfo;
+
+// screenChanged watches have no selector, intern ids start at 1
+static constexpr uint64_t SCREEN_SELECTOR_KEY = 0;
+// keys of selectors that are not interned, above every intern id
+static constexpr uint64_t PRIVATE_SELECTOR_KEY = 1ULL << 32;
+
+// copy of the node with its children left out, they are swapped out for the copy and back
+static ComponentInfo CopyWithoutChildren(ComponentInfo& node)
+{
+    decltype(node.children) children;
+    node.children.swap(children);
+    ComponentInfo copy = node;
+    node.children.swap(children);
+    return copy;
+}
+
+static unique_ptr<Component> MakeComponent(const ComponentInfo& info)
+{
+    auto component = make_unique<Component>();
+    component->SetComponentInfo(info);
+    return component;
+}
+
+UiMonitor& UiMonitor::GetInstance()
+{
+    static UiMonitor monitor;
+    return monitor;
+}
+
+UiMonitor::~UiMonitor()
+{
+    {
+        lock_guard<mutex> guard(lock_);
+        stop_ = true;
+    }
+    cond_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+uint32_t UiMonitor::Watch(UiEventType type, const On* on, UiEventSink sink)
+{
+    lock_guard<mutex> guard(lock_);
+    const uint32_t watchId = nextWatchId_++;
+    uint64_t selectorKey = SCREEN_SELECTOR_KEY;
+    if (type != UI_EVENT_SCREEN_CHANGED && on != nullptr) {
+        // interned Ons are equal selectors, their watches share one evaluation
+        selectorKey = on->internId != 0 ? on->internId : (PRIVATE_SELECTOR_KEY | watchId);
+        pendingSelectors_.emplace(selectorKey, *on);
+    }
+    watches_[watchId] = { type, selectorKey, move(sink) };
+    dirty_ = true;
+    if (!worker_.joinable()) {
+        worker_ = thread([this]() { Loop(); });
+    }
+    cond_.notify_all();
+    HILOG_DEBUG("UiMonitor::Watch id=%{public}u type=%{public}d", watchId, type);
+    return watchId;
+}
+
+void UiMonitor::Unwatch(uint32_t watchId)
+{
+    // sinks run under lock_, taking it waits for a delivery in progress
+    lock_guard<mutex> guard(lock_);
+    if (watches_.erase(watchId) > 0) {
+        dirty_ = true;
+    }
+}
+
+void UiMonitor::SetIntervalMs(uint32_t intervalMs)
+{
+    lock_guard<mutex> guard(lock_);
+    intervalMs_ = clamp(intervalMs, MONITOR_INTERVAL_MIN_MS, MONITOR_INTERVAL_MAX_MS);
+    cond_.notify_all();
+}
+
+uint32_t UiMonitor::GetIntervalMs()
+{
+    lock_guard<mutex> guard(lock_);
+    return intervalMs_;
+}
+
+void UiMonitor::Loop()
+{
+    Driver driver;
+    EventMap events;
+    while (true) {
+        {
+            unique_lock<mutex> guard(lock_);
+            if (watches_.empty()) {
+                // parked, the next watch starts from a new baseline
+                hasSnapshot_ = false;
+                selectors_.clear();
+            }
+            cond_.wait(guard, [this]() { return stop_ || !watches_.empty(); });
+            if (stop_) {
+                return;
+            }
+            if (dirty_) {
+                Reconcile();
+            }
+        }
+        ComponentInfo root;
+        uint64_t hash = driver.CaptureSnapshot(root);
+        UiMetrics::GetInstance().Add(METRIC_MONITOR_SNAPSHOT_COUNT, 1);
+        bool changed = hasSnapshot_ && hash != lastHash_;
+        // the first snapshot is the baseline, nothing changed before it
+        if (changed) {
+            events[SCREEN_SELECTOR_KEY].push_back({ UI_EVENT_SCREEN_CHANGED, ComponentInfo() });
+        }
+        Evaluate(root, changed, events);
+        hasSnapshot_ = true;
+        lastHash_ = hash;
+
+        unique_lock<mutex> guard(lock_);
+        if (!events.empty()) {
+            Deliver(events);
+            events.clear();
+        }
+        const auto interval = chrono::milliseconds(intervalMs_);
+        // a new selector is primed right away instead of after the interval
+        cond_.wait_for(guard, interval, [this]() { return stop_ || !pendingSelectors_.empty(); });
+    }
+}
+
+void UiMonitor::Reconcile()
+{
+    for (auto& [key, on] : pendingSelectors_) {
+        if (selectors_.find(key) != selectors_.end()) {
+            continue;
+        }
+        auto& selector = selectors_[key];
+        selector.relative = on.isBefore != nullptr || on.isAfter != nullptr || on.withIn != nullptr;
+        selector.on = move(on);
+    }
+    pendingSelectors_.clear();
+    unordered_set<uint64_t> used;
+    for (const auto& [watchId, watch] : watches_) {
+        used.insert(watch.selectorKey);
+    }
+    for (auto it = selectors_.begin(); it != selectors_.end();) {
+        it = used.count(it->first) > 0 ? next(it) : selectors_.erase(it);
+    }
+    dirty_ = false;
+}
+
+void UiMonitor::Evaluate(ComponentInfo& root, bool changed, EventMap& events)
+{
+    vector<pair<uint64_t, Selector*>> selectors;
+    for (auto& [key, selector] : selectors_) {
+        // an unchanged tree matches as before, only new selectors need their first evaluation
+        if (changed || !selector.primed) {
+            selectors.emplace_back(key, &selector);
+        }
+    }
+    if (selectors.empty()) {
+        return;
+    }
+    UiMetrics::GetInstance().Add(METRIC_MONITOR_EVALUATE_COUNT, 1);
+    vector<unordered_map<uint64_t, ComponentInfo>> current(selectors.size());
+    vector<size_t> plain;
+    for (size_t index = 0; index < selectors.size(); index++) {
+        if (!selectors[index].second->relative) {
+            plain.push_back(index);
+        }
+    }
+    // every plain selector against every node in one depth first pass, a node counts when it overlaps
+    // its parent, as in FindComponents
+    vector<pair<ComponentInfo*, Rect>> stack = { { &root, GetBounds(root) } };
+    while (!plain.empty() && !stack.empty()) {
+        auto [node, parentBounds] = stack.back();
+        stack.pop_back();
+        Rect bounds = GetBounds(*node);
+        if (IsRectOverlap(bounds, parentBounds)) {
+            for (size_t index : plain) {
+                if (selectors[index].second->on == *node) {
+                    current[index].emplace(HashComponentNode(*node), CopyWithoutChildren(*node));
+                }
+            }
+        }
+        for (auto& child : node->children) {
+            stack.emplace_back(&child, bounds);
+        }
+    }
+    Driver driver;
+    for (size_t index = 0; index < selectors.size(); index++) {
+        auto& [key, selector] = selectors[index];
+        if (selector->relative) {
+            for (auto& component : driver.FindComponentsIn(selector->on, root)) {
+                ComponentInfo info = component->GetComponentInfo();
+                info.children.clear();
+                current[index].emplace(HashComponentNode(info), move(info));
+            }
+        }
+        if (selector->primed) {
+            Diff(selector->matched, current[index], events[key]);
+        }
+        selector->matched = move(current[index]);
+        selector->primed = true;
+    }
+}
+
+void UiMonitor::Diff(unordered_map<uint64_t, ComponentInfo>& before, unordered_map<uint64_t, ComponentInfo>& after,
+    vector<PendingEvent>& events)
+{
+    for (auto& [identity, info] : after) {
+        if (before.find(identity) == before.end()) {
+            events.push_back({ UI_EVENT_COMPONENT_APPEAR, info });
+        }
+    }
+    for (auto& [identity, info] : before) {
+        if (after.find(identity) == after.end()) {
+            events.push_back({ UI_EVENT_COMPONENT_DISAPPEAR, info });
+        }
+    }
+}
+
+void UiMonitor::Deliver(EventMap& events)
+{
+    // one pass over the watches, each picks the events of its selector
+    uint32_t delivered = 0;
+    for (auto& [watchId, watch] : watches_) {
+        auto found = events.find(watch.selectorKey);
+        if (found == events.end()) {
+            continue;
+        }
+        for (const auto& event : found->second) {
+            if (event.type != watch.type) {
+                continue;
+            }
+            UiEvent uiEvent = { event.type, watchId, nullptr };
+            if (event.type != UI_EVENT_SCREEN_CHANGED) {
+                uiEvent.component = MakeComponent(event.info);
+            }
+            watch.sink(move(uiEvent));
+            delivered++;
+        }
+    }
+    UiMetrics::GetInstance().Add(METRIC_MONITOR_EVENT_COUNT, delivered);
+}
+} // namespace OHOS::UiTest
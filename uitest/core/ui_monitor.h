@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UI_MONITOR_H
+#define UI_MONITOR_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "driver.h"
+
+namespace OHOS::UiTest {
+enum UiEventType : int32_t {
+    UI_EVENT_COMPONENT_APPEAR = 0,
+    UI_EVENT_COMPONENT_DISAPPEAR,
+    UI_EVENT_SCREEN_CHANGED,
+};
+
+constexpr uint32_t MONITOR_INTERVAL_MIN_MS = 16;
+constexpr uint32_t MONITOR_INTERVAL_MAX_MS = 10000;
+constexpr uint32_t MONITOR_INTERVAL_DEFAULT_MS = 100;
+
+struct UiEvent {
+    UiEventType type = UI_EVENT_SCREEN_CHANGED;
+    uint32_t watchId = 0;
+    // attributes of the component that appeared or disappeared, without its children
+    std::unique_ptr<Component> component;
+};
+
+using UiEventSink = std::function<void(UiEvent&&)>;
+
+/**
+ * One thread watching the ui for every subscription of the process. Each interval it takes one snapshot,
+ * only when the tree hash changed it evaluates the selectors of all watches in a single traversal and
+ * diffs their matches against the previous snapshot. Watches with the same interned On share one
+ * evaluation, so the cost follows the snapshot size and the distinct selectors, not the watch count.
+ * Components present when a selector is first evaluated do not appear, only later transitions are reported.
+ * Sinks are called on the monitor thread and must not block.
+ **/
+class UiMonitor {
+public:
+    static UiMonitor& GetInstance();
+    // on is ignored for UI_EVENT_SCREEN_CHANGED, returns the watch id
+    uint32_t Watch(UiEventType type, const On* on, UiEventSink sink);
+    // once this returns no sink call of the watch is running or follows
+    void Unwatch(uint32_t watchId);
+    // clamped to [MONITOR_INTERVAL_MIN_MS, MONITOR_INTERVAL_MAX_MS]
+    void SetIntervalMs(uint32_t intervalMs);
+    uint32_t GetIntervalMs();
+
+private:
+    struct Selector {
+        On on;
+        // isBefore/isAfter/withIn need the whole tree, evaluated through Driver::FindComponentsIn
+        bool relative = false;
+        bool primed = false;
+        // identity hash of each node matched in the last snapshot -> its info without children
+        std::unordered_map<uint64_t, OHOS::Ace::Platform::ComponentInfo> matched;
+    };
+    struct WatchEntry {
+        UiEventType type;
+        uint64_t selectorKey;
+        UiEventSink sink;
+    };
+    struct PendingEvent {
+        UiEventType type;
+        OHOS::Ace::Platform::ComponentInfo info;
+    };
+    // selector key -> events of one snapshot
+    using EventMap = std::unordered_map<uint64_t, std::vector<PendingEvent>>;
+
+    UiMonitor() = default;
+    ~UiMonitor();
+    void Loop();
+    void Reconcile();
+    void Evaluate(OHOS::Ace::Platform::ComponentInfo& root, bool changed, EventMap& events);
+    static void Diff(std::unordered_map<uint64_t, OHOS::Ace::Platform::ComponentInfo>& before,
+        std::unordered_map<uint64_t, OHOS::Ace::Platform::ComponentInfo>& after, std::vector<PendingEvent>& events);
+    void Deliver(EventMap& events);
+
+    // guards the members below up to worker_, sinks are called while holding it
+    std::mutex lock_;
+    std::condition_variable cond_;
+    std::map<uint32_t, WatchEntry> watches_;
+    // selectors of new watches, moved into selectors_ by the monitor thread
+    std::unordered_map<uint64_t, On> pendingSelectors_;
+    bool dirty_ = false;
+    bool stop_ = false;
+    uint32_t nextWatchId_ = 1;
+    uint32_t intervalMs_ = MONITOR_INTERVAL_DEFAULT_MS;
+    std::thread worker_;
+    // monitor thread only
+    std::unordered_map<uint64_t, Selector> selectors_;
+    bool hasSnapshot_ = false;
+    uint64_t lastHash_ = 0;
+};
+} // namespace OHOS::UiTest
+
+#endif // UI_MONITOR_H
@@ -15,39 +15,459 @@
 
 #include "driver_napi_libn.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+
+#include "../core/action_batch.h"
+#include "../core/cancel_token.h"
 #include "../core/driver.h"
+#include "../core/gesture_trace.h"
+#include "../core/inject_limiter.h"
+#include "../core/key_script.h"
+#include "../core/monkey.h"
+#include "../core/ui_metrics.h"
+#include "../core/ui_monitor.h"
 
 namespace OHOS::UiTest {
 
 using namespace std;
 using namespace LibN;
+static const NClassId ON_CLASS_ID = NClass::GetClassId(OnNExporter::ON_CLASS_NAME);
+static const NClassId COMPONENT_CLASS_ID = NClass::GetClassId(ComponentNExporter::COMPONENT_CLASS_NAME);
+static const NClassId DRIVER_CLASS_ID = NClass::GetClassId(DriverNExporter::DRIVER_CLASS_NAME);
+static const NClassId POINTER_MATRIX_CLASS_ID = NClass::GetClassId(PointerMatrixNExporter::POINTER_MATRIX_CLASS_NAME);
 static napi_ref OnRef = nullptr;
 static napi_ref PmRef = nullptr;
 static constexpr const int32_t MAX_FINGERS = 10;
 static constexpr const int32_t MAX_STEPS = 1000;
+static constexpr const int32_t DEFAULT_IDLE_MS = 200;
+static constexpr const int32_t DEFAULT_IDLE_TIMEOUT_MS = 5000;
+static constexpr const int32_t DEFAULT_WAIT_COMPONENT_MS = 5000;
+static constexpr const double DEFAULT_PINCH_ANGLE = 90.0;
+static constexpr const int32_t DEFAULT_STREAM_CHUNK = 64;
+static constexpr const int32_t MAX_STREAM_CHUNK = 4096;
+static constexpr const size_t STREAM_BUFFERED_CHUNKS = 4;
+static constexpr const uint32_t ON_ROOT_INTERN_ID = 1;
+static constexpr const size_t MAX_INTERNED_ONS = 4096;
 
 class ArgsCls {
 public:
     unique_ptr<Component> component = nullptr;
     vector<unique_ptr<Component>> components;
-    unique_ptr<bool> isCommonBool;
 };
 
+/**
+ * Cancellation of one call from its trailing { timeoutMs, signal } options (see NFuncArg::InitArgsWithCallOptions).
+ * The deadline counts from the call, so time spent queued behind earlier operations is included.
+ * A js timer for the deadline and an 'abort' listener on the signal reject the promise right away, even
+ * while the call waits behind others; the work then stops at its next check or is skipped when reached.
+ * Both are removed again when the work completes.
+ **/
+class CallCancelGuard : public NAsyncGuard {
+public:
+    // nullptr when the call has no options
+    static unique_ptr<NAsyncGuard> Create(napi_env env, const NFuncArg& funcArg);
+    void Arm(napi_env env, NAsyncReject reject) override;
+    NError Exec(const NContextCBExec& cbExec) override;
+    void Complete(napi_env env) override;
+
+private:
+    // shared with the js callbacks, which only see it weakly and may outlive the call until collected
+    struct State {
+        explicit State(uint32_t timeoutMs) : token(timeoutMs) {}
+        CancelToken token;
+        NAsyncReject reject;
+    };
+
+    bool ParseTimeout(NVal options);
+    bool ListenSignal(napi_env env, NVal options);
+    void StartTimer(napi_env env);
+    napi_value CreateCallback(napi_env env, const char* name, napi_callback cb);
+    static void Stop(napi_env env, napi_callback_info info, CancelReason reason);
+    static napi_value OnAbort(napi_env env, napi_callback_info info);
+    static napi_value OnTimeout(napi_env env, napi_callback_info info);
+
+    bool invalid_ = false;
+    uint32_t timeoutMs_ = 0;
+    shared_ptr<State> state_;
+    NRef signal_;
+    NRef listener_;
+    // { id } of the pending setTimeout, the id is a number or an object depending on the runtime
+    NRef timer_;
+};
+
+unique_ptr<NAsyncGuard> CallCancelGuard::Create(napi_env env, const NFuncArg& funcArg)
+{
+    napi_value options = funcArg.GetCallOptions();
+    if (options == nullptr) {
+        return nullptr;
+    }
+    auto guard = make_unique<CallCancelGuard>();
+    // an invalid option rejects the call with E_PARAMS before it runs
+    guard->invalid_ = !guard->ParseTimeout(NVal(env, options)) || !guard->ListenSignal(env, NVal(env, options));
+    return guard;
+}
+
+bool CallCancelGuard::ParseTimeout(NVal options)
+{
+    NVal jsTimeout = options.GetProp("timeoutMs");
+    int32_t timeoutMs = 0;
+    if (jsTimeout.TypeIs(napi_number)) {
+        timeoutMs = get<1>(jsTimeout.ToInt32());
+    } else if (jsTimeout && !jsTimeout.TypeIs(napi_undefined)) {
+        timeoutMs = -1;
+    }
+    if (timeoutMs < 0) {
+        HILOG_ERROR("CallCancelGuard timeoutMs must be a non-negative number");
+        return false;
+    }
+    timeoutMs_ = static_cast<uint32_t>(timeoutMs);
+    state_ = make_shared<State>(timeoutMs_);
+    return true;
+}
+
+napi_value CallCancelGuard::CreateCallback(napi_env env, const char* name, napi_callback cb)
+{
+    auto holder = new weak_ptr<State>(state_);
+    napi_value callback = nullptr;
+    napi_status status = napi_create_function(env, name, NAPI_AUTO_LENGTH, cb, holder, &callback);
+    if (status == napi_ok) {
+        status = napi_wrap(env, callback, holder,
+            [](napi_env env, void* data, void* hint) { delete static_cast<weak_ptr<State>*>(data); },
+            nullptr, nullptr);
+    }
+    if (status != napi_ok) {
+        HILOG_ERROR("CallCancelGuard cannot create %{public}s callback for %{public}d", name, status);
+        delete holder;
+        return nullptr;
+    }
+    return callback;
+}
+
+bool CallCancelGuard::ListenSignal(napi_env env, NVal options)
+{
+    NVal signal = options.GetProp("signal");
+    if (!signal || signal.TypeIs(napi_undefined)) {
+        return true;
+    }
+    NVal addListener = signal.GetProp("addEventListener");
+    if (!signal.TypeIs(napi_object) || !addListener.TypeIs(napi_function)) {
+        HILOG_ERROR("CallCancelGuard signal must be an AbortSignal");
+        return false;
+    }
+    auto [succ, aborted] = signal.GetProp("aborted").ToBool();
+    if (succ && aborted) {
+        state_->token.Cancel();
+        return true;
+    }
+    napi_value listener = CreateCallback(env, "abort", OnAbort);
+    if (listener == nullptr) {
+        return false;
+    }
+    napi_value argv[] = { NVal::CreateUTF8String(env, "abort").val_, listener };
+    napi_call_function(env, signal.val_, addListener.val_, sizeof(argv) / sizeof(argv[0]), argv, nullptr);
+    signal_.Reset(signal);
+    listener_.Reset(NVal(env, listener));
+    return true;
+}
+
+void CallCancelGuard::StartTimer(napi_env env)
+{
+    napi_value global = nullptr;
+    napi_get_global(env, &global);
+    NVal setTimeout = NVal(env, global).GetProp("setTimeout");
+    if (!setTimeout.TypeIs(napi_function)) {
+        // the deadline still holds, only the rejection waits until the work is reached
+        HILOG_INFO("CallCancelGuard no setTimeout in this runtime");
+        return;
+    }
+    napi_value callback = CreateCallback(env, "timeout", OnTimeout);
+    if (callback == nullptr) {
+        return;
+    }
+    napi_value argv[] = { callback, NVal::CreateInt64(env, timeoutMs_).val_ };
+    napi_value id = nullptr;
+    napi_status status = napi_call_function(env, global, setTimeout.val_, sizeof(argv) / sizeof(argv[0]), argv, &id);
+    if (status != napi_ok || id == nullptr) {
+        HILOG_ERROR("CallCancelGuard cannot start timer for %{public}d", status);
+        return;
+    }
+    NVal timer = NVal::CreateObject(env);
+    timer.AddProp("id", id);
+    timer_.Reset(timer);
+}
+
+void CallCancelGuard::Arm(napi_env env, NAsyncReject reject)
+{
+    if (invalid_) {
+        reject(env, NError(E_PARAMS));
+        return;
+    }
+    if (state_->token.IsStopped()) {
+        reject(env, NError(state_->token.GetReason() == CANCEL_TIMEOUT ? E_TIMEOUT : E_CANCELLED));
+        return;
+    }
+    state_->reject = move(reject);
+    if (timeoutMs_ > 0) {
+        StartTimer(env);
+    }
+}
+
+void CallCancelGuard::Stop(napi_env env, napi_callback_info info, CancelReason reason)
+{
+    void* data = nullptr;
+    napi_get_cb_info(env, info, nullptr, nullptr, nullptr, &data);
+    auto state = static_cast<weak_ptr<State>*>(data)->lock();
+    if (state == nullptr) {
+        return;
+    }
+    // the js timer may run a little ahead of the steady clock, cancel so the work cannot start any more
+    state->token.Cancel();
+    if (state->reject != nullptr) {
+        HILOG_INFO("CallCancelGuard call rejected before completion, reason %{public}d", reason);
+        state->reject(env, NError(reason == CANCEL_TIMEOUT ? E_TIMEOUT : E_CANCELLED));
+    }
+}
+
+napi_value CallCancelGuard::OnAbort(napi_env env, napi_callback_info info)
+{
+    Stop(env, info, CANCEL_ABORTED);
+    return nullptr;
+}
+
+napi_value CallCancelGuard::OnTimeout(napi_env env, napi_callback_info info)
+{
+    Stop(env, info, CANCEL_TIMEOUT);
+    return nullptr;
+}
+
+NError CallCancelGuard::Exec(const NContextCBExec& cbExec)
+{
+    if (invalid_) {
+        return NError(E_PARAMS);
+    }
+    auto& token = state_->token;
+    auto reason = token.GetReason();
+    if (reason == CANCEL_NONE) {
+        CancelScope scope(&token);
+        NError err = cbExec != nullptr ? cbExec() : NError(ERRNO_NOERR);
+        reason = token.GetReason();
+        if (reason == CANCEL_NONE) {
+            return err;
+        }
+    }
+    HILOG_INFO("CallCancelGuard operation stopped, reason %{public}d", reason);
+    return NError(reason == CANCEL_TIMEOUT ? E_TIMEOUT : E_CANCELLED);
+}
+
+void CallCancelGuard::Complete(napi_env env)
+{
+    if (state_ != nullptr) {
+        state_->reject = nullptr;
+    }
+    if (timer_) {
+        napi_value global = nullptr;
+        napi_get_global(env, &global);
+        NVal clearTimeout = NVal(env, global).GetProp("clearTimeout");
+        if (clearTimeout.TypeIs(napi_function)) {
+            napi_value argv[] = { timer_.Deref(env).GetProp("id").val_ };
+            napi_call_function(env, global, clearTimeout.val_, sizeof(argv) / sizeof(argv[0]), argv, nullptr);
+        }
+        timer_.Reset();
+    }
+    if (!listener_) {
+        return;
+    }
+    NVal signal = signal_.Deref(env);
+    NVal removeListener = signal.GetProp("removeEventListener");
+    if (removeListener.TypeIs(napi_function)) {
+        napi_value argv[] = { NVal::CreateUTF8String(env, "abort").val_, listener_.Deref(env).val_ };
+        napi_call_function(env, signal.val_, removeListener.val_, sizeof(argv) / sizeof(argv[0]), argv, nullptr);
+    }
+    listener_.Reset();
+    signal_.Reset();
+}
+
+// posts into the node slot of the pooled context, so ordered calls allocate nothing to get queued
+class ExecutorPoster : public NTaskPoster {
+public:
+    ExecutorPoster(shared_ptr<OrderedExecutor> executor, TaskPriority priority)
+        : executor_(move(executor)), priority_(priority)
+    {
+    }
+
+    bool CanPost() const override
+    {
+        return executor_ != nullptr;
+    }
+
+    void Post(NTaskRun run, void *arg, void *slot) const override
+    {
+        static_assert(sizeof(MpscQueue::Node) <= N_TASK_SLOT_SIZE, "executor node does not fit the task slot");
+        auto node = new (slot) MpscQueue::Node();
+        node->run = run;
+        node->arg = arg;
+        executor_->Post(node, priority_);
+    }
+
+private:
+    shared_ptr<OrderedExecutor> executor_;
+    TaskPriority priority_;
+};
+
+// run on the given executor in submission order, nullptr falls back to the libuv pool
+static ExecutorPoster PostTo(shared_ptr<OrderedExecutor> executor, TaskPriority priority = PRIORITY_NORMAL)
+{
+    return ExecutorPoster(move(executor), priority);
+}
+
+/**
+ * Schedule exec on the worker with a result slot of type T owned by this call alone,
+ * toJs converts the slot into the promise value on the js thread. Concurrent calls of
+ * the same exporter therefore never read each other's result.
+ **/
+template<typename T, typename Exec, typename ToJs>
+static napi_value ScheduleWithResult(napi_env env, const NFuncArg& funcArg, const NTaskPoster& poster,
+    const string& procedureName, Exec exec, ToJs toJs)
+{
+    auto result = make_shared<T>();
+    auto cbExec = [result, exec = move(exec)]() -> NError {
+        exec(*result);
+        return NError(ERRNO_NOERR);
+    };
+
+    auto cbCompl = [result, toJs = move(toJs)](napi_env env, NError err) -> NVal {
+        if (err) {
+            return { env, err.GetNapiErr(env) };
+        }
+        return toJs(env, *result);
+    };
+    return NAsyncWorkOrdered(env, NVal(env, funcArg.GetThisVar()), poster, CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
+}
+
 OnNExporter::OnNExporter(napi_env env, napi_value exports) : NExporter(env, exports) {}
 
 OnNExporter::~OnNExporter() {}
 
-static napi_value Instantiate(napi_env env, napi_value thisVar)
+// one builder step on a parent selector, the structural key of the On it produces
+struct OnStep {
+    uint32_t parent = 0;
+    int32_t type = 0;
+    // match pattern, condition value or intern id of the relative On, by type
+    int32_t value = 0;
+    string text;
+};
+
+static bool operator == (const OnStep& left, const OnStep& right)
 {
-    napi_value OnVal = nullptr;
-    napi_get_reference_value(env, OnRef, &OnVal);
-    bool result;
-    napi_strict_equals(env, OnVal, thisVar, &result);
-    if (result) {
-        HILOG_DEBUG("Uitest:: On addr equals.");
-        thisVar = NClass::InstantiateClass(env, OnNExporter::ON_CLASS_NAME, {});
+    return left.parent == right.parent && left.type == right.type && left.value == right.value &&
+        left.text == right.text;
+}
+
+struct OnStepHash {
+    size_t operator()(const OnStep& step) const
+    {
+        size_t seed = hash<string>()(step.text);
+        for (uint32_t field : { step.parent, static_cast<uint32_t>(step.type), static_cast<uint32_t>(step.value) }) {
+            seed = (seed ^ field) * 0x100000001b3ULL;
+        }
+        return seed;
     }
-    return thisVar;
+};
+
+// intern ids are unique in the process, UiMonitor keys selectors by them across all envs
+static atomic<uint32_t> g_nextInternId { ON_ROOT_INTERN_ID + 1 };
+
+/**
+ * Hash consed selectors of one env. A builder call never changes its On, it resolves (parent, step)
+ * to the child On, so identical chains share one immutable On and js object after the first build
+ * and cost one lookup instead of an instance and a copy. Interned nodes live as long as the env;
+ * past MAX_INTERNED_ONS, and below an On that is not interned, children are built but not interned.
+ **/
+class OnInternTable {
+public:
+    static OnInternTable& Get(napi_env env)
+    {
+        auto [it, inserted] = GetTables().try_emplace(env);
+        if (inserted) {
+            napi_add_env_cleanup_hook(env, RemoveEnv, env);
+        }
+        return it->second;
+    }
+
+    template<typename Apply>
+    napi_value Derive(napi_env env, const On& parent, OnStep&& step, Apply&& apply)
+    {
+        bool internable = step.parent != 0;
+        if (internable) {
+            auto find = nodes_.find(step);
+            if (find != nodes_.end()) {
+                napi_value node = nullptr;
+                napi_get_reference_value(env, find->second, &node);
+                return node;
+            }
+        }
+        napi_value node = NClass::InstantiateClass(env, ON_CLASS_ID, {});
+        auto child = NClass::GetEntityOf<On>(env, node);
+        if (child == nullptr) {
+            HILOG_ERROR("Cannot instantiate On");
+            return nullptr;
+        }
+        *child = parent;
+        apply(*child, step);
+        child->internId = 0;
+        napi_ref ref = nullptr;
+        if (internable && nodes_.size() < MAX_INTERNED_ONS && napi_create_reference(env, node, 1, &ref) == napi_ok) {
+            child->internId = g_nextInternId.fetch_add(1, memory_order_relaxed);
+            nodes_.emplace(move(step), ref);
+        }
+        return node;
+    }
+
+private:
+    // an env is only used on its own js thread, so its table needs no lock
+    static unordered_map<napi_env, OnInternTable>& GetTables()
+    {
+        static thread_local unordered_map<napi_env, OnInternTable> tables;
+        return tables;
+    }
+
+    static void RemoveEnv(void* arg)
+    {
+        auto env = static_cast<napi_env>(arg);
+        auto& tables = GetTables();
+        auto find = tables.find(env);
+        if (find == tables.end()) {
+            return;
+        }
+        for (auto& node : find->second.nodes_) {
+            napi_delete_reference(env, node.second);
+        }
+        tables.erase(find);
+    }
+
+    unordered_map<OnStep, napi_ref, OnStepHash> nodes_;
+};
+
+// the On built from thisVar by one more step, apply(on, step) performs the step on a copy of thisVar's On
+template<typename Apply>
+static napi_value DeriveOn(napi_env env, napi_value thisVar, OnStep&& step, Apply&& apply, bool internable = true)
+{
+    auto parent = NClass::GetEntityOf<On>(env, thisVar);
+    if (parent == nullptr) {
+        HILOG_ERROR("Cannot get entity of on");
+        return nullptr;
+    }
+    step.parent = internable ? parent->internId : 0;
+    return OnInternTable::Get(env).Derive(env, *parent, move(step), apply);
 }
 
 napi_value OnNExporter::Text(napi_env env, napi_callback_info info)
@@ -67,12 +487,6 @@ napi_value OnNExporter::Text(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    napi_value thisVar = Instantiate(env, funcArg.GetThisVar());
-    auto on = NClass::GetEntityOf<On>(env, thisVar);
-    if (on == nullptr) {
-        HILOG_ERROR("Uitest::OnNExporter::Text Cannot get entity of on");
-        return nullptr;
-    }
     MatchPattern pattern = MatchPattern::EQUALS;
     if (funcArg.GetArgc() == NARG_CNT::TWO) {
         auto [succGetNum, number] = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
@@ -83,9 +497,11 @@ napi_value OnNExporter::Text(napi_env env, napi_callback_info info)
         }
         pattern = static_cast<MatchPattern>(number);
     }
-    on->Text(string(txt.get()), pattern);
     HILOG_DEBUG("Uitest::OnNExporter::Text end.");
-    return thisVar;
+    OnStep step { 0, CommonType::TEXT, static_cast<int32_t>(pattern), string(txt.get()) };
+    return DeriveOn(env, funcArg.GetThisVar(), move(step), [](On& on, const OnStep& step) {
+        on.Text(step.text, static_cast<MatchPattern>(step.value));
+    });
 }
 
 napi_value OnNExporter::Id(napi_env env, napi_callback_info info)
@@ -104,15 +520,9 @@ napi_value OnNExporter::Id(napi_env env, napi_callback_info info)
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
     }
-    napi_value thisVar = Instantiate(env, funcArg.GetThisVar());
-    auto on = NClass::GetEntityOf<On>(env, thisVar);
-    if (on == nullptr) {
-        HILOG_ERROR("Cannot get entity of on");
-        return nullptr;
-    }
-    on->Id(string(id.get()));
     HILOG_DEBUG("Uitest:: OnNExporter Id end.");
-    return thisVar;
+    OnStep step { 0, CommonType::ID, 0, string(id.get()) };
+    return DeriveOn(env, funcArg.GetThisVar(), move(step), [](On& on, const OnStep& step) { on.Id(step.text); });
 }
 
 napi_value OnNExporter::Type(napi_env env, napi_callback_info info)
@@ -132,56 +542,43 @@ napi_value OnNExporter::Type(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    napi_value thisVar = Instantiate(env, funcArg.GetThisVar());
-    auto on = NClass::GetEntityOf<On>(env, thisVar);
-    if (!on) {
-        HILOG_ERROR("Cannot get entity of Type");
-        return nullptr;
-    }
-    on->Type(string(type.get()));
     HILOG_DEBUG("Uitest:: OnNExporter Type end.");
-    return thisVar;
+    OnStep step { 0, CommonType::TYPE, 0, string(type.get()) };
+    return DeriveOn(env, funcArg.GetThisVar(), move(step), [](On& on, const OnStep& step) { on.Type(step.text); });
 }
 
-static napi_value ExecImpl(napi_env env, napi_value thisVar, int32_t type, bool b)
+static void ApplyCondition(On& on, int32_t type, bool b)
 {
-    HILOG_DEBUG("Uitest:: ExecImpl begin.");
-    thisVar = Instantiate(env, thisVar);
-    auto on = NClass::GetEntityOf<On>(env, thisVar);
-    if (on) {
-        HILOG_DEBUG("Uitest:: ExecImpl type: %{public}d", type);
-        switch (type) {
-            case CommonType::CLICKABLE:
-                on->Clickable(b);
-                break;
-            case CommonType::LONGCLICKABLE:
-                on->LongClickable(b);
-                break;
-            case CommonType::SCROLLABLE:
-                on->Scrollable(b);
-                break;
-            case CommonType::ENABLED:
-                on->Enabled(b);
-                break;
-            case CommonType::FOCUSED:
-                on->Focused(b);
-                break;
-            case CommonType::SELECTED:
-                on->Selected(b);
-                break;
-            case CommonType::CHECKED:
-                on->Checked(b);
-                break;
-            case CommonType::CHECKABLE:
-                on->Checkable(b);
-                break;
-            default:
-                HILOG_ERROR("Cannot read type of ExecImpl");
-                break;
-        }
+    HILOG_DEBUG("Uitest:: ApplyCondition type: %{public}d", type);
+    switch (type) {
+        case CommonType::CLICKABLE:
+            on.Clickable(b);
+            break;
+        case CommonType::LONGCLICKABLE:
+            on.LongClickable(b);
+            break;
+        case CommonType::SCROLLABLE:
+            on.Scrollable(b);
+            break;
+        case CommonType::ENABLED:
+            on.Enabled(b);
+            break;
+        case CommonType::FOCUSED:
+            on.Focused(b);
+            break;
+        case CommonType::SELECTED:
+            on.Selected(b);
+            break;
+        case CommonType::CHECKED:
+            on.Checked(b);
+            break;
+        case CommonType::CHECKABLE:
+            on.Checkable(b);
+            break;
+        default:
+            HILOG_ERROR("Cannot read type of ApplyCondition");
+            break;
     }
-    HILOG_DEBUG("Uitest:: ExecImpl end.");
-    return thisVar;
 }
 
 static napi_value OnTemplate(napi_env env, napi_callback_info info, int32_t type)
@@ -218,7 +615,10 @@ static napi_value OnTemplate(napi_env env, napi_callback_info info, int32_t type
         b_ = b;
     }
     HILOG_DEBUG("Uitest:: OnTemplate end.");
-    return ExecImpl(env, funcArg.GetThisVar(), type, b_);
+    OnStep step { 0, type, b_ ? 1 : 0, string() };
+    return DeriveOn(env, funcArg.GetThisVar(), move(step), [](On& on, const OnStep& step) {
+        ApplyCondition(on, step.type, step.value != 0);
+    });
 }
 
 napi_value OnNExporter::Clickable(napi_env env, napi_callback_info info)
@@ -261,6 +661,21 @@ napi_value OnNExporter::Checkable(napi_env env, napi_callback_info info)
     return OnTemplate(env, info, CommonType::CHECKABLE);
 }
 
+static void ApplyRelative(On& on, int32_t type, On* relativeOn)
+{
+    switch (type) {
+        case CommonType::ISBEFORE:
+            on.IsBefore(relativeOn);
+            break;
+        case CommonType::ISAFTER:
+            on.IsAfter(relativeOn);
+            break;
+        default:
+            on.WithIn(relativeOn);
+            break;
+    }
+}
+
 static napi_value RelativeOnTemplate(napi_env env, napi_callback_info info, int32_t type)
 {
     HILOG_DEBUG("Uitest:: RelativeOnTemplate begin.");
@@ -277,38 +692,15 @@ static napi_value RelativeOnTemplate(napi_env env, napi_callback_info info, int3
         return nullptr;
     }
 
-    napi_value thisVar = Instantiate(env, funcArg.GetThisVar());
-    auto on = NClass::GetEntityOf<On>(env, thisVar);
-    if (on == nullptr) {
-        HILOG_ERROR("Cannot get entity of on");
-        return nullptr;
-    }
-    switch (type)
-    {
-    case CommonType::ISBEFORE:
-        if (!on->IsBefore(relativeOn)) {
-            HILOG_ERROR("Cannot put attributions to on");
-            return nullptr;
-        }
-        break;
-    case CommonType::ISAFTER:
-        if (!on->IsAfter(relativeOn)) {
-            HILOG_ERROR("Cannot put attributions to on");
-            return nullptr;
-        }
-        break;
-    case CommonType::WITHIN:
-        if (!on->WithIn(relativeOn)) {
-            HILOG_ERROR("Cannot put attributions to on");
-            return nullptr;
-        }
-        break;
-    default:
+    if (type != CommonType::ISBEFORE && type != CommonType::ISAFTER && type != CommonType::WITHIN) {
         HILOG_ERROR("Cannot read type of RelativeOn");
-        break;
+        return nullptr;
     }
     HILOG_DEBUG("Uitest:: RelativeOnTemplate end.");
-    return thisVar;
+    // the relative On is part of the key by its node, one that is not interned cannot be looked up
+    OnStep step { 0, type, static_cast<int32_t>(relativeOn->internId), string() };
+    auto apply = [relativeOn](On& on, const OnStep& step) { ApplyRelative(on, step.type, relativeOn); };
+    return DeriveOn(env, funcArg.GetThisVar(), move(step), apply, relativeOn->internId != 0);
 }
 
 napi_value OnNExporter::IsBefore(napi_env env, napi_callback_info info)
@@ -331,12 +723,14 @@ static napi_value OnInitializer(napi_env env, napi_callback_info info)
     HILOG_DEBUG("OnInitializer begin");
     NFuncArg funcArg(env, info);
     if (!funcArg.InitArgs(NARG_CNT::ZERO)) {
-        HILOG_ERROR("On Number of arguments unmatched");
+        HILOG_ERROR("OnEvent Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
     }
 
     auto on_ = make_unique<On>();
+    // an empty On is the root of every interned chain
+    on_->internId = ON_ROOT_INTERN_ID;
     if (!NClass::SetEntityFor<On>(env, funcArg.GetThisVar(), move(on_))) {
         HILOG_ERROR("Failed to set On entity");
         NError(E_PARAMS).ThrowErr(env);
@@ -379,7 +773,7 @@ bool OnNExporter::Export()
         return false;
     }
     exports_.AddProp(OnNExporter::ON_CLASS_NAME, classValue);
-    napi_value On = NClass::InstantiateClass(exports_.env_, OnNExporter::ON_CLASS_NAME, {});
+    napi_value On = NClass::InstantiateClass(exports_.env_, ON_CLASS_ID, {});
     if (!On) {
         HILOG_ERROR("Failed to instantiate ON class");
         return false;
@@ -415,7 +809,7 @@ napi_value ComponentNExporter::Click(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("Click begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ZERO)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ZERO)) {
         HILOG_ERROR("Click Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -442,14 +836,15 @@ napi_value ComponentNExporter::Click(napi_env env, napi_callback_info info)
 
     NVal thisVar(env, funcArg.GetThisVar());
     string procedureName = "Click";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return NAsyncWorkOrdered(env, thisVar, PostTo(component->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
 napi_value ComponentNExporter::DoubleClick(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("DoubleClick begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ZERO)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ZERO)) {
         HILOG_ERROR("DoubleClick Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -476,14 +871,15 @@ napi_value ComponentNExporter::DoubleClick(napi_env env, napi_callback_info info
 
     NVal thisVar(env, funcArg.GetThisVar());
     string procedureName = "DoubleClick";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return NAsyncWorkOrdered(env, thisVar, PostTo(component->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
 napi_value ComponentNExporter::LongClick(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("LongClick begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ZERO)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ZERO)) {
         HILOG_ERROR("LongClick Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -510,14 +906,15 @@ napi_value ComponentNExporter::LongClick(napi_env env, napi_callback_info info)
 
     NVal thisVar(env, funcArg.GetThisVar());
     string procedureName = "LongClick";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return NAsyncWorkOrdered(env, thisVar, PostTo(component->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
 napi_value ComponentNExporter::GetId(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("GetId begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ZERO)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ZERO)) {
         HILOG_ERROR("GetId Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -530,31 +927,24 @@ napi_value ComponentNExporter::GetId(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    static string id = "";
-    auto cbExec = [component]() -> NError {
+    auto exec = [component](string& id) {
         id = component->GetId();
         HILOG_DEBUG("ComponentNExporter::GetId cbExec %{public}s", id.c_str());
-        return NError(ERRNO_NOERR);
     };
 
-    auto cbCompl = [](napi_env env, NError err) -> NVal {
-        if (err) {
-            return { env, err.GetNapiErr(env) };
-        }
+    auto toJs = [](napi_env env, const string& id) -> NVal {
         HILOG_DEBUG("ComponentNExporter::GetId cbCompl %{public}s", id.c_str());
         return NVal::CreateUTF8String(env, id);
     };
-
-    NVal thisVar(env, funcArg.GetThisVar());
-    string procedureName = "GetId";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return ScheduleWithResult<string>(env, funcArg, PostTo(component->GetExecutor(), PRIORITY_HIGH),
+        "GetId", exec, toJs);
 }
 
 napi_value ComponentNExporter::GetText(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("GetText begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ZERO)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ZERO)) {
         HILOG_ERROR("GetText Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -567,32 +957,24 @@ napi_value ComponentNExporter::GetText(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    static string text = "";
-    auto cbExec = [component]() -> NError {
+    auto exec = [component](string& text) {
         text = component->GetText();
         HILOG_DEBUG("ComponentNExporter::GetText 1 %{public}s", text.c_str());
-        return NError(ERRNO_NOERR);
     };
 
-    auto cbCompl = [](napi_env env, NError err) -> NVal {
-        if (err) {
-            return { env, err.GetNapiErr(env) };
-        }
+    auto toJs = [](napi_env env, const string& text) -> NVal {
         HILOG_DEBUG("ComponentNExporter::GetText 2 %{public}s", text.c_str());
-        NVal obj = NVal::CreateUTF8String(env, text);
-        return { obj };
+        return NVal::CreateUTF8String(env, text);
     };
-
-    NVal thisVar(env, funcArg.GetThisVar());
-    string procedureName = "GetText";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return ScheduleWithResult<string>(env, funcArg, PostTo(component->GetExecutor(), PRIORITY_HIGH),
+        "GetText", exec, toJs);
 }
 
 napi_value ComponentNExporter::GetType(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("GetType begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ZERO)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ZERO)) {
         HILOG_ERROR("GetType Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -605,24 +987,17 @@ napi_value ComponentNExporter::GetType(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    static string type = "";
-    auto cbExec = [component]() -> NError {
+    auto exec = [component](string& type) {
         type = component->GetType();
         HILOG_DEBUG("ComponentNExporter::GetType cbExec %{public}s", type.c_str());
-        return NError(ERRNO_NOERR);
     };
 
-    auto cbCompl = [](napi_env env, NError err) -> NVal {
-        if (err) {
-            return { env, err.GetNapiErr(env) };
-        }
+    auto toJs = [](napi_env env, const string& type) -> NVal {
         HILOG_DEBUG("ComponentNExporter::GetType cbCompl %{public}s", type.c_str());
         return NVal::CreateUTF8String(env, type);
     };
-
-    NVal thisVar(env, funcArg.GetThisVar());
-    string procedureName = "GetType";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return ScheduleWithResult<string>(env, funcArg, PostTo(component->GetExecutor(), PRIORITY_HIGH),
+        "GetType", exec, toJs);
 }
 
 static string ProcedureName(int32_t type)
@@ -650,47 +1025,47 @@ static string ProcedureName(int32_t type)
     HILOG_DEBUG("ProcedureName end");
 }
 
-static void ComponentImpl(shared_ptr<ArgsCls> args, Component* component, int32_t type)
+static bool ComponentImpl(Component* component, int32_t type)
 {
-    HILOG_DEBUG("ComponentImpl begin");
+    HILOG_DEBUG("ComponentImpl type: %{public}d", type);
+    unique_ptr<bool> value;
     switch (type) {
-        HILOG_DEBUG("ComponentImpl type: %{public}d", type);
         case CommonType::CLICKABLE:
-            args->isCommonBool = move(component->IsClickable());
+            value = component->IsClickable();
             break;
         case CommonType::LONGCLICKABLE:
-            args->isCommonBool = move(component->IsLongClickable());
+            value = component->IsLongClickable();
             break;
         case CommonType::SCROLLABLE:
-            args->isCommonBool = move(component->IsScrollable());
+            value = component->IsScrollable();
             break;
         case CommonType::ENABLED:
-            args->isCommonBool = move(component->IsEnabled());
+            value = component->IsEnabled();
             break;
         case CommonType::FOCUSED:
-            args->isCommonBool = move(component->IsFocused());
+            value = component->IsFocused();
             break;
         case CommonType::SELECTED:
-            args->isCommonBool = move(component->IsSelected());
+            value = component->IsSelected();
             break;
         case CommonType::CHECKED:
-            args->isCommonBool = move(component->IsChecked());
+            value = component->IsChecked();
             break;
         case CommonType::CHECKABLE:
-            args->isCommonBool = move(component->IsCheckable());
+            value = component->IsCheckable();
             break;
         default:
             HILOG_ERROR("Cannot read type of ComponentImpl");
             break;
     }
-    HILOG_DEBUG("ComponentImpl end");
+    return value != nullptr && *value;
 }
 
 static napi_value ComponentTemplate(napi_env env, napi_callback_info info, int32_t type)
 {
     HILOG_DEBUG("ComponentTemplate begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ZERO)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ZERO)) {
         HILOG_ERROR("ComponentTemplate Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -703,23 +1078,15 @@ static napi_value ComponentTemplate(napi_env env, napi_callback_info info, int32
         return nullptr;
     }
 
-    auto args = std::make_shared<ArgsCls>();
-    auto cbExec = [args, component, tp = type]() -> NError {
-        ComponentImpl(args, component, tp);
-        return NError(ERRNO_NOERR);
-    };
+    auto exec = [component, type](bool& value) { value = ComponentImpl(component, type); };
 
-    auto cbCompl = [args](napi_env env, NError err) -> NVal {
-        if (err) {
-            return { env, err.GetNapiErr(env) };
-        }
-        HILOG_DEBUG("ComponentTemplate res: %{public}d", *(args->isCommonBool));
-        return NVal::CreateBool(env, *(args->isCommonBool));
+    auto toJs = [](napi_env env, bool value) -> NVal {
+        HILOG_DEBUG("ComponentTemplate res: %{public}d", value);
+        return NVal::CreateBool(env, value);
     };
-
-    NVal thisVar(env, funcArg.GetThisVar());
     HILOG_DEBUG("ComponentTemplate end");
-    return NAsyncWorkPromise(env, thisVar).Schedule(ProcedureName(type), cbExec, cbCompl).val_;
+    return ScheduleWithResult<bool>(env, funcArg, PostTo(component->GetExecutor(), PRIORITY_HIGH),
+        ProcedureName(type), exec, toJs);
 }
 
 napi_value ComponentNExporter::IsClickable(napi_env env, napi_callback_info info)
@@ -766,7 +1133,7 @@ napi_value ComponentNExporter::InputText(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("InputText begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ONE)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ONE, NARG_CNT::TWO)) {
         HILOG_ERROR("InputText Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -786,8 +1153,28 @@ napi_value ComponentNExporter::InputText(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    auto cbExec = [component, text = string(text.get())]() -> NError {
-        component->InputText(text);
+    // InputTextMode: { paste?: boolean }, the text is committed at once by default
+    bool paste = true;
+    if (funcArg.GetArgc() == NARG_CNT::TWO) {
+        NVal mode(env, funcArg[NARG_POS::SECOND]);
+        if (!mode.TypeIs(napi_object)) {
+            HILOG_ERROR("InputText get mode parameter failed!");
+            NError(E_PARAMS).ThrowErr(env);
+            return nullptr;
+        }
+        if (mode.HasProp("paste")) {
+            auto [succGetPaste, isPaste] = mode.GetProp("paste").ToBool();
+            if (!succGetPaste) {
+                HILOG_ERROR("InputText get paste parameter failed!");
+                NError(E_PARAMS).ThrowErr(env);
+                return nullptr;
+            }
+            paste = isPaste;
+        }
+    }
+
+    auto cbExec = [component, text = string(text.get()), paste]() -> NError {
+        component->InputText(text, paste);
         return NError(ERRNO_NOERR);
     };
 
@@ -800,14 +1187,15 @@ napi_value ComponentNExporter::InputText(napi_env env, napi_callback_info info)
 
     NVal thisVar(env, funcArg.GetThisVar());
     string procedureName = "InputText";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return NAsyncWorkOrdered(env, thisVar, PostTo(component->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
 napi_value ComponentNExporter::ClearText(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("ClearText begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ZERO)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ZERO)) {
         HILOG_ERROR("ClearText Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -834,14 +1222,15 @@ napi_value ComponentNExporter::ClearText(napi_env env, napi_callback_info info)
 
     NVal thisVar(env, funcArg.GetThisVar());
     string procedureName = "ClearText";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return NAsyncWorkOrdered(env, thisVar, PostTo(component->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
 napi_value ComponentNExporter::ScrollToTop(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("ScrollToTop begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ZERO, NARG_CNT::ONE)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ZERO, NARG_CNT::ONE)) {
         HILOG_ERROR("ScrollToTop Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -878,14 +1267,15 @@ napi_value ComponentNExporter::ScrollToTop(napi_env env, napi_callback_info info
 
     NVal thisVar(env, funcArg.GetThisVar());
     string procedureName = "ScrollToTop";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return NAsyncWorkOrdered(env, thisVar, PostTo(component->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
 napi_value ComponentNExporter::ScrollToBottom(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("ScrollToBottom begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ZERO, NARG_CNT::ONE)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ZERO, NARG_CNT::ONE)) {
         HILOG_ERROR("ScrollToBottom Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -922,14 +1312,15 @@ napi_value ComponentNExporter::ScrollToBottom(napi_env env, napi_callback_info i
 
     NVal thisVar(env, funcArg.GetThisVar());
     string procedureName = "ScrollToBottom";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return NAsyncWorkOrdered(env, thisVar, PostTo(component->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
 napi_value ComponentNExporter::ScrollSearch(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("ScrollSearch begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ONE)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ONE)) {
         HILOG_ERROR("ScrollSearch Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -948,13 +1339,13 @@ napi_value ComponentNExporter::ScrollSearch(napi_env env, napi_callback_info inf
         return nullptr;
     }
 
-    napi_value jsComponent = NClass::InstantiateClass(env, ComponentNExporter::COMPONENT_CLASS_NAME, {});
+    napi_value jsComponent = NClass::InstantiateClass(env, COMPONENT_CLASS_ID, {});
     if (!jsComponent) {
         HILOG_ERROR("Failed to instantiate jsComponent class");
         return nullptr;
     }
-    napi_ref ref = nullptr;
-    napi_create_reference(env, jsComponent, 1, &ref);
+    // held by the complete callback, released with the call even when that callback never runs
+    auto ref = make_shared<NRef>(NVal(env, jsComponent));
 
     auto arg = make_shared<ArgsCls>();
     auto cbExec = [component, on, arg]() -> NError {
@@ -962,7 +1353,7 @@ napi_value ComponentNExporter::ScrollSearch(napi_env env, napi_callback_info inf
         return NError(ERRNO_NOERR);
     };
 
-    auto cbCompl = [ref, arg](napi_env env, NError err) -> NVal {
+    auto cbCompl = [ref, arg, executor = component->GetExecutor()](napi_env env, NError err) -> NVal {
         if (err) {
             return { env, err.GetNapiErr(env) };
         }
@@ -970,8 +1361,8 @@ napi_value ComponentNExporter::ScrollSearch(napi_env env, napi_callback_info inf
             HILOG_ERROR("Failed to component is nullptr.");
             return NVal::CreateUndefined(env);
         }
-        napi_value jsComponent_ = nullptr;
-        napi_get_reference_value(env, ref, &jsComponent_);
+        arg->component->SetExecutor(executor);
+        napi_value jsComponent_ = ref->Deref(env).val_;
         if (!NClass::SetEntityFor<Component>(env, jsComponent_, move(arg->component))) {
             HILOG_ERROR("Failed to set Component entity");
             return { env, NError(E_PARAMS).GetNapiErr(env) };
@@ -982,14 +1373,33 @@ napi_value ComponentNExporter::ScrollSearch(napi_env env, napi_callback_info inf
 
     NVal thisVar(env, funcArg.GetThisVar());
     string procedureName = "ScrollSearch";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return NAsyncWorkOrdered(env, thisVar, PostTo(component->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
+}
+
+static NVal CreateJsPoint(napi_env env, const Point& point)
+{
+    NVal obj = NVal::CreateObject(env);
+    obj.AddProp("x", NVal::CreateInt32(env, point.x).val_);
+    obj.AddProp("y", NVal::CreateInt32(env, point.y).val_);
+    return obj;
+}
+
+static NVal CreateJsRect(napi_env env, const Rect& rect)
+{
+    NVal obj = NVal::CreateObject(env);
+    obj.AddProp("left", NVal::CreateInt32(env, rect.left).val_);
+    obj.AddProp("top", NVal::CreateInt32(env, rect.top).val_);
+    obj.AddProp("right", NVal::CreateInt32(env, rect.right).val_);
+    obj.AddProp("bottom", NVal::CreateInt32(env, rect.bottom).val_);
+    return obj;
 }
 
 napi_value ComponentNExporter::GetBoundsCenter(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("GetBoundsCenter begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ZERO)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ZERO)) {
         HILOG_ERROR("GetBoundsCenter Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -1002,34 +1412,24 @@ napi_value ComponentNExporter::GetBoundsCenter(napi_env env, napi_callback_info
         return nullptr;
     }
 
-    static Point point;
-    auto cbExec = [component]() -> NError {
+    auto exec = [component](Point& point) {
         point = component->GetBoundsCenter();
         HILOG_DEBUG("ComponentNExporter::GetBoundsCenter cbExec [%{public}d, %{public}d]", point.x, point.y);
-        return NError(ERRNO_NOERR);
     };
 
-    auto cbCompl = [](napi_env env, NError err) -> NVal {
-        if (err) {
-            return { env, err.GetNapiErr(env) };
-        }
-        NVal obj = NVal::CreateObject(env);
-        obj.AddProp("x", NVal::CreateInt32(env, point.x).val_);
-        obj.AddProp("y", NVal::CreateInt32(env, point.y).val_);
+    auto toJs = [](napi_env env, const Point& point) -> NVal {
         HILOG_DEBUG("ComponentNExporter::GetBoundsCenter cbCompl [%{public}d, %{public}d]", point.x, point.y);
-        return { obj };
+        return CreateJsPoint(env, point);
     };
-
-    NVal thisVar(env, funcArg.GetThisVar());
-    string procedureName = "GetBoundsCenter";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return ScheduleWithResult<Point>(env, funcArg, PostTo(component->GetExecutor(), PRIORITY_HIGH),
+        "GetBoundsCenter", exec, toJs);
 }
 
 napi_value ComponentNExporter::GetBounds(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("GetBounds begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ZERO)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ZERO)) {
         HILOG_ERROR("GetBounds Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -1042,36 +1442,288 @@ napi_value ComponentNExporter::GetBounds(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    static Rect rect;
-    auto cbExec = [component]() -> NError {
+    auto exec = [component](Rect& rect) {
         rect = component->GetBounds();
-        return NError(ERRNO_NOERR);
+    };
+
+    auto toJs = [](napi_env env, const Rect& rect) -> NVal {
+        HILOG_DEBUG("ComponentNExporter::GetBounds %{public}d, %{public}d, %{public}d, %{public}d",
+            rect.left, rect.top, rect.right, rect.bottom);
+        return CreateJsRect(env, rect);
+    };
+    return ScheduleWithResult<Rect>(env, funcArg, PostTo(component->GetExecutor(), PRIORITY_HIGH),
+        "GetBounds", exec, toJs);
+}
+
+/**
+ * The *Sync getters and the attributes getter read the cached info directly on the js thread,
+ * no async work is created. They return what the last find/refresh saw, like their async variants.
+ **/
+static bool GetSyncAttributes(napi_env env, napi_callback_info info, const char* name,
+    ComponentAttributes& attributes)
+{
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgs(NARG_CNT::ZERO)) {
+        HILOG_ERROR("%{public}s Number of arguments unmatched", name);
+        NError(E_PARAMS).ThrowErr(env);
+        return false;
+    }
+    auto component = NClass::GetEntityOf<Component>(env, funcArg.GetThisVar());
+    if (!component) {
+        HILOG_ERROR("Cannot get entity of component");
+        NError(E_DESTROYED).ThrowErr(env);
+        return false;
+    }
+    attributes = component->GetAttributes();
+    return true;
+}
+
+static napi_value ComponentSyncString(napi_env env, napi_callback_info info, int32_t type)
+{
+    ComponentAttributes attributes;
+    if (!GetSyncAttributes(env, info, "ComponentSyncString", attributes)) {
+        return nullptr;
+    }
+    switch (type) {
+        case CommonType::ID:
+            return NVal::CreateUTF8String(env, attributes.id).val_;
+        case CommonType::TEXT:
+            return NVal::CreateUTF8String(env, attributes.text).val_;
+        case CommonType::TYPE:
+            return NVal::CreateUTF8String(env, attributes.type).val_;
+        default:
+            HILOG_ERROR("Cannot read type of ComponentSyncString");
+            return nullptr;
+    }
+}
+
+static bool GetAttributeBool(const ComponentAttributes& attributes, int32_t type)
+{
+    switch (type) {
+        case CommonType::CLICKABLE:
+            return attributes.clickable;
+        case CommonType::LONGCLICKABLE:
+            return attributes.longClickable;
+        case CommonType::SCROLLABLE:
+            return attributes.scrollable;
+        case CommonType::ENABLED:
+            return attributes.enabled;
+        case CommonType::FOCUSED:
+            return attributes.focused;
+        case CommonType::SELECTED:
+            return attributes.selected;
+        case CommonType::CHECKED:
+            return attributes.checked;
+        case CommonType::CHECKABLE:
+            return attributes.checkable;
+        default:
+            HILOG_ERROR("Cannot read type of GetAttributeBool");
+            return false;
+    }
+}
+
+static napi_value ComponentSyncBool(napi_env env, napi_callback_info info, int32_t type)
+{
+    ComponentAttributes attributes;
+    if (!GetSyncAttributes(env, info, "ComponentSyncBool", attributes)) {
+        return nullptr;
+    }
+    return NVal::CreateBool(env, GetAttributeBool(attributes, type)).val_;
+}
+
+napi_value ComponentNExporter::GetIdSync(napi_env env, napi_callback_info info)
+{
+    return ComponentSyncString(env, info, CommonType::ID);
+}
+
+napi_value ComponentNExporter::GetTextSync(napi_env env, napi_callback_info info)
+{
+    return ComponentSyncString(env, info, CommonType::TEXT);
+}
+
+napi_value ComponentNExporter::GetTypeSync(napi_env env, napi_callback_info info)
+{
+    return ComponentSyncString(env, info, CommonType::TYPE);
+}
+
+napi_value ComponentNExporter::IsClickableSync(napi_env env, napi_callback_info info)
+{
+    return ComponentSyncBool(env, info, CommonType::CLICKABLE);
+}
+
+napi_value ComponentNExporter::IsLongClickableSync(napi_env env, napi_callback_info info)
+{
+    return ComponentSyncBool(env, info, CommonType::LONGCLICKABLE);
+}
+
+napi_value ComponentNExporter::IsScrollableSync(napi_env env, napi_callback_info info)
+{
+    return ComponentSyncBool(env, info, CommonType::SCROLLABLE);
+}
+
+napi_value ComponentNExporter::IsEnabledSync(napi_env env, napi_callback_info info)
+{
+    return ComponentSyncBool(env, info, CommonType::ENABLED);
+}
+
+napi_value ComponentNExporter::IsFocusedSync(napi_env env, napi_callback_info info)
+{
+    return ComponentSyncBool(env, info, CommonType::FOCUSED);
+}
+
+napi_value ComponentNExporter::IsSelectedSync(napi_env env, napi_callback_info info)
+{
+    return ComponentSyncBool(env, info, CommonType::SELECTED);
+}
+
+napi_value ComponentNExporter::IsCheckedSync(napi_env env, napi_callback_info info)
+{
+    return ComponentSyncBool(env, info, CommonType::CHECKED);
+}
+
+napi_value ComponentNExporter::IsCheckableSync(napi_env env, napi_callback_info info)
+{
+    return ComponentSyncBool(env, info, CommonType::CHECKABLE);
+}
+
+napi_value ComponentNExporter::GetBoundsSync(napi_env env, napi_callback_info info)
+{
+    ComponentAttributes attributes;
+    if (!GetSyncAttributes(env, info, "GetBoundsSync", attributes)) {
+        return nullptr;
+    }
+    return CreateJsRect(env, attributes.bounds).val_;
+}
+
+napi_value ComponentNExporter::GetBoundsCenterSync(napi_env env, napi_callback_info info)
+{
+    ComponentAttributes attributes;
+    if (!GetSyncAttributes(env, info, "GetBoundsCenterSync", attributes)) {
+        return nullptr;
+    }
+    return CreateJsPoint(env, attributes.center).val_;
+}
+
+napi_value ComponentNExporter::Attributes(napi_env env, napi_callback_info info)
+{
+    ComponentAttributes attributes;
+    if (!GetSyncAttributes(env, info, "Attributes", attributes)) {
+        return nullptr;
+    }
+    NVal obj = NVal::CreateObject(env);
+    obj.AddProp("id", NVal::CreateUTF8String(env, attributes.id).val_);
+    obj.AddProp("text", NVal::CreateUTF8String(env, attributes.text).val_);
+    obj.AddProp("type", NVal::CreateUTF8String(env, attributes.type).val_);
+    obj.AddProp("bounds", CreateJsRect(env, attributes.bounds).val_);
+    obj.AddProp("boundsCenter", CreateJsPoint(env, attributes.center).val_);
+    obj.AddProp("clickable", NVal::CreateBool(env, attributes.clickable).val_);
+    obj.AddProp("longClickable", NVal::CreateBool(env, attributes.longClickable).val_);
+    obj.AddProp("scrollable", NVal::CreateBool(env, attributes.scrollable).val_);
+    obj.AddProp("enabled", NVal::CreateBool(env, attributes.enabled).val_);
+    obj.AddProp("focused", NVal::CreateBool(env, attributes.focused).val_);
+    obj.AddProp("selected", NVal::CreateBool(env, attributes.selected).val_);
+    obj.AddProp("checked", NVal::CreateBool(env, attributes.checked).val_);
+    obj.AddProp("checkable", NVal::CreateBool(env, attributes.checkable).val_);
+    return obj.val_;
+}
+
+napi_value ComponentNExporter::Rotate(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("Component Rotate begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ONE)) {
+        HILOG_ERROR("Rotate Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto [succ, degrees] = NVal(env, funcArg[NARG_POS::FIRST]).ToDouble();
+    if (!succ) {
+        HILOG_ERROR("Get Rotate parameter failed!");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto component = NClass::GetEntityOf<Component>(env, funcArg.GetThisVar());
+    if (!component) {
+        HILOG_ERROR("Cannot get entity of component");
+        NError(E_DESTROYED).ThrowErr(env);
+        return nullptr;
+    }
+    auto cbExec = [component, degrees_ = static_cast<float>(degrees)]() -> NError {
+        component->Rotate(degrees_);
+        return NError(ERRNO_NOERR);
     };
 
     auto cbCompl = [](napi_env env, NError err) -> NVal {
         if (err) {
             return { env, err.GetNapiErr(env) };
         }
-        NVal obj = NVal::CreateObject(env);
-        obj.AddProp("left", NVal::CreateInt32(env, rect.left).val_);
-        obj.AddProp("top", NVal::CreateInt32(env, rect.top).val_);
-        obj.AddProp("right", NVal::CreateInt32(env, rect.right).val_);
-        obj.AddProp("bottom", NVal::CreateInt32(env, rect.bottom).val_);
-        HILOG_DEBUG("ComponentNExporter::GetBounds %{public}d, %{public}d, %{public}d, %{public}d",
-            rect.left, rect.top, rect.right, rect.bottom);
-        return { obj };
+        return NVal::CreateUndefined(env);
+    };
+
+    NVal thisVar(env, funcArg.GetThisVar());
+    string procedureName = "Rotate";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(component->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
+}
+
+napi_value ComponentNExporter::Pinch(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("Component Pinch begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ONE, NARG_CNT::TWO)) {
+        HILOG_ERROR("Pinch Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto [succ, scale] = NVal(env, funcArg[NARG_POS::FIRST]).ToDouble();
+    if (!succ) {
+        HILOG_ERROR("Get Pinch scale failed!");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    double angle = DEFAULT_PINCH_ANGLE;
+    if (funcArg.GetArgc() == NARG_CNT::TWO) {
+        auto [succAngle, number] = NVal(env, funcArg[NARG_POS::SECOND]).ToDouble();
+        if (!succAngle) {
+            HILOG_ERROR("Get Pinch angle failed!");
+            NError(E_PARAMS).ThrowErr(env);
+            return nullptr;
+        }
+        angle = number;
+    }
+
+    auto component = NClass::GetEntityOf<Component>(env, funcArg.GetThisVar());
+    if (!component) {
+        HILOG_ERROR("Cannot get entity of component");
+        NError(E_DESTROYED).ThrowErr(env);
+        return nullptr;
+    }
+    auto cbExec = [component, scale_ = static_cast<float>(scale), angle_ = static_cast<float>(angle)]() -> NError {
+        component->Pinch(scale_, angle_);
+        return NError(ERRNO_NOERR);
+    };
+
+    auto cbCompl = [](napi_env env, NError err) -> NVal {
+        if (err) {
+            return { env, err.GetNapiErr(env) };
+        }
+        return NVal::CreateUndefined(env);
     };
 
     NVal thisVar(env, funcArg.GetThisVar());
-    string procedureName = "GetBounds";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    string procedureName = "Pinch";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(component->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
 napi_value ComponentNExporter::PinchOut(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("GetBounds PinchOut");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ONE)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ONE)) {
         HILOG_ERROR("GetBounds Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -1105,14 +1757,15 @@ napi_value ComponentNExporter::PinchOut(napi_env env, napi_callback_info info)
 
     NVal thisVar(env, funcArg.GetThisVar());
     string procedureName = "PinchOut";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return NAsyncWorkOrdered(env, thisVar, PostTo(component->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
 napi_value ComponentNExporter::PinchIn(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("GetBounds PinchIn");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ONE)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ONE)) {
         HILOG_ERROR("GetBounds Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -1146,7 +1799,8 @@ napi_value ComponentNExporter::PinchIn(napi_env env, napi_callback_info info)
 
     NVal thisVar(env, funcArg.GetThisVar());
     string procedureName = "PinchIn";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return NAsyncWorkOrdered(env, thisVar, PostTo(component->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
 bool ComponentNExporter::Export()
@@ -1176,6 +1830,25 @@ bool ComponentNExporter::Export()
         NVal::DeclareNapiFunction(ComponentNExporter::FUNCTION_GET_BOUNDS, ComponentNExporter::GetBounds),
         NVal::DeclareNapiFunction(ComponentNExporter::FUNCTION_PINCH_OUT, ComponentNExporter::PinchOut),
         NVal::DeclareNapiFunction(ComponentNExporter::FUNCTION_PINCH_IN, ComponentNExporter::PinchIn),
+        NVal::DeclareNapiFunction(ComponentNExporter::FUNCTION_ROTATE, ComponentNExporter::Rotate),
+        NVal::DeclareNapiFunction(ComponentNExporter::FUNCTION_PINCH, ComponentNExporter::Pinch),
+        NVal::DeclareNapiFunction(ComponentNExporter::FUNCTION_GET_ID_SYNC, ComponentNExporter::GetIdSync),
+        NVal::DeclareNapiFunction(ComponentNExporter::FUNCTION_GET_TEXT_SYNC, ComponentNExporter::GetTextSync),
+        NVal::DeclareNapiFunction(ComponentNExporter::FUNCTION_GET_TYPE_SYNC, ComponentNExporter::GetTypeSync),
+        NVal::DeclareNapiFunction(ComponentNExporter::FUNCTION_IS_CLICKABLE_SYNC, ComponentNExporter::IsClickableSync),
+        NVal::DeclareNapiFunction(ComponentNExporter::FUNCTION_IS_LONG_CLICKABLE_SYNC,
+            ComponentNExporter::IsLongClickableSync),
+        NVal::DeclareNapiFunction(ComponentNExporter::FUNCTION_IS_SCROLLABLE_SYNC,
+            ComponentNExporter::IsScrollableSync),
+        NVal::DeclareNapiFunction(ComponentNExporter::FUNCTION_IS_ENABLED_SYNC, ComponentNExporter::IsEnabledSync),
+        NVal::DeclareNapiFunction(ComponentNExporter::FUNCTION_IS_FOCUSED_SYNC, ComponentNExporter::IsFocusedSync),
+        NVal::DeclareNapiFunction(ComponentNExporter::FUNCTION_IS_SELECTED_SYNC, ComponentNExporter::IsSelectedSync),
+        NVal::DeclareNapiFunction(ComponentNExporter::FUNCTION_IS_CHECKED_SYNC, ComponentNExporter::IsCheckedSync),
+        NVal::DeclareNapiFunction(ComponentNExporter::FUNCTION_IS_CHECKABLE_SYNC, ComponentNExporter::IsCheckableSync),
+        NVal::DeclareNapiFunction(ComponentNExporter::FUNCTION_GET_BOUNDS_SYNC, ComponentNExporter::GetBoundsSync),
+        NVal::DeclareNapiFunction(ComponentNExporter::FUNCTION_GET_BOUNDS_CENTER_SYNC,
+            ComponentNExporter::GetBoundsCenterSync),
+        NVal::DeclareNapiGetter(ComponentNExporter::PROPERTY_ATTRIBUTES, ComponentNExporter::Attributes),
     };
     auto [succ, classValue] = NClass::DefineClass(exports_.env_, ComponentNExporter::COMPONENT_CLASS_NAME,
         ComponentInitializer, std::move(props));
@@ -1214,7 +1887,7 @@ napi_value DriverNExporter::CreateDriver(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    napi_value thisVar = NClass::InstantiateClass(env, DriverNExporter::DRIVER_CLASS_NAME, {});
+    napi_value thisVar = NClass::InstantiateClass(env, DRIVER_CLASS_ID, {});
     if (thisVar == nullptr) {
         HILOG_ERROR("CreateDriver failed to initialize.");
         NError(E_INITIALIZE).ThrowErr(env);
@@ -1229,7 +1902,7 @@ napi_value DriverNExporter::DelayMs(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("DelayMs begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ONE)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ONE)) {
         HILOG_ERROR("DelayMs Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -1263,14 +1936,15 @@ napi_value DriverNExporter::DelayMs(napi_env env, napi_callback_info info)
 
     NVal thisVar(env, funcArg.GetThisVar());
     string procedureName = "DelayMs";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
 napi_value DriverNExporter::PressBack(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("PressBack begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ZERO)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ZERO)) {
         HILOG_ERROR("PressBack Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -1297,14 +1971,15 @@ napi_value DriverNExporter::PressBack(napi_env env, napi_callback_info info)
 
     NVal thisVar(env, funcArg.GetThisVar());
     string procedureName = "PressBack";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
 napi_value DriverNExporter::AssertComponentExist(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("AssertComponentExist begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ONE)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ONE)) {
         HILOG_ERROR("AssertComponentExist Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -1340,7 +2015,8 @@ napi_value DriverNExporter::AssertComponentExist(napi_env env, napi_callback_inf
 
     NVal thisVar(env, funcArg.GetThisVar());
     string procedureName = "AssertComponentExist";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
 static bool GetArg(napi_env env, napi_value thisValue, int number, shared_ptr<ArgsInfo> argsInfo)
@@ -1378,17 +2054,66 @@ static bool GetArgs(napi_env env, NFuncArg &funcArg, shared_ptr<ArgsInfo> argsIn
     retThird = GetArg(env, funcArg[NARG_POS::THIRD], NARG_POS::THIRD, argsInfo);
     retFourth = GetArg(env, funcArg[NARG_POS::FOURTH], NARG_POS::FOURTH, argsInfo);
 
-    if (funcArg.GetArgc() == NARG_CNT::FIVE) {
+    if (funcArg.GetArgc() >= NARG_CNT::FIVE) {
         retFifth = GetArg(env, funcArg[NARG_POS::FIFTH], NARG_POS::FIFTH, argsInfo);
     }
     return retFirst && retSecond && retThird && retFourth && retFifth;
 }
 
+napi_value DriverNExporter::TriggerKeys(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("DriverNExporter::TriggerKeys begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ONE)) {
+        HILOG_ERROR("DriverNExporter::TriggerKeys Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
+    if (!driver) {
+        HILOG_ERROR("Cannot get entity of driver");
+        return nullptr;
+    }
+
+    auto [succ, script, ignore] = NVal(env, funcArg[NARG_POS::FIRST]).ToUTF8String();
+    if (!succ) {
+        HILOG_ERROR("Invalid script");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    // compile on the js thread, so a bad script is reported to the caller directly
+    auto strokes = make_shared<vector<KeyStroke>>();
+    string err;
+    if (!KeyScript::Compile(script.get(), *strokes, err)) {
+        HILOG_ERROR("TriggerKeys %{public}s", err.c_str());
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto cbExec = [driver, strokes]() -> NError {
+        driver->TriggerKeyStrokes(*strokes);
+        return NError(ERRNO_NOERR);
+    };
+
+    auto cbCompl = [](napi_env env, NError err) -> NVal {
+        if (err) {
+            return { env, err.GetNapiErr(env) };
+        }
+        return NVal::CreateUndefined(env);
+    };
+
+    NVal thisVar(env, funcArg.GetThisVar());
+    string procedureName = "TriggerKeys";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
+}
+
 napi_value DriverNExporter::InjectMultiPointerAction(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("DriverNExporter::InjectMultiPointerAction begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ONE, NARG_CNT::TWO)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ONE, NARG_CNT::TWO)) {
         HILOG_ERROR("DriverNExporter::InjectMultiPointerAction Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -1415,29 +2140,22 @@ napi_value DriverNExporter::InjectMultiPointerAction(napi_env env, napi_callback
         }
         speed = number;
     }
-    static bool ret = false;
-    auto cbExec = [driver, poMatrix, sp = speed]() -> NError {
+    auto exec = [driver, poMatrix, sp = speed](bool& ret) {
         ret = driver->InjectMultiPointerAction(*poMatrix, sp);
-        return NError(ERRNO_NOERR);
     };
 
-    auto cbCompl = [](napi_env env, NError err) -> NVal {
-        if (err) {
-            return { env, err.GetNapiErr(env) };
-        }
+    auto toJs = [](napi_env env, bool ret) -> NVal {
         return NVal::CreateBool(env, ret);
     };
-
-    NVal thisVar(env, funcArg.GetThisVar());
-    string procedureName = "InjectMultiPointerAction";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return ScheduleWithResult<bool>(env, funcArg, PostTo(driver->GetExecutor()),
+        "InjectMultiPointerAction", exec, toJs);
 }
 
 napi_value DriverNExporter::TriggerCombineKeys(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("DriverNExporter::TriggerCombineKeys begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::TWO, NARG_CNT::THREE)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::TWO, NARG_CNT::THREE)) {
         HILOG_ERROR("DriverNExporter::TriggerCombineKeys Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -1464,7 +2182,7 @@ napi_value DriverNExporter::TriggerCombineKeys(napi_env env, napi_callback_info
     }
     int key3 = -1;
     if (funcArg.GetArgc() == NARG_CNT::THREE) {
-        auto [resGetThirdArg, number] = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
+        auto [resGetThirdArg, number] = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
         if (!resGetThirdArg) {
             HILOG_ERROR("Invalid key3");
             NError(E_PARAMS).ThrowErr(env);
@@ -1487,14 +2205,15 @@ napi_value DriverNExporter::TriggerCombineKeys(napi_env env, napi_callback_info
 
     NVal thisVar(env, funcArg.GetThisVar());
     string procedureName = "TriggerCombineKeys";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
 napi_value DriverNExporter::TriggerKey(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("DriverNExporter::TriggerKey begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ONE)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ONE)) {
         HILOG_ERROR("DriverNExporter::TriggerKey Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -1528,14 +2247,15 @@ napi_value DriverNExporter::TriggerKey(napi_env env, napi_callback_info info)
 
     NVal thisVar(env, funcArg.GetThisVar());
     string procedureName = "TriggerKey";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
 napi_value DriverNExporter::Swipe(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("Swipe begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::FOUR, NARG_CNT::FIVE)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::FOUR, NARG_CNT::FIVE)) {
         HILOG_ERROR("Swipe Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -1569,14 +2289,15 @@ napi_value DriverNExporter::Swipe(napi_env env, napi_callback_info info)
 
     NVal thisVar(env, funcArg.GetThisVar());
     string procedureName = "Swipe";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
 static napi_value DirectFling(napi_env env, napi_callback_info info)
 {
     HILOG_DEBUG("Uitest:: DirectFling begin.");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::TWO)) {
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::TWO)) {
         HILOG_ERROR("Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
@@ -1618,59 +2339,53 @@ static napi_value DirectFling(napi_env env, napi_callback_info info)
 
     NVal thisVar(env, funcArg.GetThisVar());
     string procedureName = "Fling";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
-napi_value DriverNExporter::Fling(napi_env env, napi_callback_info info)
+napi_value DriverNExporter::MultiSwipe(napi_env env, napi_callback_info info)
 {
-    HILOG_DEBUG("Fling begin");
+    HILOG_DEBUG("MultiSwipe begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::FOUR) && !funcArg.InitArgs(NARG_CNT::TWO)) {
-        HILOG_ERROR("Fling Number of arguments unmatched");
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::TWO, NARG_CNT::THREE)) {
+        HILOG_ERROR("MultiSwipe Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
     }
 
-    if (funcArg.GetArgc() == NARG_CNT::TWO) {
-        return DirectFling(env, info);
-    }
-
     auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
     if (!driver) {
         HILOG_ERROR("Cannot get entity of driver");
         return nullptr;
     }
 
-    NVal objFrom(env, funcArg[NARG_POS::FIRST]);
-    if (!objFrom.TypeIs(napi_object)) {
-        HILOG_ERROR("Invalid objFrom");
-        return nullptr;
-    }
-    Point ptFrom = { std::get<1>(objFrom.GetProp("x").ToInt32()), std::get<1>(objFrom.GetProp("y").ToInt32()) };
-
-    NVal objTo(env, funcArg[NARG_POS::SECOND]);
-    if (!objTo.TypeIs(napi_object)) {
-        HILOG_ERROR("Invalid objTo");
+    auto [resGetFirstArg, fingers] = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
+    if (!resGetFirstArg || fingers <= 0 || fingers > MAX_FINGERS) {
+        HILOG_ERROR("Invalid fingers");
+        NError(E_PARAMS).ThrowErr(env);
         return nullptr;
     }
-    Point ptTo = { std::get<1>(objTo.GetProp("x").ToInt32()), std::get<1>(objTo.GetProp("y").ToInt32()) };
 
-    auto [resGetFirstArg, stepLen] = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
-    if (!resGetFirstArg) {
-        HILOG_ERROR("Invalid x");
+    auto [resGetSecondArg, direct] = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
+    if (!resGetSecondArg || direct < UiDirection::LEFT || direct > UiDirection::DOWN) {
+        HILOG_ERROR("Invalid direction");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
     }
 
-    auto [resGetSecondArg, speed] = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt32();
-    if (!resGetSecondArg) {
-        HILOG_ERROR("Invalid y");
-        NError(E_PARAMS).ThrowErr(env);
-        return nullptr;
+    int32_t speed = 0;
+    if (funcArg.GetArgc() == NARG_CNT::THREE) {
+        auto [resGetThirdArg, number] = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
+        if (!resGetThirdArg) {
+            HILOG_ERROR("Invalid speed");
+            NError(E_PARAMS).ThrowErr(env);
+            return nullptr;
+        }
+        speed = number;
     }
 
-    auto cbExec = [env = env, driver, ptFrom = ptFrom, ptTo = ptTo, stepLen = stepLen, speed = speed]() -> NError {
-        driver->Fling(ptFrom, ptTo, stepLen, speed);
+    auto cbExec = [driver, fingers = fingers, dir = direct, speed]() -> NError {
+        driver->MultiSwipe(fingers, static_cast<UiDirection>(dir), speed);
         return NError(ERRNO_NOERR);
     };
 
@@ -1678,21 +2393,22 @@ napi_value DriverNExporter::Fling(napi_env env, napi_callback_info info)
         if (err) {
             return { env, err.GetNapiErr(env) };
         }
-        HILOG_DEBUG("Fling Success!");
+        HILOG_DEBUG("MultiSwipe Success!");
         return NVal::CreateUndefined(env);
     };
 
     NVal thisVar(env, funcArg.GetThisVar());
-    string procedureName = "Fling";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    string procedureName = "MultiSwipe";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
-napi_value DriverNExporter::Click(napi_env env, napi_callback_info info)
+napi_value DriverNExporter::TwoFingerPan(napi_env env, napi_callback_info info)
 {
-    HILOG_DEBUG("Click begin");
+    HILOG_DEBUG("TwoFingerPan begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::TWO)) {
-        HILOG_ERROR("Click Number of arguments unmatched");
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::FOUR, NARG_CNT::FIVE)) {
+        HILOG_ERROR("TwoFingerPan Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
     }
@@ -1703,22 +2419,16 @@ napi_value DriverNExporter::Click(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    auto [resGetFirstArg, x] = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
-    if (!resGetFirstArg) {
-        HILOG_ERROR("Invalid x");
+    auto argsInfo = make_shared<ArgsInfo>();
+    if (!GetArgs(env, funcArg, argsInfo)) {
+        HILOG_ERROR("TwoFingerPan Invalid arguments");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
     }
 
-    auto [resGetSecondArg, y] = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
-    if (!resGetSecondArg) {
-        HILOG_ERROR("Invalid y");
-        NError(E_PARAMS).ThrowErr(env);
-        return nullptr;
-    }
-
-    auto cbExec = [driver, x = x, y = y]() -> NError {
-        driver->Click(x, y);
+    auto cbExec = [driver, argsInfo]() -> NError {
+        driver->TwoFingerPan({ argsInfo->startx, argsInfo->starty }, { argsInfo->endx, argsInfo->endy },
+            argsInfo->speed);
         return NError(ERRNO_NOERR);
     };
 
@@ -1726,21 +2436,22 @@ napi_value DriverNExporter::Click(napi_env env, napi_callback_info info)
         if (err) {
             return { env, err.GetNapiErr(env) };
         }
-        HILOG_DEBUG("Click Success!");
+        HILOG_DEBUG("TwoFingerPan Success!");
         return NVal::CreateUndefined(env);
     };
 
     NVal thisVar(env, funcArg.GetThisVar());
-    string procedureName = "Click";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    string procedureName = "TwoFingerPan";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
-napi_value DriverNExporter::DoubleClick(napi_env env, napi_callback_info info)
+napi_value DriverNExporter::MouseMove(napi_env env, napi_callback_info info)
 {
-    HILOG_ERROR("DoubleClick begin");
+    HILOG_DEBUG("MouseMove begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::TWO)) {
-        HILOG_ERROR("DoubleClick Number of arguments unmatched");
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::TWO)) {
+        HILOG_ERROR("MouseMove Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
     }
@@ -1766,7 +2477,7 @@ napi_value DriverNExporter::DoubleClick(napi_env env, napi_callback_info info)
     }
 
     auto cbExec = [driver, x = x, y = y]() -> NError {
-        driver->DoubleClick(x, y);
+        driver->MouseMove(x, y);
         return NError(ERRNO_NOERR);
     };
 
@@ -1774,21 +2485,22 @@ napi_value DriverNExporter::DoubleClick(napi_env env, napi_callback_info info)
         if (err) {
             return { env, err.GetNapiErr(env) };
         }
-        HILOG_DEBUG("DoubleClick Success!");
+        HILOG_DEBUG("MouseMove Success!");
         return NVal::CreateUndefined(env);
     };
 
     NVal thisVar(env, funcArg.GetThisVar());
-    string procedureName = "DoubleClick";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    string procedureName = "MouseMove";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
-napi_value DriverNExporter::LongClick(napi_env env, napi_callback_info info)
+napi_value DriverNExporter::MouseClick(napi_env env, napi_callback_info info)
 {
-    HILOG_DEBUG("LongClick begin");
+    HILOG_DEBUG("MouseClick begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::TWO)) {
-        HILOG_ERROR("LongClick Number of arguments unmatched");
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::TWO)) {
+        HILOG_ERROR("MouseClick Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
     }
@@ -1814,7 +2526,7 @@ napi_value DriverNExporter::LongClick(napi_env env, napi_callback_info info)
     }
 
     auto cbExec = [driver, x = x, y = y]() -> NError {
-        driver->LongClick(x, y);
+        driver->MouseClick(x, y);
         return NError(ERRNO_NOERR);
     };
 
@@ -1822,28 +2534,85 @@ napi_value DriverNExporter::LongClick(napi_env env, napi_callback_info info)
         if (err) {
             return { env, err.GetNapiErr(env) };
         }
-        HILOG_DEBUG("LongClick Success!");
+        HILOG_DEBUG("MouseClick Success!");
         return NVal::CreateUndefined(env);
     };
 
     NVal thisVar(env, funcArg.GetThisVar());
-    string procedureName = "LongClick";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    string procedureName = "MouseClick";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
-napi_value DriverNExporter::FindComponent(napi_env env, napi_callback_info info)
+napi_value DriverNExporter::MouseScroll(napi_env env, napi_callback_info info)
 {
-    HILOG_DEBUG("FindComponent begin");
+    HILOG_DEBUG("MouseScroll begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ONE)) {
-        HILOG_ERROR("FindComponent Number of arguments unmatched");
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::THREE, NARG_CNT::FOUR)) {
+        HILOG_ERROR("MouseScroll Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
     }
 
-    auto on = NClass::GetEntityOf<On>(env, NVal(env, funcArg[NARG_POS::FIRST]).val_);
-    if (!on) {
-        HILOG_ERROR("Cannot get entity of on");
+    auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
+    if (!driver) {
+        HILOG_ERROR("Cannot get entity of driver");
+        return nullptr;
+    }
+
+    auto [resGetFirstArg, x] = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
+    auto [resGetSecondArg, y] = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
+    if (!resGetFirstArg || !resGetSecondArg) {
+        HILOG_ERROR("Invalid point");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto [resGetThirdArg, wheelTicks] = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
+    if (!resGetThirdArg) {
+        HILOG_ERROR("Invalid wheelTicks");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    wheelTicks = clamp(wheelTicks, -Driver::MAX_WHEEL_TICKS, Driver::MAX_WHEEL_TICKS);
+
+    int32_t speed = 0;
+    if (funcArg.GetArgc() == NARG_CNT::FOUR) {
+        auto [resGetFourthArg, number] = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt32();
+        if (!resGetFourthArg) {
+            HILOG_ERROR("Invalid speed");
+            NError(E_PARAMS).ThrowErr(env);
+            return nullptr;
+        }
+        speed = number;
+    }
+
+    auto cbExec = [driver, x = x, y = y, wheelTicks = wheelTicks, speed]() -> NError {
+        driver->MouseScroll(x, y, wheelTicks, speed);
+        return NError(ERRNO_NOERR);
+    };
+
+    auto cbCompl = [](napi_env env, NError err) -> NVal {
+        if (err) {
+            return { env, err.GetNapiErr(env) };
+        }
+        HILOG_DEBUG("MouseScroll Success!");
+        return NVal::CreateUndefined(env);
+    };
+
+    NVal thisVar(env, funcArg.GetThisVar());
+    string procedureName = "MouseScroll";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
+}
+
+napi_value DriverNExporter::Drag(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("Drag begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::FOUR, NARG_CNT::SIX)) {
+        HILOG_ERROR("Drag Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
         return nullptr;
     }
 
@@ -1853,56 +2622,119 @@ napi_value DriverNExporter::FindComponent(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    napi_value jsComponent = NClass::InstantiateClass(env, ComponentNExporter::COMPONENT_CLASS_NAME, {});
-    if (!jsComponent) {
-        HILOG_ERROR("Failed to instantiate jsComponent class");
+    auto argsInfo = make_shared<ArgsInfo>();
+    if (!GetArgs(env, funcArg, argsInfo)) {
+        HILOG_ERROR("Drag Invalid arguments");
+        NError(E_PARAMS).ThrowErr(env);
         return nullptr;
     }
 
-    napi_ref ref = nullptr;
-    napi_create_reference(env, jsComponent, 1, &ref);
-    auto arg = make_shared<ArgsCls>();
-    auto cbExec = [driver, on, arg]() -> NError {
-        arg->component = move(driver->FindComponent(*on));
+    UiOpArgs options;
+    uint32_t holdMs = options.longClickHoldMs_;
+    if (funcArg.GetArgc() == NARG_CNT::SIX) {
+        auto [resGetSixthArg, number] = NVal(env, funcArg[NARG_POS::SIXTH]).ToInt32();
+        if (!resGetSixthArg || number < 0) {
+            HILOG_ERROR("Invalid holdMs");
+            NError(E_PARAMS).ThrowErr(env);
+            return nullptr;
+        }
+        holdMs = static_cast<uint32_t>(number);
+    }
+
+    auto cbExec = [driver, argsInfo, holdMs]() -> NError {
+        driver->Drag({ argsInfo->startx, argsInfo->starty }, { argsInfo->endx, argsInfo->endy }, holdMs,
+            argsInfo->speed);
         return NError(ERRNO_NOERR);
     };
 
-    auto cbCompl = [ref, arg](napi_env env, NError err) -> NVal {
+    auto cbCompl = [](napi_env env, NError err) -> NVal {
         if (err) {
             return { env, err.GetNapiErr(env) };
         }
-        if (!arg->component) {
-            HILOG_ERROR("Failed to component is nullptr.");
-            return NVal::CreateUndefined(env);
-        }
-        napi_value jsComponent_ = nullptr;
-        napi_get_reference_value(env, ref, &jsComponent_);
-        if (!NClass::SetEntityFor<Component>(env, jsComponent_, move(arg->component))) {
-            HILOG_ERROR("Failed to set Component entity");
-            return { env, NError(E_PARAMS).GetNapiErr(env) };
-        }
-        HILOG_DEBUG("FindComponent Success!");
-        return NVal(env, jsComponent_);
+        HILOG_DEBUG("Drag Success!");
+        return NVal::CreateUndefined(env);
     };
 
     NVal thisVar(env, funcArg.GetThisVar());
-    string procedureName = "FindComponent";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    string procedureName = "Drag";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
-napi_value DriverNExporter::FindComponents(napi_env env, napi_callback_info info)
+napi_value DriverNExporter::Fling(napi_env env, napi_callback_info info)
 {
-    HILOG_DEBUG("FindComponents begin");
+    HILOG_DEBUG("Fling begin");
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ONE)) {
-        HILOG_ERROR("FindComponents Number of arguments unmatched");
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::FOUR) && !funcArg.InitArgsWithCallOptions(NARG_CNT::TWO)) {
+        HILOG_ERROR("Fling Number of arguments unmatched");
         NError(E_PARAMS).ThrowErr(env);
         return nullptr;
     }
 
-    auto on = NClass::GetEntityOf<On>(env, NVal(env, funcArg[NARG_POS::FIRST]).val_);
-    if (!on) {
-        HILOG_ERROR("Cannot get entity of on");
+    if (funcArg.GetArgc() == NARG_CNT::TWO) {
+        return DirectFling(env, info);
+    }
+
+    auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
+    if (!driver) {
+        HILOG_ERROR("Cannot get entity of driver");
+        return nullptr;
+    }
+
+    NVal objFrom(env, funcArg[NARG_POS::FIRST]);
+    if (!objFrom.TypeIs(napi_object)) {
+        HILOG_ERROR("Invalid objFrom");
+        return nullptr;
+    }
+    Point ptFrom = { std::get<1>(objFrom.GetProp("x").ToInt32()), std::get<1>(objFrom.GetProp("y").ToInt32()) };
+
+    NVal objTo(env, funcArg[NARG_POS::SECOND]);
+    if (!objTo.TypeIs(napi_object)) {
+        HILOG_ERROR("Invalid objTo");
+        return nullptr;
+    }
+    Point ptTo = { std::get<1>(objTo.GetProp("x").ToInt32()), std::get<1>(objTo.GetProp("y").ToInt32()) };
+
+    auto [resGetFirstArg, stepLen] = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
+    if (!resGetFirstArg) {
+        HILOG_ERROR("Invalid x");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto [resGetSecondArg, speed] = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt32();
+    if (!resGetSecondArg) {
+        HILOG_ERROR("Invalid y");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto cbExec = [env = env, driver, ptFrom = ptFrom, ptTo = ptTo, stepLen = stepLen, speed = speed]() -> NError {
+        driver->Fling(ptFrom, ptTo, stepLen, speed);
+        return NError(ERRNO_NOERR);
+    };
+
+    auto cbCompl = [](napi_env env, NError err) -> NVal {
+        if (err) {
+            return { env, err.GetNapiErr(env) };
+        }
+        HILOG_DEBUG("Fling Success!");
+        return NVal::CreateUndefined(env);
+    };
+
+    NVal thisVar(env, funcArg.GetThisVar());
+    string procedureName = "Fling";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
+}
+
+napi_value DriverNExporter::Click(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("Click begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::TWO)) {
+        HILOG_ERROR("Click Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
         return nullptr;
     }
 
@@ -1911,33 +2743,1711 @@ napi_value DriverNExporter::FindComponents(napi_env env, napi_callback_info info
         HILOG_ERROR("Cannot get entity of driver");
         return nullptr;
     }
-    auto args = make_shared<ArgsCls>();
-    if (!args) {
-        HILOG_ERROR("Failed to request heap memory.");
-        NError(ENOMEM).ThrowErr(env);
+
+    auto [resGetFirstArg, x] = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
+    if (!resGetFirstArg) {
+        HILOG_ERROR("Invalid x");
+        NError(E_PARAMS).ThrowErr(env);
         return nullptr;
     }
 
-    auto cbExec = [driver, on, args, env]() -> NError {
-        args->components = move(driver->FindComponents(*on));
+    auto [resGetSecondArg, y] = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
+    if (!resGetSecondArg) {
+        HILOG_ERROR("Invalid y");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto cbExec = [driver, x = x, y = y]() -> NError {
+        driver->Click(x, y);
         return NError(ERRNO_NOERR);
     };
 
-    auto cbCompl = [args](napi_env env, NError err) -> NVal {
+    auto cbCompl = [](napi_env env, NError err) -> NVal {
         if (err) {
             return { env, err.GetNapiErr(env) };
         }
-        if (args->components.size() == 0) {
-            HILOG_DEBUG("FindComponents end,but null !");
-            return NVal::CreateUndefined(env);
+        HILOG_DEBUG("Click Success!");
+        return NVal::CreateUndefined(env);
+    };
+
+    NVal thisVar(env, funcArg.GetThisVar());
+    string procedureName = "Click";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
+}
+
+napi_value DriverNExporter::DoubleClick(napi_env env, napi_callback_info info)
+{
+    HILOG_ERROR("DoubleClick begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::TWO)) {
+        HILOG_ERROR("DoubleClick Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
+    if (!driver) {
+        HILOG_ERROR("Cannot get entity of driver");
+        return nullptr;
+    }
+
+    auto [resGetFirstArg, x] = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
+    if (!resGetFirstArg) {
+        HILOG_ERROR("Invalid x");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto [resGetSecondArg, y] = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
+    if (!resGetSecondArg) {
+        HILOG_ERROR("Invalid y");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto cbExec = [driver, x = x, y = y]() -> NError {
+        driver->DoubleClick(x, y);
+        return NError(ERRNO_NOERR);
+    };
+
+    auto cbCompl = [](napi_env env, NError err) -> NVal {
+        if (err) {
+            return { env, err.GetNapiErr(env) };
         }
-        HILOG_DEBUG("FindComponents Success!");
-        return NVal::CreateArray(env, move(args->components), ComponentNExporter::COMPONENT_CLASS_NAME);
+        HILOG_DEBUG("DoubleClick Success!");
+        return NVal::CreateUndefined(env);
     };
 
     NVal thisVar(env, funcArg.GetThisVar());
-    string procedureName = "FindComponents";
-    return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
+    string procedureName = "DoubleClick";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
+}
+
+napi_value DriverNExporter::LongClick(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("LongClick begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::TWO, NARG_CNT::THREE)) {
+        HILOG_ERROR("LongClick Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
+    if (!driver) {
+        HILOG_ERROR("Cannot get entity of driver");
+        return nullptr;
+    }
+
+    auto [resGetFirstArg, x] = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
+    if (!resGetFirstArg) {
+        HILOG_ERROR("Invalid x");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto [resGetSecondArg, y] = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
+    if (!resGetSecondArg) {
+        HILOG_ERROR("Invalid y");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    UiOpArgs options;
+    uint32_t holdMs = options.longClickHoldMs_;
+    if (funcArg.GetArgc() == NARG_CNT::THREE) {
+        auto [resGetThirdArg, number] = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
+        if (!resGetThirdArg || number < 0) {
+            HILOG_ERROR("Invalid holdMs");
+            NError(E_PARAMS).ThrowErr(env);
+            return nullptr;
+        }
+        holdMs = static_cast<uint32_t>(number);
+    }
+
+    auto cbExec = [driver, x = x, y = y, holdMs]() -> NError {
+        driver->LongClick(x, y, holdMs);
+        return NError(ERRNO_NOERR);
+    };
+
+    auto cbCompl = [](napi_env env, NError err) -> NVal {
+        if (err) {
+            return { env, err.GetNapiErr(env) };
+        }
+        HILOG_DEBUG("LongClick Success!");
+        return NVal::CreateUndefined(env);
+    };
+
+    NVal thisVar(env, funcArg.GetThisVar());
+    string procedureName = "LongClick";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
+}
+
+napi_value DriverNExporter::MultiClick(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("MultiClick begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::THREE, NARG_CNT::FIVE)) {
+        HILOG_ERROR("MultiClick Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
+    if (!driver) {
+        HILOG_ERROR("Cannot get entity of driver");
+        return nullptr;
+    }
+
+    // x, y, taps, holdMs?, intervalMs?
+    UiOpArgs options;
+    int32_t values[] = { 0, 0, 0, static_cast<int32_t>(options.clickHoldMs_),
+        static_cast<int32_t>(options.doubleClickIntervalMs_) };
+    for (size_t i = 0; i < funcArg.GetArgc(); i++) {
+        auto [succ, number] = NVal(env, funcArg[i]).ToInt32();
+        if (!succ || (i >= NARG_POS::THIRD && number < 0)) {
+            HILOG_ERROR("MultiClick Invalid argument %{public}zu", i);
+            NError(E_PARAMS).ThrowErr(env);
+            return nullptr;
+        }
+        values[i] = number;
+    }
+    // the events of all taps are built up front, bound their number
+    if (values[NARG_POS::THIRD] > static_cast<int32_t>(Driver::MAX_TAPS)) {
+        HILOG_ERROR("MultiClick taps must not exceed %{public}u", Driver::MAX_TAPS);
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto cbExec = [driver, x = values[NARG_POS::FIRST], y = values[NARG_POS::SECOND],
+        taps = static_cast<uint32_t>(values[NARG_POS::THIRD]), holdMs = static_cast<uint32_t>(values[NARG_POS::FOURTH]),
+        intervalMs = static_cast<uint32_t>(values[NARG_POS::FIFTH])]() -> NError {
+        driver->MultiClick(x, y, taps, holdMs, intervalMs);
+        return NError(ERRNO_NOERR);
+    };
+
+    auto cbCompl = [](napi_env env, NError err) -> NVal {
+        if (err) {
+            return { env, err.GetNapiErr(env) };
+        }
+        HILOG_DEBUG("MultiClick Success!");
+        return NVal::CreateUndefined(env);
+    };
+
+    NVal thisVar(env, funcArg.GetThisVar());
+    string procedureName = "MultiClick";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
+}
+
+napi_value DriverNExporter::FindComponent(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("FindComponent begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ONE)) {
+        HILOG_ERROR("FindComponent Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto on = NClass::GetEntityOf<On>(env, NVal(env, funcArg[NARG_POS::FIRST]).val_);
+    if (!on) {
+        HILOG_ERROR("Cannot get entity of on");
+        return nullptr;
+    }
+
+    auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
+    if (!driver) {
+        HILOG_ERROR("Cannot get entity of driver");
+        return nullptr;
+    }
+
+    napi_value jsComponent = NClass::InstantiateClass(env, COMPONENT_CLASS_ID, {});
+    if (!jsComponent) {
+        HILOG_ERROR("Failed to instantiate jsComponent class");
+        return nullptr;
+    }
+
+    auto ref = make_shared<NRef>(NVal(env, jsComponent));
+    auto arg = make_shared<ArgsCls>();
+    auto cbExec = [driver, on, arg]() -> NError {
+        arg->component = move(driver->FindComponent(*on));
+        return NError(ERRNO_NOERR);
+    };
+
+    auto cbCompl = [ref, arg, executor = driver->GetExecutor()](napi_env env, NError err) -> NVal {
+        if (err) {
+            return { env, err.GetNapiErr(env) };
+        }
+        if (!arg->component) {
+            HILOG_ERROR("Failed to component is nullptr.");
+            return NVal::CreateUndefined(env);
+        }
+        arg->component->SetExecutor(executor);
+        napi_value jsComponent_ = ref->Deref(env).val_;
+        if (!NClass::SetEntityFor<Component>(env, jsComponent_, move(arg->component))) {
+            HILOG_ERROR("Failed to set Component entity");
+            return { env, NError(E_PARAMS).GetNapiErr(env) };
+        }
+        HILOG_DEBUG("FindComponent Success!");
+        return NVal(env, jsComponent_);
+    };
+
+    NVal thisVar(env, funcArg.GetThisVar());
+    string procedureName = "FindComponent";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
+}
+
+napi_value DriverNExporter::FindComponents(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("FindComponents begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ONE)) {
+        HILOG_ERROR("FindComponents Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto on = NClass::GetEntityOf<On>(env, NVal(env, funcArg[NARG_POS::FIRST]).val_);
+    if (!on) {
+        HILOG_ERROR("Cannot get entity of on");
+        return nullptr;
+    }
+
+    auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
+    if (!driver) {
+        HILOG_ERROR("Cannot get entity of driver");
+        return nullptr;
+    }
+    auto args = make_shared<ArgsCls>();
+    if (!args) {
+        HILOG_ERROR("Failed to request heap memory.");
+        NError(ENOMEM).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto cbExec = [driver, on, args, env]() -> NError {
+        args->components = move(driver->FindComponents(*on));
+        return NError(ERRNO_NOERR);
+    };
+
+    auto cbCompl = [args, executor = driver->GetExecutor()](napi_env env, NError err) -> NVal {
+        if (err) {
+            return { env, err.GetNapiErr(env) };
+        }
+        if (args->components.size() == 0) {
+            HILOG_DEBUG("FindComponents end,but null !");
+            return NVal::CreateUndefined(env);
+        }
+        for (auto& component : args->components) {
+            component->SetExecutor(executor);
+        }
+        HILOG_DEBUG("FindComponents Success!");
+        return NVal::CreateArray(env, move(args->components), COMPONENT_CLASS_ID);
+    };
+
+    NVal thisVar(env, funcArg.GetThisVar());
+    string procedureName = "FindComponents";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
+}
+
+static const pair<const char*, ComponentColumn> COLUMN_NAMES[] = {
+    { "id", COLUMN_ID },
+    { "text", COLUMN_TEXT },
+    { "type", COLUMN_TYPE },
+    { "bounds", COLUMN_BOUNDS },
+    { "flags", COLUMN_FLAGS },
+};
+
+// bit i of the flags column is named FLAG_NAMES[i]
+static const char* FLAG_NAMES[] = {
+    "clickable", "longClickable", "scrollable", "enabled", "focused", "selected", "checked", "checkable"
+};
+
+static bool ParseColumns(napi_env env, NFuncArg& funcArg, uint32_t& columns)
+{
+    columns = COLUMN_ALL;
+    if (funcArg.GetArgc() != NARG_CNT::TWO) {
+        return true;
+    }
+    NVal jsFields(env, funcArg[NARG_POS::SECOND]);
+    if (jsFields.TypeIs(napi_undefined)) {
+        return true;
+    }
+    auto [succ, fields, size] = jsFields.ToStringArray();
+    if (!succ) {
+        return false;
+    }
+    columns = 0;
+    for (const auto& field : fields) {
+        auto find = find_if(begin(COLUMN_NAMES), end(COLUMN_NAMES),
+            [&field](const pair<const char*, ComponentColumn>& column) { return field == column.first; });
+        if (find == end(COLUMN_NAMES)) {
+            HILOG_ERROR("Unknown column %{public}s", field.c_str());
+            return false;
+        }
+        columns |= find->second;
+    }
+    return true;
+}
+
+static NVal CreateStringArray(napi_env env, const vector<string>& values)
+{
+    napi_value array = nullptr;
+    napi_create_array_with_length(env, values.size(), &array);
+    for (size_t i = 0; i < values.size(); i++) {
+        napi_set_element(env, array, i, NVal::CreateUTF8String(env, values[i]).val_);
+    }
+    return { env, array };
+}
+
+// one ArrayBuffer per column, filled with a single copy of the native column
+template<typename T>
+static NVal CreateTypedArray(napi_env env, napi_typedarray_type type, const vector<T>& values)
+{
+    auto [buffer, data] = NVal::CreateArrayBuffer(env, values.size() * sizeof(T));
+    if (data == nullptr && !values.empty()) {
+        HILOG_ERROR("Failed to allocate a column of %{public}zu", values.size());
+        return NVal::CreateUndefined(env);
+    }
+    if (!values.empty()) {
+        memcpy(data, values.data(), values.size() * sizeof(T));
+    }
+    napi_value array = nullptr;
+    napi_create_typedarray(env, type, values.size(), buffer.val_, 0, &array);
+    return { env, array };
+}
+
+static NVal CreateColumnsResult(napi_env env, const ComponentColumns& result, uint32_t columns)
+{
+    NVal obj = NVal::CreateObject(env);
+    obj.AddProp("count", NVal::CreateInt64(env, result.count).val_);
+    if (columns & COLUMN_ID) {
+        obj.AddProp("ids", CreateStringArray(env, result.ids).val_);
+    }
+    if (columns & COLUMN_TEXT) {
+        obj.AddProp("texts", CreateStringArray(env, result.texts).val_);
+    }
+    if (columns & COLUMN_TYPE) {
+        obj.AddProp("types", CreateStringArray(env, result.types).val_);
+    }
+    if (columns & COLUMN_BOUNDS) {
+        obj.AddProp("bounds", CreateTypedArray(env, napi_int32_array, result.bounds).val_);
+    }
+    if (columns & COLUMN_FLAGS) {
+        obj.AddProp("flags", CreateTypedArray(env, napi_uint8_array, result.flags).val_);
+        napi_value names = nullptr;
+        napi_create_array_with_length(env, size(FLAG_NAMES), &names);
+        for (size_t i = 0; i < size(FLAG_NAMES); i++) {
+            napi_set_element(env, names, i, NVal::CreateUTF8String(env, FLAG_NAMES[i]).val_);
+        }
+        obj.AddProp("flagNames", names);
+    }
+    return obj;
+}
+
+napi_value DriverNExporter::FindComponentsColumnar(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("FindComponentsColumnar begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ONE, NARG_CNT::TWO)) {
+        HILOG_ERROR("FindComponentsColumnar Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto on = NClass::GetEntityOf<On>(env, NVal(env, funcArg[NARG_POS::FIRST]).val_);
+    if (!on) {
+        HILOG_ERROR("Cannot get entity of on");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    uint32_t columns = COLUMN_ALL;
+    if (!ParseColumns(env, funcArg, columns)) {
+        HILOG_ERROR("Get FindComponentsColumnar fields failed!");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
+    if (!driver) {
+        HILOG_ERROR("Cannot get entity of driver");
+        NError(E_DESTROYED).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto exec = [driver, on, columns](ComponentColumns& result) {
+        result = driver->FindComponentColumns(*on, columns);
+    };
+    auto toJs = [columns](napi_env env, const ComponentColumns& result) -> NVal {
+        HILOG_DEBUG("FindComponentsColumnar count:%{public}u", result.count);
+        return CreateColumnsResult(env, result, columns);
+    };
+    return ScheduleWithResult<ComponentColumns>(env, funcArg, PostTo(driver->GetExecutor()),
+        "FindComponentsColumnar", exec, toJs);
+}
+
+/**
+ * One findComponentsIter iterator. Chunks are built on the driver executor, at most STREAM_BUFFERED_CHUNKS
+ * ahead of the js consumer, and each one is announced to the js thread through the threadsafe function
+ * of the stream as soon as it is built. A producing task never waits for the consumer: it ends when the
+ * buffer is full and the js side posts the next one once a chunk is taken, so the executor stays free
+ * for the operations the consumer runs on the components it received.
+ **/
+struct ComponentStream : public enable_shared_from_this<ComponentStream> {
+    size_t chunkSize = DEFAULT_STREAM_CHUNK;
+    shared_ptr<OrderedExecutor> executor;
+    // only used by the producing task, which runs on the executor
+    unique_ptr<ComponentCursor> cursor;
+
+    // guarded by lock
+    mutex lock;
+    deque<vector<unique_ptr<Component>>> chunks;
+    bool producing = false;
+    bool exhausted = false;
+    bool closed = false;
+
+    // js thread only
+    napi_threadsafe_function tsfn = nullptr;
+    bool released = false;
+    deque<napi_deferred> waiters;
+};
+
+static void ProduceChunks(ComponentStream& stream)
+{
+    while (true) {
+        {
+            lock_guard<mutex> guard(stream.lock);
+            if (stream.closed || stream.chunks.size() >= STREAM_BUFFERED_CHUNKS) {
+                break;
+            }
+        }
+        auto chunk = stream.cursor->Next(stream.chunkSize);
+        bool last = chunk.empty() || stream.cursor->Done();
+        {
+            lock_guard<mutex> guard(stream.lock);
+            // a chunk finished after return() is dropped here, on the executor
+            if (!chunk.empty() && !stream.closed) {
+                stream.chunks.push_back(move(chunk));
+            }
+            stream.exhausted = last;
+        }
+        if (last) {
+            break;
+        }
+        napi_call_threadsafe_function(stream.tsfn, nullptr, napi_tsfn_nonblocking);
+    }
+    {
+        lock_guard<mutex> guard(stream.lock);
+        stream.producing = false;
+    }
+    napi_call_threadsafe_function(stream.tsfn, nullptr, napi_tsfn_nonblocking);
+}
+
+// called on the js thread, on is only given to the first task, which opens the cursor
+static void PostProduce(napi_env env, const shared_ptr<ComponentStream>& stream, shared_ptr<On> on = nullptr)
+{
+    {
+        lock_guard<mutex> guard(stream->lock);
+        stream->producing = true;
+    }
+    // the task holds its own count of the function, so it stays valid even if the iterator is closed meanwhile
+    napi_acquire_threadsafe_function(stream->tsfn);
+    napi_ref_threadsafe_function(env, stream->tsfn);
+    stream->executor->Post([stream, on]() {
+        if (on != nullptr) {
+            stream->cursor = Driver().FindComponentsCursor(*on);
+        }
+        ProduceChunks(*stream);
+        napi_release_threadsafe_function(stream->tsfn, napi_tsfn_release);
+    }, PRIORITY_NORMAL);
+}
+
+static napi_value CreateIterResult(napi_env env, napi_value value, bool done)
+{
+    NVal result = NVal::CreateObject(env);
+    result.AddProp("value", value != nullptr ? value : NVal::CreateUndefined(env).val_);
+    result.AddProp("done", NVal::CreateBool(env, done).val_);
+    return result.val_;
+}
+
+// settle the waiting next() calls with the buffered chunks, then keep the buffer filled or let the stream go
+static void DrainStream(napi_env env, const shared_ptr<ComponentStream>& stream)
+{
+    bool finished = false;
+    bool canProduce = false;
+    while (true) {
+        vector<unique_ptr<Component>> chunk;
+        {
+            lock_guard<mutex> guard(stream->lock);
+            finished = stream->closed || (stream->exhausted && stream->chunks.empty());
+            if (stream->waiters.empty() || (!finished && stream->chunks.empty())) {
+                canProduce = !finished && !stream->exhausted && !stream->producing &&
+                    stream->chunks.size() < STREAM_BUFFERED_CHUNKS;
+                break;
+            }
+            if (!finished) {
+                chunk = move(stream->chunks.front());
+                stream->chunks.pop_front();
+            }
+        }
+        napi_deferred deferred = stream->waiters.front();
+        stream->waiters.pop_front();
+        napi_value value = nullptr;
+        if (!finished) {
+            for (auto& component : chunk) {
+                component->SetExecutor(stream->executor);
+            }
+            value = NVal::CreateArray(env, move(chunk), COMPONENT_CLASS_ID).val_;
+        }
+        napi_resolve_deferred(env, deferred, CreateIterResult(env, value, finished));
+    }
+    if (stream->released) {
+        return;
+    }
+    if (canProduce) {
+        PostProduce(env, stream);
+    } else if (finished) {
+        stream->released = true;
+        napi_release_threadsafe_function(stream->tsfn, napi_tsfn_release);
+    }
+}
+
+static void OnStreamReady(napi_env env, napi_value jsCb, void* context, void* data)
+{
+    if (env == nullptr) {
+        return;
+    }
+    auto stream = static_cast<ComponentStream*>(context)->shared_from_this();
+    bool producing = false;
+    {
+        lock_guard<mutex> guard(stream->lock);
+        producing = stream->producing;
+    }
+    if (!producing && !stream->released) {
+        napi_unref_threadsafe_function(env, stream->tsfn);
+    }
+    DrainStream(env, stream);
+}
+
+static shared_ptr<ComponentStream> GetStream(napi_env env, napi_value iterator)
+{
+    void* holder = nullptr;
+    if (napi_unwrap(env, iterator, &holder) != napi_ok || holder == nullptr) {
+        HILOG_ERROR("Cannot get the stream of the iterator");
+        return nullptr;
+    }
+    return *static_cast<shared_ptr<ComponentStream>*>(holder);
+}
+
+static napi_value ComponentStreamNext(napi_env env, napi_callback_info info)
+{
+    NFuncArg funcArg(env, info);
+    funcArg.InitArgs(NARG_CNT::ZERO, NARG_CNT::ONE);
+    auto stream = GetStream(env, funcArg.GetThisVar());
+    if (stream == nullptr) {
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    napi_deferred deferred = nullptr;
+    napi_value promise = nullptr;
+    if (napi_create_promise(env, &deferred, &promise) != napi_ok) {
+        HILOG_ERROR("INNER BUG. Cannot create promise of the iterator");
+        return nullptr;
+    }
+    stream->waiters.push_back(deferred);
+    DrainStream(env, stream);
+    return promise;
+}
+
+// break out of for await: drop the buffered chunks and stop producing
+static napi_value ComponentStreamReturn(napi_env env, napi_callback_info info)
+{
+    NFuncArg funcArg(env, info);
+    funcArg.InitArgs(NARG_CNT::ZERO, NARG_CNT::ONE);
+    auto stream = GetStream(env, funcArg.GetThisVar());
+    if (stream == nullptr) {
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    deque<vector<unique_ptr<Component>>> dropped;
+    {
+        lock_guard<mutex> guard(stream->lock);
+        stream->closed = true;
+        dropped.swap(stream->chunks);
+    }
+    DrainStream(env, stream);
+    napi_deferred deferred = nullptr;
+    napi_value promise = nullptr;
+    if (napi_create_promise(env, &deferred, &promise) != napi_ok) {
+        HILOG_ERROR("INNER BUG. Cannot create promise of the iterator");
+        return nullptr;
+    }
+    napi_resolve_deferred(env, deferred, CreateIterResult(env, nullptr, true));
+    return promise;
+}
+
+static napi_value ComponentStreamSelf(napi_env env, napi_callback_info info)
+{
+    napi_value thisVar = nullptr;
+    napi_get_cb_info(env, info, nullptr, nullptr, &thisVar, nullptr);
+    return thisVar;
+}
+
+// an iterator dropped without return() stops its stream. with a next() still waiting a producing task is in
+// flight, its DrainStream settles the waiters as done and releases the function once they are gone
+static void FinalizeStreamIterator(napi_env env, void* data, void* hint)
+{
+    auto holder = static_cast<shared_ptr<ComponentStream>*>(data);
+    auto& stream = *holder;
+    deque<vector<unique_ptr<Component>>> dropped;
+    {
+        lock_guard<mutex> guard(stream->lock);
+        stream->closed = true;
+        dropped.swap(stream->chunks);
+    }
+    if (stream->waiters.empty() && !stream->released) {
+        stream->released = true;
+        napi_release_threadsafe_function(stream->tsfn, napi_tsfn_release);
+    }
+    delete holder;
+}
+
+static napi_value CreateStreamIterator(napi_env env, const shared_ptr<ComponentStream>& stream)
+{
+    napi_value iterator = NVal::CreateObject(env).val_;
+    auto holder = new shared_ptr<ComponentStream>(stream);
+    if (napi_wrap(env, iterator, holder, FinalizeStreamIterator, nullptr, nullptr) != napi_ok) {
+        HILOG_ERROR("INNER BUG. Cannot wrap the iterator");
+        delete holder;
+        return nullptr;
+    }
+    napi_property_descriptor props[] = {
+        NVal::DeclareNapiFunction("next", ComponentStreamNext),
+        NVal::DeclareNapiFunction("return", ComponentStreamReturn),
+    };
+    napi_define_properties(env, iterator, sizeof(props) / sizeof(props[0]), props);
+    napi_value global = nullptr;
+    napi_value symbol = nullptr;
+    napi_value asyncIterator = nullptr;
+    napi_value self = nullptr;
+    napi_get_global(env, &global);
+    napi_get_named_property(env, global, "Symbol", &symbol);
+    napi_get_named_property(env, symbol, "asyncIterator", &asyncIterator);
+    napi_create_function(env, "[Symbol.asyncIterator]", NAPI_AUTO_LENGTH, ComponentStreamSelf, nullptr, &self);
+    napi_set_property(env, iterator, asyncIterator, self);
+    return iterator;
+}
+
+napi_value DriverNExporter::FindComponentsIter(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("FindComponentsIter begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgs(NARG_CNT::ONE, NARG_CNT::TWO)) {
+        HILOG_ERROR("FindComponentsIter Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto on = NClass::GetEntityOf<On>(env, NVal(env, funcArg[NARG_POS::FIRST]).val_);
+    if (!on) {
+        HILOG_ERROR("Cannot get entity of on");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    int32_t chunkSize = DEFAULT_STREAM_CHUNK;
+    if (funcArg.GetArgc() == NARG_CNT::TWO) {
+        auto [succ, number] = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
+        if (!succ || number < 1 || number > MAX_STREAM_CHUNK) {
+            HILOG_ERROR("FindComponentsIter chunkSize must be in [1, %{public}d]", MAX_STREAM_CHUNK);
+            NError(E_PARAMS).ThrowErr(env);
+            return nullptr;
+        }
+        chunkSize = number;
+    }
+
+    auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
+    if (!driver) {
+        HILOG_ERROR("Cannot get entity of driver");
+        NError(E_DESTROYED).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto stream = make_shared<ComponentStream>();
+    stream->chunkSize = static_cast<size_t>(chunkSize);
+    stream->executor = driver->GetExecutor();
+    // the function keeps the stream alive until its last producing task is done with it
+    auto tsfnHolder = new shared_ptr<ComponentStream>(stream);
+    napi_value resource = NVal::CreateUTF8String(env, "FindComponentsIter").val_;
+    napi_status status = napi_create_threadsafe_function(env, nullptr, nullptr, resource, 0, 1, tsfnHolder,
+        [](napi_env env, void* data, void* hint) { delete static_cast<shared_ptr<ComponentStream>*>(data); },
+        stream.get(), OnStreamReady, &stream->tsfn);
+    if (status != napi_ok) {
+        HILOG_ERROR("INNER BUG. Cannot create threadsafe function for %{public}d", status);
+        delete tsfnHolder;
+        NError(EIO).ThrowErr(env);
+        return nullptr;
+    }
+    napi_unref_threadsafe_function(env, stream->tsfn);
+    napi_value iterator = CreateStreamIterator(env, stream);
+    if (iterator == nullptr) {
+        stream->released = true;
+        napi_release_threadsafe_function(stream->tsfn, napi_tsfn_release);
+        NError(EIO).ThrowErr(env);
+        return nullptr;
+    }
+    // the search is queued after the operations already posted, and prefetches before the first next()
+    PostProduce(env, stream, make_shared<On>(*on));
+    HILOG_DEBUG("FindComponentsIter end");
+    return iterator;
+}
+
+static constexpr const char* WAITED_MS_PROP = "waitedMs";
+
+static bool GetWaitTimeout(napi_env env, NFuncArg& funcArg, int32_t& timeoutMs)
+{
+    timeoutMs = DEFAULT_WAIT_COMPONENT_MS;
+    if (funcArg.GetArgc() < NARG_CNT::TWO) {
+        return true;
+    }
+    auto [succ, number] = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
+    if (!succ || number < 0) {
+        return false;
+    }
+    timeoutMs = number;
+    return true;
+}
+
+napi_value DriverNExporter::WaitForComponent(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("WaitForComponent begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ONE, NARG_CNT::TWO)) {
+        HILOG_ERROR("WaitForComponent Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto on = NClass::GetEntityOf<On>(env, NVal(env, funcArg[NARG_POS::FIRST]).val_);
+    if (!on) {
+        HILOG_ERROR("Cannot get entity of on");
+        return nullptr;
+    }
+
+    int32_t timeoutMs = 0;
+    if (!GetWaitTimeout(env, funcArg, timeoutMs)) {
+        HILOG_ERROR("Invalid timeoutMs");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
+    if (!driver) {
+        HILOG_ERROR("Cannot get entity of driver");
+        return nullptr;
+    }
+
+    napi_value jsComponent = NClass::InstantiateClass(env, COMPONENT_CLASS_ID, {});
+    if (!jsComponent) {
+        HILOG_ERROR("Failed to instantiate jsComponent class");
+        return nullptr;
+    }
+
+    auto ref = make_shared<NRef>(NVal(env, jsComponent));
+    auto arg = make_shared<ArgsCls>();
+    auto waitedMs = make_shared<uint32_t>(0);
+    auto cbExec = [driver, on, timeoutMs, arg, waitedMs]() -> NError {
+        arg->component = driver->WaitForComponent(*on, timeoutMs, waitedMs.get());
+        return NError(ERRNO_NOERR);
+    };
+
+    auto cbCompl = [ref, arg, waitedMs, executor = driver->GetExecutor()](napi_env env, NError err) -> NVal {
+        napi_value jsComponent_ = ref->Deref(env).val_;
+        if (err) {
+            return { env, err.GetNapiErr(env) };
+        }
+        if (!arg->component) {
+            HILOG_DEBUG("WaitForComponent timeout");
+            return NVal::CreateUndefined(env);
+        }
+        arg->component->SetExecutor(executor);
+        if (!NClass::SetEntityFor<Component>(env, jsComponent_, move(arg->component))) {
+            HILOG_ERROR("Failed to set Component entity");
+            return { env, NError(E_PARAMS).GetNapiErr(env) };
+        }
+        // time to appear of this wait, concurrent waits each keep their own
+        NVal result(env, jsComponent_);
+        result.AddProp(WAITED_MS_PROP, NVal::CreateInt64(env, *waitedMs).val_);
+        HILOG_DEBUG("WaitForComponent Success!");
+        return result;
+    };
+
+    NVal thisVar(env, funcArg.GetThisVar());
+    string procedureName = "WaitForComponent";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
+}
+
+napi_value DriverNExporter::WaitForComponentDisappear(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("WaitForComponentDisappear begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ONE, NARG_CNT::TWO)) {
+        HILOG_ERROR("WaitForComponentDisappear Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto on = NClass::GetEntityOf<On>(env, NVal(env, funcArg[NARG_POS::FIRST]).val_);
+    if (!on) {
+        HILOG_ERROR("Cannot get entity of on");
+        return nullptr;
+    }
+
+    int32_t timeoutMs = 0;
+    if (!GetWaitTimeout(env, funcArg, timeoutMs)) {
+        HILOG_ERROR("Invalid timeoutMs");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
+    if (!driver) {
+        HILOG_ERROR("Cannot get entity of driver");
+        return nullptr;
+    }
+
+    struct DisappearResult {
+        bool disappeared = false;
+        uint32_t waitedMs = 0;
+    };
+    auto ret = make_shared<DisappearResult>();
+    auto cbExec = [driver, on, timeoutMs, ret]() -> NError {
+        ret->disappeared = driver->WaitForComponentDisappear(*on, timeoutMs, &ret->waitedMs);
+        return NError(ERRNO_NOERR);
+    };
+
+    auto cbCompl = [ret](napi_env env, NError err) -> NVal {
+        if (err) {
+            return { env, err.GetNapiErr(env) };
+        }
+        HILOG_DEBUG("WaitForComponentDisappear Success!");
+        NVal result = NVal::CreateObject(env);
+        result.AddProp("disappeared", NVal::CreateBool(env, ret->disappeared).val_);
+        result.AddProp(WAITED_MS_PROP, NVal::CreateInt64(env, ret->waitedMs).val_);
+        return result;
+    };
+
+    NVal thisVar(env, funcArg.GetThisVar());
+    string procedureName = "WaitForComponentDisappear";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
+}
+
+static bool GetBatchInt(const NVal& op, const char* name, int32_t& value, bool required)
+{
+    if (!op.HasProp(name)) {
+        return !required;
+    }
+    auto [succ, number] = op.GetProp(name).ToInt32();
+    if (!succ) {
+        return false;
+    }
+    value = number;
+    return true;
+}
+
+static bool GetBatchUint(const NVal& op, const char* name, uint32_t& value, bool required)
+{
+    int32_t number = 0;
+    if (!GetBatchInt(op, name, number, required) || number < 0) {
+        return false;
+    }
+    if (op.HasProp(name)) {
+        value = static_cast<uint32_t>(number);
+    }
+    return true;
+}
+
+static bool ParseBatchOp(napi_env env, const NVal& jsOp, BatchOp& op)
+{
+    if (!jsOp.TypeIs(napi_object) || !jsOp.HasProp("op")) {
+        return false;
+    }
+    auto [succName, name, ignore] = jsOp.GetProp("op").ToUTF8String();
+    if (!succName || !ActionBatch::ParseOpType(name.get(), op.type)) {
+        return false;
+    }
+    switch (op.type) {
+        case BatchOpType::CLICK:
+        case BatchOpType::DOUBLE_CLICK:
+        case BatchOpType::LONG_CLICK:
+            return GetBatchInt(jsOp, "x", op.from.x, true) && GetBatchInt(jsOp, "y", op.from.y, true);
+        case BatchOpType::SWIPE:
+            return GetBatchInt(jsOp, "startx", op.from.x, true) && GetBatchInt(jsOp, "starty", op.from.y, true) &&
+                GetBatchInt(jsOp, "endx", op.to.x, true) && GetBatchInt(jsOp, "endy", op.to.y, true) &&
+                GetBatchUint(jsOp, "speed", op.speed, false);
+        case BatchOpType::KEY: {
+            int32_t key = 0;
+            if (!GetBatchInt(jsOp, "key", key, true)) {
+                return false;
+            }
+            op.keys.emplace_back(key);
+            return true;
+        }
+        case BatchOpType::COMBINE_KEYS: {
+            if (!jsOp.HasProp("keys")) {
+                return false;
+            }
+            NVal keys = jsOp.GetProp("keys");
+            uint32_t size = 0;
+            if (napi_get_array_length(env, keys.val_, &size) != napi_ok) {
+                return false;
+            }
+            for (uint32_t i = 0; i < size; i++) {
+                napi_value element = nullptr;
+                napi_get_element(env, keys.val_, i, &element);
+                auto [succ, key] = NVal(env, element).ToInt32();
+                if (!succ) {
+                    return false;
+                }
+                op.keys.emplace_back(key);
+            }
+            return true;
+        }
+        case BatchOpType::DELAY:
+            return GetBatchUint(jsOp, "ms", op.ms, true);
+        case BatchOpType::WAIT_FOR_IDLE:
+            op.ms = DEFAULT_IDLE_MS;
+            op.timeoutMs = DEFAULT_IDLE_TIMEOUT_MS;
+            return GetBatchUint(jsOp, "idleMs", op.ms, false) && GetBatchUint(jsOp, "timeoutMs", op.timeoutMs, false);
+        case BatchOpType::FIND:
+        case BatchOpType::ASSERT_EXIST: {
+            if (!jsOp.HasProp("on")) {
+                return false;
+            }
+            auto on = NClass::GetEntityOf<On>(env, jsOp.GetProp("on").val_);
+            if (!on) {
+                return false;
+            }
+            // copy the selector, the js object may be collected before the batch runs
+            op.on = *on;
+            return GetBatchUint(jsOp, "timeoutMs", op.timeoutMs, false);
+        }
+        case BatchOpType::CLICK_COMPONENT:
+            return GetBatchInt(jsOp, "ref", op.ref, true);
+        case BatchOpType::INPUT_TEXT: {
+            if (!GetBatchInt(jsOp, "ref", op.ref, true) || !jsOp.HasProp("text")) {
+                return false;
+            }
+            auto [succText, text, len] = jsOp.GetProp("text").ToUTF8String();
+            if (!succText) {
+                return false;
+            }
+            op.text = string(text.get(), len);
+            return true;
+        }
+        default:
+            return true;
+    }
+}
+
+static NVal CreateBatchResult(napi_env env, const BatchResult& result)
+{
+    NVal obj = NVal::CreateObject(env);
+    obj.AddProp("success", NVal::CreateBool(env, result.success).val_);
+    obj.AddProp("failedStep", NVal::CreateInt32(env, result.failedStep).val_);
+    obj.AddProp("totalUs", NVal::CreateInt64(env, result.totalUs).val_);
+    napi_value steps = nullptr;
+    napi_create_array_with_length(env, result.steps.size(), &steps);
+    for (size_t i = 0; i < result.steps.size(); i++) {
+        const auto& step = result.steps[i];
+        NVal jsStep = NVal::CreateObject(env);
+        jsStep.AddProp("op", NVal::CreateUTF8String(env, ActionBatch::GetOpName(step.type)).val_);
+        jsStep.AddProp("success", NVal::CreateBool(env, step.success).val_);
+        jsStep.AddProp("startUs", NVal::CreateInt64(env, step.startUs).val_);
+        jsStep.AddProp("durationUs", NVal::CreateInt64(env, step.durationUs).val_);
+        napi_set_element(env, steps, i, jsStep.val_);
+    }
+    obj.AddProp("steps", steps);
+    return obj;
+}
+
+napi_value DriverNExporter::RunBatch(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("RunBatch begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ONE)) {
+        HILOG_ERROR("RunBatch Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
+    if (!driver) {
+        HILOG_ERROR("Cannot get entity of driver");
+        return nullptr;
+    }
+
+    napi_value jsOps = funcArg[NARG_POS::FIRST];
+    uint32_t size = 0;
+    if (napi_get_array_length(env, jsOps, &size) != napi_ok) {
+        HILOG_ERROR("RunBatch ops is not an array");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    auto batch = make_shared<ActionBatch>();
+    for (uint32_t i = 0; i < size; i++) {
+        napi_value element = nullptr;
+        napi_get_element(env, jsOps, i, &element);
+        BatchOp op;
+        string err;
+        if (!ParseBatchOp(env, NVal(env, element), op)) {
+            HILOG_ERROR("RunBatch invalid op at %{public}u", i);
+            NError(E_PARAMS).ThrowErr(env);
+            return nullptr;
+        }
+        if (!batch->Append(move(op), err)) {
+            HILOG_ERROR("RunBatch %{public}s", err.c_str());
+            NError(E_PARAMS).ThrowErr(env);
+            return nullptr;
+        }
+    }
+
+    auto result = make_shared<BatchResult>();
+    auto cbExec = [driver, batch, result]() -> NError {
+        *result = batch->Run(*driver);
+        return NError(ERRNO_NOERR);
+    };
+
+    auto cbCompl = [result](napi_env env, NError err) -> NVal {
+        if (err) {
+            return { env, err.GetNapiErr(env) };
+        }
+        HILOG_DEBUG("RunBatch Success!");
+        return CreateBatchResult(env, *result);
+    };
+
+    NVal thisVar(env, funcArg.GetThisVar());
+    string procedureName = "RunBatch";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
+}
+
+napi_value DriverNExporter::StartRecording(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("StartRecording begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ONE)) {
+        HILOG_ERROR("StartRecording Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
+    if (!driver) {
+        HILOG_ERROR("Cannot get entity of driver");
+        return nullptr;
+    }
+
+    auto [succ, path, ignore] = NVal(env, funcArg[NARG_POS::FIRST]).ToUTF8String();
+    if (!succ) {
+        HILOG_ERROR("Invalid path");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto ret = make_shared<bool>(false);
+    auto cbExec = [driver, tracePath = string(path.get()), ret]() -> NError {
+        *ret = driver->StartRecording(tracePath);
+        return NError(ERRNO_NOERR);
+    };
+
+    auto cbCompl = [ret](napi_env env, NError err) -> NVal {
+        if (err) {
+            return { env, err.GetNapiErr(env) };
+        }
+        HILOG_DEBUG("StartRecording Success!");
+        return NVal::CreateBool(env, *ret);
+    };
+
+    NVal thisVar(env, funcArg.GetThisVar());
+    string procedureName = "StartRecording";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
+}
+
+napi_value DriverNExporter::StopRecording(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("StopRecording begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgs(NARG_CNT::ZERO)) {
+        HILOG_ERROR("StopRecording Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
+    if (!driver) {
+        HILOG_ERROR("Cannot get entity of driver");
+        return nullptr;
+    }
+    return NVal::CreateBool(env, driver->StopRecording()).val_;
+}
+
+napi_value DriverNExporter::Replay(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("Replay begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ONE, NARG_CNT::TWO)) {
+        HILOG_ERROR("Replay Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
+    if (!driver) {
+        HILOG_ERROR("Cannot get entity of driver");
+        return nullptr;
+    }
+
+    auto [succ, path, ignore] = NVal(env, funcArg[NARG_POS::FIRST]).ToUTF8String();
+    if (!succ) {
+        HILOG_ERROR("Invalid path");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    double speed = 1.0;
+    if (funcArg.GetArgc() == NARG_CNT::TWO) {
+        auto [succSpeed, number] = NVal(env, funcArg[NARG_POS::SECOND]).ToDouble();
+        if (!succSpeed || number < GestureReplayer::MIN_SPEED || number > GestureReplayer::MAX_SPEED) {
+            HILOG_ERROR("Invalid speed");
+            NError(E_PARAMS).ThrowErr(env);
+            return nullptr;
+        }
+        speed = number;
+    }
+
+    auto ret = make_shared<bool>(false);
+    auto cbExec = [driver, tracePath = string(path.get()), speed, ret]() -> NError {
+        *ret = driver->Replay(tracePath, static_cast<float>(speed));
+        return NError(ERRNO_NOERR);
+    };
+
+    auto cbCompl = [ret](napi_env env, NError err) -> NVal {
+        if (err) {
+            return { env, err.GetNapiErr(env) };
+        }
+        HILOG_DEBUG("Replay Success!");
+        return NVal::CreateBool(env, *ret);
+    };
+
+    NVal thisVar(env, funcArg.GetThisVar());
+    string procedureName = "Replay";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
+}
+
+napi_value DriverNExporter::WaitForIdle(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("WaitForIdle begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ZERO, NARG_CNT::TWO)) {
+        HILOG_ERROR("WaitForIdle Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
+    if (!driver) {
+        HILOG_ERROR("Cannot get entity of driver");
+        return nullptr;
+    }
+
+    int32_t idleMs = DEFAULT_IDLE_MS;
+    int32_t timeoutMs = DEFAULT_IDLE_TIMEOUT_MS;
+    if (funcArg.GetArgc() >= NARG_CNT::ONE) {
+        auto [succ, number] = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
+        if (!succ || number < 0) {
+            HILOG_ERROR("Invalid idleMs");
+            NError(E_PARAMS).ThrowErr(env);
+            return nullptr;
+        }
+        idleMs = number;
+    }
+    if (funcArg.GetArgc() == NARG_CNT::TWO) {
+        auto [succ, number] = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
+        if (!succ || number < 0) {
+            HILOG_ERROR("Invalid timeoutMs");
+            NError(E_PARAMS).ThrowErr(env);
+            return nullptr;
+        }
+        timeoutMs = number;
+    }
+
+    auto ret = make_shared<bool>(false);
+    auto cbExec = [driver, idleMs, timeoutMs, ret]() -> NError {
+        *ret = driver->WaitForIdle(idleMs, timeoutMs);
+        return NError(ERRNO_NOERR);
+    };
+
+    auto cbCompl = [ret](napi_env env, NError err) -> NVal {
+        if (err) {
+            return { env, err.GetNapiErr(env) };
+        }
+        HILOG_DEBUG("WaitForIdle Success!");
+        return NVal::CreateBool(env, *ret);
+    };
+
+    NVal thisVar(env, funcArg.GetThisVar());
+    string procedureName = "WaitForIdle";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
+}
+
+napi_value DriverNExporter::SetIdleSettle(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("SetIdleSettle begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgs(NARG_CNT::ONE)) {
+        HILOG_ERROR("SetIdleSettle Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto [succ, enable] = NVal(env, funcArg[NARG_POS::FIRST]).ToBool();
+    if (!succ) {
+        HILOG_ERROR("Invalid enable");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    Driver::SetIdleSettle(enable);
+    return NVal::CreateUndefined(env).val_;
+}
+
+static bool ParseMonkeyOptions(const NVal& jsOptions, MonkeyOptions& options)
+{
+    if (!jsOptions.TypeIs(napi_object)) {
+        return false;
+    }
+    if (jsOptions.HasProp("seed")) {
+        auto [succ, seed] = jsOptions.GetProp("seed").ToInt64();
+        if (!succ) {
+            return false;
+        }
+        options.seed = static_cast<uint64_t>(seed);
+    }
+    if (!GetBatchUint(jsOptions, "actions", options.actions, false) ||
+        !GetBatchUint(jsOptions, "rate", options.actionsPerSecond, false) ||
+        !GetBatchUint(jsOptions, "snapshotInterval", options.snapshotInterval, false) ||
+        !GetBatchUint(jsOptions, "targetPercent", options.targetPercent, false)) {
+        return false;
+    }
+    if (jsOptions.HasProp("weights")) {
+        NVal weights = jsOptions.GetProp("weights");
+        if (!weights.TypeIs(napi_object)) {
+            return false;
+        }
+        for (int32_t type = 0; type < MONKEY_ACTION_COUNT; type++) {
+            const char* name = Monkey::GetActionName(static_cast<MonkeyActionType>(type));
+            if (!GetBatchUint(weights, name, options.weights[type], false)) {
+                return false;
+            }
+        }
+    }
+    if (jsOptions.HasProp("tracePath")) {
+        auto [succ, path, ignore] = jsOptions.GetProp("tracePath").ToUTF8String();
+        if (!succ) {
+            return false;
+        }
+        options.tracePath = path.get();
+    }
+    return true;
+}
+
+static NVal CreateMonkeyResult(napi_env env, const MonkeyResult& result)
+{
+    NVal obj = NVal::CreateObject(env);
+    obj.AddProp("actions", NVal::CreateInt64(env, result.actions).val_);
+    obj.AddProp("distinctStates", NVal::CreateInt64(env, result.distinctStates).val_);
+    obj.AddProp("snapshots", NVal::CreateInt64(env, result.snapshots).val_);
+    obj.AddProp("totalUs", NVal::CreateInt64(env, result.totalUs).val_);
+    NVal counts = NVal::CreateObject(env);
+    for (int32_t type = 0; type < MONKEY_ACTION_COUNT; type++) {
+        counts.AddProp(Monkey::GetActionName(static_cast<MonkeyActionType>(type)),
+            NVal::CreateInt64(env, result.actionCounts[type]).val_);
+    }
+    obj.AddProp("counts", counts.val_);
+    return obj;
+}
+
+napi_value DriverNExporter::RunMonkey(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("RunMonkey begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgsWithCallOptions(NARG_CNT::ZERO, NARG_CNT::ONE)) {
+        HILOG_ERROR("RunMonkey Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
+    if (!driver) {
+        HILOG_ERROR("Cannot get entity of driver");
+        return nullptr;
+    }
+
+    MonkeyOptions options;
+    if (funcArg.GetArgc() == NARG_CNT::ONE && !ParseMonkeyOptions(NVal(env, funcArg[NARG_POS::FIRST]), options)) {
+        HILOG_ERROR("RunMonkey Invalid options");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto monkey = make_shared<Monkey>(options);
+    auto result = make_shared<MonkeyResult>();
+    auto cbExec = [driver, monkey, result]() -> NError {
+        *result = monkey->Run(*driver);
+        return NError(ERRNO_NOERR);
+    };
+
+    auto cbCompl = [result](napi_env env, NError err) -> NVal {
+        if (err) {
+            return { env, err.GetNapiErr(env) };
+        }
+        HILOG_DEBUG("RunMonkey Success!");
+        return CreateMonkeyResult(env, *result);
+    };
+
+    NVal thisVar(env, funcArg.GetThisVar());
+    string procedureName = "RunMonkey";
+    return NAsyncWorkOrdered(env, thisVar, PostTo(driver->GetExecutor()), CallCancelGuard::Create(env, funcArg))
+        .Schedule(procedureName, cbExec, cbCompl).val_;
+}
+
+napi_value DriverNExporter::SetInjectRate(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("SetInjectRate begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgs(NARG_CNT::ONE, NARG_CNT::FOUR)) {
+        HILOG_ERROR("SetInjectRate Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    InjectLimitOptions options;
+    auto [succ, rate] = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
+    if (!succ || rate < 0) {
+        HILOG_ERROR("Invalid eventsPerSecond");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    options.eventsPerSecond = static_cast<uint32_t>(rate);
+    if (funcArg.GetArgc() >= NARG_CNT::TWO) {
+        auto [succBackpressure, backpressure] = NVal(env, funcArg[NARG_POS::SECOND]).ToBool();
+        if (!succBackpressure) {
+            HILOG_ERROR("Invalid backpressure");
+            NError(E_PARAMS).ThrowErr(env);
+            return nullptr;
+        }
+        options.backpressure = backpressure;
+    }
+    if (funcArg.GetArgc() >= NARG_CNT::THREE) {
+        auto [succBurst, burst] = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
+        if (!succBurst || burst < 0) {
+            HILOG_ERROR("Invalid burst");
+            NError(E_PARAMS).ThrowErr(env);
+            return nullptr;
+        }
+        options.burst = static_cast<uint32_t>(burst);
+    }
+    if (funcArg.GetArgc() == NARG_CNT::FOUR) {
+        auto [succTimeout, timeoutMs] = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt32();
+        if (!succTimeout || timeoutMs <= 0 || static_cast<uint32_t>(timeoutMs) > BACKPRESSURE_TIMEOUT_MAX_MS) {
+            HILOG_ERROR("Invalid backpressureTimeoutMs");
+            NError(E_PARAMS).ThrowErr(env);
+            return nullptr;
+        }
+        options.backpressureTimeoutMs = static_cast<uint32_t>(timeoutMs);
+    }
+    InjectLimiter::GetInstance().Configure(options);
+    return NVal::CreateUndefined(env).val_;
+}
+
+napi_value DriverNExporter::GetMetrics(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("GetMetrics begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgs(NARG_CNT::ZERO)) {
+        HILOG_ERROR("GetMetrics Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+
+    auto metrics = UiMetrics::GetInstance().Dump();
+    OrderedExecutor::DumpMetrics(metrics);
+    InjectLimiter::DumpMetrics(metrics);
+    NVal obj = NVal::CreateObject(env);
+    for (auto& [name, value] : metrics) {
+        obj.AddProp(name, NVal::CreateInt64(env, value).val_);
+    }
+    return obj.val_;
+}
+
+static constexpr const char* EVENT_COMPONENT_APPEAR = "componentAppear";
+static constexpr const char* EVENT_COMPONENT_DISAPPEAR = "componentDisappear";
+static constexpr const char* EVENT_SCREEN_CHANGED = "screenChanged";
+
+/**
+ * The driver.on subscriptions of one env. Every event of the UiMonitor comes back to the js thread
+ * through the one threadsafe function of the env, which is unref'd so subscriptions alone do not keep
+ * the loop alive. The subscriptions are only touched on the js thread.
+ **/
+struct UiEventChannel {
+    struct Subscription {
+        UiEventType type;
+        napi_ref callback;
+        shared_ptr<OrderedExecutor> executor;
+    };
+    napi_threadsafe_function tsfn = nullptr;
+    map<uint32_t, Subscription> subscriptions;
+};
+
+static unordered_map<napi_env, unique_ptr<UiEventChannel>>& GetUiEventChannels()
+{
+    static thread_local unordered_map<napi_env, unique_ptr<UiEventChannel>> channels;
+    return channels;
+}
+
+static void RemoveSubscription(napi_env env, UiEventChannel& channel, uint32_t watchId)
+{
+    UiMonitor::GetInstance().Unwatch(watchId);
+    auto found = channel.subscriptions.find(watchId);
+    if (found != channel.subscriptions.end()) {
+        napi_delete_reference(env, found->second.callback);
+        channel.subscriptions.erase(found);
+    }
+}
+
+// runs before the threadsafe function is finalized, after it no sink posts to the function any more
+static void RemoveUiEventChannel(void* arg)
+{
+    auto env = static_cast<napi_env>(arg);
+    auto& channels = GetUiEventChannels();
+    auto found = channels.find(env);
+    if (found == channels.end()) {
+        return;
+    }
+    auto& channel = *found->second;
+    while (!channel.subscriptions.empty()) {
+        RemoveSubscription(env, channel, channel.subscriptions.begin()->first);
+    }
+    napi_release_threadsafe_function(channel.tsfn, napi_tsfn_abort);
+    channels.erase(found);
+}
+
+static void OnUiEvent(napi_env env, napi_value jsCb, void* context, void* data)
+{
+    unique_ptr<UiEvent> event(static_cast<UiEvent*>(data));
+    if (env == nullptr) {
+        return;
+    }
+    auto& channel = *static_cast<UiEventChannel*>(context);
+    // events already queued when the subscription was removed are dropped
+    auto found = channel.subscriptions.find(event->watchId);
+    if (found == channel.subscriptions.end()) {
+        return;
+    }
+    napi_value callback = nullptr;
+    napi_get_reference_value(env, found->second.callback, &callback);
+    vector<napi_value> argv;
+    if (event->component != nullptr) {
+        napi_value jsComponent = NClass::InstantiateClass(env, COMPONENT_CLASS_ID, {});
+        event->component->SetExecutor(found->second.executor);
+        if (jsComponent == nullptr || !NClass::SetEntityFor<Component>(env, jsComponent, move(event->component))) {
+            HILOG_ERROR("Failed to set Component entity of the ui event");
+            return;
+        }
+        argv.push_back(jsComponent);
+    }
+    napi_value result = nullptr;
+    napi_call_function(env, NVal::CreateUndefined(env).val_, callback, argv.size(), argv.data(), &result);
+}
+
+static UiEventChannel* GetUiEventChannel(napi_env env)
+{
+    auto& channels = GetUiEventChannels();
+    auto found = channels.find(env);
+    if (found != channels.end()) {
+        return found->second.get();
+    }
+    auto channel = make_unique<UiEventChannel>();
+    napi_value resource = NVal::CreateUTF8String(env, "UiEvent").val_;
+    napi_status status = napi_create_threadsafe_function(env, nullptr, nullptr, resource, 0, 1, nullptr, nullptr,
+        channel.get(), OnUiEvent, &channel->tsfn);
+    if (status != napi_ok) {
+        HILOG_ERROR("INNER BUG. Cannot create threadsafe function for %{public}d", status);
+        return nullptr;
+    }
+    napi_unref_threadsafe_function(env, channel->tsfn);
+    // cleanup hooks run in reverse order, this one before the one finalizing the function
+    napi_add_env_cleanup_hook(env, RemoveUiEventChannel, env);
+    return channels.emplace(env, move(channel)).first->second.get();
+}
+
+static bool ParseUiEventType(napi_env env, napi_value value, UiEventType& type)
+{
+    auto [succ, name, ignore] = NVal(env, value).ToUTF8String();
+    if (!succ) {
+        return false;
+    }
+    static const map<string, UiEventType> types = {
+        { EVENT_COMPONENT_APPEAR, UI_EVENT_COMPONENT_APPEAR },
+        { EVENT_COMPONENT_DISAPPEAR, UI_EVENT_COMPONENT_DISAPPEAR },
+        { EVENT_SCREEN_CHANGED, UI_EVENT_SCREEN_CHANGED },
+    };
+    auto found = types.find(name.get());
+    if (found == types.end()) {
+        return false;
+    }
+    type = found->second;
+    return true;
+}
+
+napi_value DriverNExporter::OnEvent(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("OnEvent begin");
+    NFuncArg funcArg(env, info);
+    UiEventType type = UI_EVENT_SCREEN_CHANGED;
+    if (!funcArg.InitArgs(NARG_CNT::TWO, NARG_CNT::THREE) ||
+        !ParseUiEventType(env, funcArg[NARG_POS::FIRST], type)) {
+        HILOG_ERROR("OnEvent Invalid event type or number of arguments");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    // on(type, on, callback) for components, on('screenChanged', callback) for the screen
+    const bool screen = type == UI_EVENT_SCREEN_CHANGED;
+    if (funcArg.GetArgc() != (screen ? NARG_CNT::TWO : NARG_CNT::THREE)) {
+        HILOG_ERROR("OnEvent Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    On* on = nullptr;
+    if (!screen) {
+        on = NClass::GetEntityOf<On>(env, NVal(env, funcArg[NARG_POS::SECOND]).val_);
+        if (!on) {
+            HILOG_ERROR("Cannot get entity of on");
+            NError(E_PARAMS).ThrowErr(env);
+            return nullptr;
+        }
+    }
+    NVal callback(env, funcArg[screen ? NARG_POS::SECOND : NARG_POS::THIRD]);
+    if (!callback.TypeIs(napi_function)) {
+        HILOG_ERROR("OnEvent callback is not a function");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    auto driver = NClass::GetEntityOf<Driver>(env, funcArg.GetThisVar());
+    if (!driver) {
+        HILOG_ERROR("Cannot get entity of driver");
+        NError(E_DESTROYED).ThrowErr(env);
+        return nullptr;
+    }
+    auto channel = GetUiEventChannel(env);
+    if (channel == nullptr) {
+        NError(EIO).ThrowErr(env);
+        return nullptr;
+    }
+
+    napi_ref ref = nullptr;
+    napi_create_reference(env, callback.val_, 1, &ref);
+    auto tsfn = channel->tsfn;
+    uint32_t watchId = UiMonitor::GetInstance().Watch(type, on, [tsfn](UiEvent&& event) {
+        auto data = new UiEvent(move(event));
+        if (napi_call_threadsafe_function(tsfn, data, napi_tsfn_nonblocking) != napi_ok) {
+            delete data;
+        }
+    });
+    // the first event is handled on this thread, after this call returned
+    channel->subscriptions[watchId] = { type, ref, driver->GetExecutor() };
+    HILOG_DEBUG("OnEvent end, watch %{public}u", watchId);
+    return NVal::CreateUndefined(env).val_;
+}
+
+napi_value DriverNExporter::OffEvent(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("OffEvent begin");
+    NFuncArg funcArg(env, info);
+    UiEventType type = UI_EVENT_SCREEN_CHANGED;
+    if (!funcArg.InitArgs(NARG_CNT::ONE, NARG_CNT::TWO) ||
+        !ParseUiEventType(env, funcArg[NARG_POS::FIRST], type)) {
+        HILOG_ERROR("OffEvent Invalid event type or number of arguments");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    napi_value callback = nullptr;
+    if (funcArg.GetArgc() == NARG_CNT::TWO) {
+        callback = funcArg[NARG_POS::SECOND];
+        if (!NVal(env, callback).TypeIs(napi_function)) {
+            HILOG_ERROR("OffEvent callback is not a function");
+            NError(E_PARAMS).ThrowErr(env);
+            return nullptr;
+        }
+    }
+    auto& channels = GetUiEventChannels();
+    auto found = channels.find(env);
+    if (found == channels.end()) {
+        return NVal::CreateUndefined(env).val_;
+    }
+    // without a callback every subscription of the type is removed
+    auto& channel = *found->second;
+    vector<uint32_t> removed;
+    for (auto& [watchId, subscription] : channel.subscriptions) {
+        if (subscription.type != type) {
+            continue;
+        }
+        bool equal = callback == nullptr;
+        if (!equal) {
+            napi_value subscribed = nullptr;
+            napi_get_reference_value(env, subscription.callback, &subscribed);
+            napi_strict_equals(env, subscribed, callback, &equal);
+        }
+        if (equal) {
+            removed.push_back(watchId);
+        }
+    }
+    for (auto watchId : removed) {
+        RemoveSubscription(env, channel, watchId);
+    }
+    HILOG_DEBUG("OffEvent end, removed %{public}zu", removed.size());
+    return NVal::CreateUndefined(env).val_;
+}
+
+napi_value DriverNExporter::SetMonitorInterval(napi_env env, napi_callback_info info)
+{
+    HILOG_DEBUG("SetMonitorInterval begin");
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgs(NARG_CNT::ONE)) {
+        HILOG_ERROR("SetMonitorInterval Number of arguments unmatched");
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    auto [succ, intervalMs] = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
+    if (!succ || intervalMs < static_cast<int32_t>(MONITOR_INTERVAL_MIN_MS) ||
+        intervalMs > static_cast<int32_t>(MONITOR_INTERVAL_MAX_MS)) {
+        HILOG_ERROR("SetMonitorInterval intervalMs must be in [%{public}u, %{public}u]", MONITOR_INTERVAL_MIN_MS,
+            MONITOR_INTERVAL_MAX_MS);
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    UiMonitor::GetInstance().SetIntervalMs(static_cast<uint32_t>(intervalMs));
+    return NVal::CreateUndefined(env).val_;
 }
 
 static napi_value DriverInitializer(napi_env env, napi_callback_info info)
@@ -1968,16 +4478,43 @@ bool DriverNExporter::Export()
         NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_DELAY_MS, DriverNExporter::DelayMs),
         NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_PRESS_BACK, DriverNExporter::PressBack),
         NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_ASSERT_COMPONENT, DriverNExporter::AssertComponentExist),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_MULTI_CLICK, DriverNExporter::MultiClick),
         NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_FIND_COMPONENT, DriverNExporter::FindComponent),
         NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_FIND_COMPONENTS, DriverNExporter::FindComponents),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_FIND_COMPONENTS_COLUMNAR,
+            DriverNExporter::FindComponentsColumnar),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_FIND_COMPONENTS_ITER, DriverNExporter::FindComponentsIter),
         NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_CLICK, DriverNExporter::Click),
         NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_DOUBLE_CLICK, DriverNExporter::DoubleClick),
         NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_LONG_CLICK, DriverNExporter::LongClick),
         NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_SWIPE, DriverNExporter::Swipe),
         NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_FLING, DriverNExporter::Fling),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_MULTI_SWIPE, DriverNExporter::MultiSwipe),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_TWO_FINGER_PAN, DriverNExporter::TwoFingerPan),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_MOUSE_MOVE, DriverNExporter::MouseMove),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_MOUSE_CLICK, DriverNExporter::MouseClick),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_MOUSE_SCROLL, DriverNExporter::MouseScroll),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_DRAG, DriverNExporter::Drag),
         NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_TRIGGER_KEY, DriverNExporter::TriggerKey),
         NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_TRIGGER_COMBINE_KEYS, DriverNExporter::TriggerCombineKeys),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_TRIGGER_KEYS, DriverNExporter::TriggerKeys),
         NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_INJECT_MULTI_POINTER_ACTION, DriverNExporter::InjectMultiPointerAction),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_WAIT_FOR_COMPONENT, DriverNExporter::WaitForComponent),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_WAIT_FOR_COMPONENT_DISAPPEAR,
+            DriverNExporter::WaitForComponentDisappear),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_RUN_BATCH, DriverNExporter::RunBatch),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_START_RECORDING, DriverNExporter::StartRecording),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_STOP_RECORDING, DriverNExporter::StopRecording),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_REPLAY, DriverNExporter::Replay),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_WAIT_FOR_IDLE, DriverNExporter::WaitForIdle),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_SET_IDLE_SETTLE, DriverNExporter::SetIdleSettle),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_GET_METRICS, DriverNExporter::GetMetrics),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_SET_INJECT_RATE, DriverNExporter::SetInjectRate),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_RUN_MONKEY, DriverNExporter::RunMonkey),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_ON, DriverNExporter::OnEvent),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_OFF, DriverNExporter::OffEvent),
+        NVal::DeclareNapiFunction(DriverNExporter::FUNCTION_SET_MONITOR_INTERVAL,
+            DriverNExporter::SetMonitorInterval),
     };
     auto [succ, classValue] = NClass::DefineClass(exports_.env_, DriverNExporter::DRIVER_CLASS_NAME, DriverInitializer,
         std::move(props));
@@ -2049,7 +4586,7 @@ napi_value PointerMatrixNExporter::Create(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    napi_value jsMatrix = NClass::InstantiateClass(env, PointerMatrixNExporter::POINTER_MATRIX_CLASS_NAME, {});
+    napi_value jsMatrix = NClass::InstantiateClass(env, POINTER_MATRIX_CLASS_ID, {});
     if (!jsMatrix) {
         HILOG_ERROR("Failed to instantiate jsMatrix class");
         return nullptr;
@@ -2155,7 +4692,7 @@ bool PointerMatrixNExporter::Export()
         return false;
     }
 
-    napi_value pMtr = NClass::InstantiateClass(exports_.env_, PointerMatrixNExporter::POINTER_MATRIX_CLASS_NAME, {});
+    napi_value pMtr = NClass::InstantiateClass(exports_.env_, POINTER_MATRIX_CLASS_ID, {});
     if (!pMtr) {
         HILOG_ERROR("Failed to instantiate ON class");
         return false;
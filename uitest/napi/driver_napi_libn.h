@@ -101,6 +101,22 @@ public:
     static napi_value GetBounds(napi_env env, napi_callback_info info);
     static napi_value PinchOut(napi_env env, napi_callback_info info);
     static napi_value PinchIn(napi_env env, napi_callback_info info);
+    static napi_value Rotate(napi_env env, napi_callback_info info);
+    static napi_value Pinch(napi_env env, napi_callback_info info);
+    static napi_value GetIdSync(napi_env env, napi_callback_info info);
+    static napi_value GetTextSync(napi_env env, napi_callback_info info);
+    static napi_value GetTypeSync(napi_env env, napi_callback_info info);
+    static napi_value IsClickableSync(napi_env env, napi_callback_info info);
+    static napi_value IsLongClickableSync(napi_env env, napi_callback_info info);
+    static napi_value IsScrollableSync(napi_env env, napi_callback_info info);
+    static napi_value IsEnabledSync(napi_env env, napi_callback_info info);
+    static napi_value IsFocusedSync(napi_env env, napi_callback_info info);
+    static napi_value IsSelectedSync(napi_env env, napi_callback_info info);
+    static napi_value IsCheckedSync(napi_env env, napi_callback_info info);
+    static napi_value IsCheckableSync(napi_env env, napi_callback_info info);
+    static napi_value GetBoundsSync(napi_env env, napi_callback_info info);
+    static napi_value GetBoundsCenterSync(napi_env env, napi_callback_info info);
+    static napi_value Attributes(napi_env env, napi_callback_info info);
 
     static constexpr const char* COMPONENT_CLASS_NAME = "Component";
     static constexpr const char* FUNCTION_CLICK = "click";
@@ -126,6 +142,22 @@ public:
     static constexpr const char* FUNCTION_GET_BOUNDS = "getBounds";
     static constexpr const char* FUNCTION_PINCH_OUT = "pinchOut";
     static constexpr const char* FUNCTION_PINCH_IN = "pinchIn";
+    static constexpr const char* FUNCTION_ROTATE = "rotate";
+    static constexpr const char* FUNCTION_PINCH = "pinch";
+    static constexpr const char* FUNCTION_GET_ID_SYNC = "getIdSync";
+    static constexpr const char* FUNCTION_GET_TEXT_SYNC = "getTextSync";
+    static constexpr const char* FUNCTION_GET_TYPE_SYNC = "getTypeSync";
+    static constexpr const char* FUNCTION_IS_CLICKABLE_SYNC = "isClickableSync";
+    static constexpr const char* FUNCTION_IS_LONG_CLICKABLE_SYNC = "isLongClickableSync";
+    static constexpr const char* FUNCTION_IS_SCROLLABLE_SYNC = "isScrollableSync";
+    static constexpr const char* FUNCTION_IS_ENABLED_SYNC = "isEnabledSync";
+    static constexpr const char* FUNCTION_IS_FOCUSED_SYNC = "isFocusedSync";
+    static constexpr const char* FUNCTION_IS_SELECTED_SYNC = "isSelectedSync";
+    static constexpr const char* FUNCTION_IS_CHECKED_SYNC = "isCheckedSync";
+    static constexpr const char* FUNCTION_IS_CHECKABLE_SYNC = "isCheckableSync";
+    static constexpr const char* FUNCTION_GET_BOUNDS_SYNC = "getBoundsSync";
+    static constexpr const char* FUNCTION_GET_BOUNDS_CENTER_SYNC = "getBoundsCenterSync";
+    static constexpr const char* PROPERTY_ATTRIBUTES = "attributes";
 };
 
 class DriverNExporter final : public LibN::NExporter {
@@ -142,14 +174,38 @@ public:
     static napi_value AssertComponentExist(napi_env env, napi_callback_info info);
     static napi_value FindComponent(napi_env env, napi_callback_info info);
     static napi_value FindComponents(napi_env env, napi_callback_info info);
+    static napi_value FindComponentsColumnar(napi_env env, napi_callback_info info);
+    static napi_value FindComponentsIter(napi_env env, napi_callback_info info);
     static napi_value Click(napi_env env, napi_callback_info info);
     static napi_value DoubleClick(napi_env env, napi_callback_info info);
     static napi_value LongClick(napi_env env, napi_callback_info info);
+    static napi_value MultiClick(napi_env env, napi_callback_info info);
     static napi_value Swipe(napi_env env, napi_callback_info info);
     static napi_value Fling(napi_env env, napi_callback_info info);
+    static napi_value MultiSwipe(napi_env env, napi_callback_info info);
+    static napi_value TwoFingerPan(napi_env env, napi_callback_info info);
+    static napi_value MouseMove(napi_env env, napi_callback_info info);
+    static napi_value MouseClick(napi_env env, napi_callback_info info);
+    static napi_value MouseScroll(napi_env env, napi_callback_info info);
+    static napi_value Drag(napi_env env, napi_callback_info info);
     static napi_value TriggerKey(napi_env env, napi_callback_info info);
     static napi_value TriggerCombineKeys(napi_env env, napi_callback_info info);
+    static napi_value TriggerKeys(napi_env env, napi_callback_info info);
     static napi_value InjectMultiPointerAction(napi_env env, napi_callback_info info);
+    static napi_value WaitForComponent(napi_env env, napi_callback_info info);
+    static napi_value WaitForComponentDisappear(napi_env env, napi_callback_info info);
+    static napi_value RunBatch(napi_env env, napi_callback_info info);
+    static napi_value StartRecording(napi_env env, napi_callback_info info);
+    static napi_value StopRecording(napi_env env, napi_callback_info info);
+    static napi_value Replay(napi_env env, napi_callback_info info);
+    static napi_value WaitForIdle(napi_env env, napi_callback_info info);
+    static napi_value SetIdleSettle(napi_env env, napi_callback_info info);
+    static napi_value GetMetrics(napi_env env, napi_callback_info info);
+    static napi_value SetInjectRate(napi_env env, napi_callback_info info);
+    static napi_value RunMonkey(napi_env env, napi_callback_info info);
+    static napi_value OnEvent(napi_env env, napi_callback_info info);
+    static napi_value OffEvent(napi_env env, napi_callback_info info);
+    static napi_value SetMonitorInterval(napi_env env, napi_callback_info info);
 
     static constexpr const char* DRIVER_CLASS_NAME = "Driver";
     static constexpr const char* FUNCTION_CREATE = "create";
@@ -158,14 +214,38 @@ public:
     static constexpr const char* FUNCTION_ASSERT_COMPONENT = "assertComponentExist";
     static constexpr const char* FUNCTION_FIND_COMPONENT = "findComponent";
     static constexpr const char* FUNCTION_FIND_COMPONENTS = "findComponents";
+    static constexpr const char* FUNCTION_FIND_COMPONENTS_COLUMNAR = "findComponentsColumnar";
+    static constexpr const char* FUNCTION_FIND_COMPONENTS_ITER = "findComponentsIter";
     static constexpr const char* FUNCTION_CLICK = "click";
     static constexpr const char* FUNCTION_DOUBLE_CLICK = "doubleClick";
     static constexpr const char* FUNCTION_LONG_CLICK = "longClick";
+    static constexpr const char* FUNCTION_MULTI_CLICK = "multiClick";
     static constexpr const char* FUNCTION_SWIPE = "swipe";
     static constexpr const char* FUNCTION_FLING = "fling";
+    static constexpr const char* FUNCTION_MULTI_SWIPE = "multiSwipe";
+    static constexpr const char* FUNCTION_TWO_FINGER_PAN = "twoFingerPan";
+    static constexpr const char* FUNCTION_MOUSE_MOVE = "mouseMove";
+    static constexpr const char* FUNCTION_MOUSE_CLICK = "mouseClick";
+    static constexpr const char* FUNCTION_MOUSE_SCROLL = "mouseScroll";
+    static constexpr const char* FUNCTION_DRAG = "drag";
     static constexpr const char* FUNCTION_TRIGGER_KEY = "triggerKey";
     static constexpr const char* FUNCTION_TRIGGER_COMBINE_KEYS = "triggerCombineKeys";
+    static constexpr const char* FUNCTION_TRIGGER_KEYS = "triggerKeys";
     static constexpr const char* FUNCTION_INJECT_MULTI_POINTER_ACTION = "injectMultiPointerAction";
+    static constexpr const char* FUNCTION_WAIT_FOR_COMPONENT = "waitForComponent";
+    static constexpr const char* FUNCTION_WAIT_FOR_COMPONENT_DISAPPEAR = "waitForComponentDisappear";
+    static constexpr const char* FUNCTION_RUN_BATCH = "runBatch";
+    static constexpr const char* FUNCTION_START_RECORDING = "startRecording";
+    static constexpr const char* FUNCTION_STOP_RECORDING = "stopRecording";
+    static constexpr const char* FUNCTION_REPLAY = "replay";
+    static constexpr const char* FUNCTION_WAIT_FOR_IDLE = "waitForIdle";
+    static constexpr const char* FUNCTION_SET_IDLE_SETTLE = "setIdleSettle";
+    static constexpr const char* FUNCTION_GET_METRICS = "getMetrics";
+    static constexpr const char* FUNCTION_SET_INJECT_RATE = "setInjectRate";
+    static constexpr const char* FUNCTION_RUN_MONKEY = "runMonkey";
+    static constexpr const char* FUNCTION_ON = "on";
+    static constexpr const char* FUNCTION_OFF = "off";
+    static constexpr const char* FUNCTION_SET_MONITOR_INTERVAL = "setMonitorInterval";
 };
 
 class PointerMatrixNExporter final : public LibN::NExporter {
@@ -16,17 +16,41 @@
 #ifndef UITEST_LIBN_N_ASYNC_CONTEXT_H
 #define UITEST_LIBN_N_ASYNC_CONTEXT_H
 
+#include <cstddef>
 #include <functional>
+#include <memory>
 
 #include "n_error.h"
+#include "n_inline_function.h"
 #include "n_ref.h"
 #include "n_val.h"
 
 namespace OHOS {
 namespace UiTest {
 namespace LibN {
-using NContextCBExec = std::function<NError()>;
-using NContextCBComplete = std::function<NVal(napi_env, NError)>;
+// bytes of captures kept inside the context, larger lambdas are heap allocated
+constexpr size_t N_CONTEXT_CB_INLINE_SIZE = 64;
+using NContextCBExec = NInlineFunction<NError(), N_CONTEXT_CB_INLINE_SIZE>;
+using NContextCBComplete = NInlineFunction<NVal(napi_env, NError), N_CONTEXT_CB_INLINE_SIZE>;
+// bytes of every promise context a NTaskPoster may use to queue the exec step of an ordered work
+constexpr size_t N_TASK_SLOT_SIZE = 32;
+// rejects the promise of a call ahead of its work, js thread only
+using NAsyncReject = std::function<void(napi_env, NError)>;
+
+/**
+ * Hooks around one async call, e.g. to make it cancellable. Arm runs on the js thread once the call is
+ * scheduled, the guard may keep reject to settle the promise early while the work is still queued.
+ * Exec runs on the executing thread in place of the exec callback and may replace its error, Complete
+ * runs on the js thread before the promise settles, or when the work finishes after an early reject.
+ * The guard is destroyed on the js thread together with the rest of the call.
+ **/
+class NAsyncGuard {
+public:
+    virtual ~NAsyncGuard() = default;
+    virtual void Arm(napi_env env, NAsyncReject reject) {}
+    virtual NError Exec(const NContextCBExec &cbExec) = 0;
+    virtual void Complete(napi_env env) {}
+};
 
 class NAsyncContext {
 public:
@@ -36,19 +60,59 @@ public:
     NContextCBComplete cbComplete_;
     napi_async_work awork_;
     NRef thisPtr_;
+    std::unique_ptr<NAsyncGuard> guard_;
+    // the promise was rejected early, the result of the work is dropped
+    bool settled_ = false;
 
     NAsyncContext(NVal thisPtr)
         : err_(0), res_(NVal()), cbExec_(nullptr), cbComplete_(nullptr), awork_(nullptr), thisPtr_(thisPtr)
     {
     }
     virtual ~NAsyncContext() = default;
+
+    NError RunExec()
+    {
+        if (guard_ != nullptr) {
+            return guard_->Exec(cbExec_);
+        }
+        return cbExec_ != nullptr ? cbExec_() : NError(ERRNO_NOERR);
+    }
+
+    void RunComplete(napi_env env)
+    {
+        if (guard_ != nullptr) {
+            guard_->Complete(env);
+        }
+        if (cbComplete_ != nullptr && !settled_) {
+            res_ = cbComplete_(env, err_);
+        }
+    }
 };
 
 class NAsyncContextPromise : public NAsyncContext {
 public:
     napi_deferred deferred_ = nullptr;
+    // ordered work only: where the result goes back to the js thread, and the poster's room for the task
+    napi_env env_ = nullptr;
+    napi_threadsafe_function tsfn_ = nullptr;
+    alignas(std::max_align_t) unsigned char taskSlot_[N_TASK_SLOT_SIZE] {};
     explicit NAsyncContextPromise(NVal thisPtr) : NAsyncContext(thisPtr) {}
     ~NAsyncContextPromise() = default;
+
+    // hands the guard a reject that settles deferred_ at most once, the work still completes as usual
+    void ArmGuard(napi_env env)
+    {
+        if (guard_ == nullptr) {
+            return;
+        }
+        guard_->Arm(env, [this](napi_env rejectEnv, NError err) {
+            if (settled_) {
+                return;
+            }
+            settled_ = true;
+            napi_reject_deferred(rejectEnv, deferred_, err.GetNapiErr(rejectEnv));
+        });
+    }
 };
 
 class NAsyncContextCallback : public NAsyncContext {
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UITEST_LIBN_N_ASYNC_CONTEXT_POOL_H
+#define UITEST_LIBN_N_ASYNC_CONTEXT_POOL_H
+
+#include "n_async_context.h"
+
+namespace OHOS {
+namespace UiTest {
+namespace LibN {
+/**
+ * Free list of promise contexts of each env, a released context keeps its napi_async_work
+ * so the next promise work of the env queues it again instead of creating a new one.
+ * Contexts are acquired and released on the js thread of their env only, the pool is thread_local.
+ **/
+class NAsyncContextPool final {
+public:
+    static NAsyncContextPromise *Acquire(napi_env env, NVal thisPtr);
+    // reset ctx and keep it for reuse, ctx must no longer be queued
+    static void Release(napi_env env, NAsyncContextPromise *ctx);
+};
+} // namespace LibN
+} // namespace UiTest
+} // namespace OHOS
+
+#endif // UITEST_LIBN_N_ASYNC_CONTEXT_POOL_H
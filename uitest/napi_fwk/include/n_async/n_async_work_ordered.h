@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UITEST_LIBN_N_ASYNC_WORK_ORDERED_H
+#define UITEST_LIBN_N_ASYNC_WORK_ORDERED_H
+
+#include <memory>
+
+#include "node_api.h"
+#include "js_native_api_types.h"
+#include "n_async_context.h"
+#include "n_async_work.h"
+#include "n_val.h"
+
+namespace OHOS {
+namespace UiTest {
+namespace LibN {
+using NTaskRun = void (*)(void *arg);
+
+/**
+ * Hands the exec step of an ordered work to the thread (or queue) that must run it, steps posted to one
+ * poster run in order. Post is called once per work and must not allocate: slot is N_TASK_SLOT_SIZE bytes
+ * of the pooled context of the work, free for the poster's queue node until run(arg) is called.
+ **/
+class NTaskPoster {
+public:
+    virtual ~NTaskPoster() = default;
+    // false when nothing would run a posted step, the work then goes to the libuv pool
+    virtual bool CanPost() const = 0;
+    virtual void Post(NTaskRun run, void *arg, void *slot) const = 0;
+};
+
+/**
+ * Promise based async work whose exec callback runs on the poster's thread instead of the libuv pool,
+ * the complete callback is brought back to the js thread with a threadsafe function of the env.
+ * Falls back to NAsyncWorkPromise when the poster cannot post.
+ **/
+class NAsyncWorkOrdered : public NAsyncWork {
+public:
+    // poster must outlive the call to Schedule
+    NAsyncWorkOrdered(napi_env env, NVal thisPtr, const NTaskPoster &poster,
+        std::unique_ptr<NAsyncGuard> guard = nullptr);
+    ~NAsyncWorkOrdered() = default;
+
+    NVal Schedule(std::string procedureName, NContextCBExec cbExec, NContextCBComplete cbComplete) final;
+
+private:
+    NVal thisPtr_;
+    const NTaskPoster &poster_;
+    std::unique_ptr<NAsyncGuard> guard_;
+};
+} // namespace LibN
+} // namespace UiTest
+} // namespace OHOS
+
+#endif // UITEST_LIBN_N_ASYNC_WORK_ORDERED_H
@@ -17,6 +17,7 @@
 #define UITEST_LIBN_N_ASYNC_WORK_PROMISE_H
 
 #include <iosfwd>
+#include <memory>
 
 #include "node_api.h"
 #include "js_native_api_types.h"
@@ -29,13 +30,14 @@ namespace UiTest {
 namespace LibN {
 class NAsyncWorkPromise : public NAsyncWork {
 public:
-    NAsyncWorkPromise(napi_env env, NVal thisPtr);
+    NAsyncWorkPromise(napi_env env, NVal thisPtr, std::unique_ptr<NAsyncGuard> guard = nullptr);
     ~NAsyncWorkPromise() = default;
 
     NVal Schedule(std::string procedureName, NContextCBExec cbExec, NContextCBComplete cbComplete) final;
 
 private:
-    NAsyncContextPromise *ctx_;
+    NVal thisPtr_;
+    std::unique_ptr<NAsyncGuard> guard_;
 };
 } // namespace LibN
 } // namespace UiTest
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UITEST_LIBN_N_INLINE_FUNCTION_H
+#define UITEST_LIBN_N_INLINE_FUNCTION_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace OHOS {
+namespace UiTest {
+namespace LibN {
+template <typename Signature, size_t Capacity> class NInlineFunction;
+
+/**
+ * Move only replacement of std::function storing callables up to Capacity bytes inside the object,
+ * larger ones (or ones that may throw when moved) fall back to the heap.
+ * Capacity is sized for the capture lists of the exporters, a few pointers and shared_ptrs.
+ **/
+template <typename R, typename... Args, size_t Capacity> class NInlineFunction<R(Args...), Capacity> {
+public:
+    NInlineFunction() = default;
+    NInlineFunction(std::nullptr_t) {}
+
+    template <typename F, typename Fn = std::decay_t<F>,
+        typename = std::enable_if_t<!std::is_same_v<Fn, NInlineFunction> && std::is_invocable_r_v<R, Fn &, Args...>>>
+    NInlineFunction(F &&f)
+    {
+        if constexpr (IsInline<Fn>()) {
+            new (&storage_) Fn(std::forward<F>(f));
+            ops_ = &InlineOps<Fn>::OPS;
+        } else {
+            *reinterpret_cast<Fn **>(&storage_) = new Fn(std::forward<F>(f));
+            ops_ = &HeapOps<Fn>::OPS;
+        }
+    }
+
+    NInlineFunction(NInlineFunction &&other) noexcept
+    {
+        MoveFrom(other);
+    }
+
+    NInlineFunction &operator=(NInlineFunction &&other) noexcept
+    {
+        if (this != &other) {
+            Reset();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+
+    NInlineFunction &operator=(std::nullptr_t)
+    {
+        Reset();
+        return *this;
+    }
+
+    NInlineFunction(const NInlineFunction &) = delete;
+    NInlineFunction &operator=(const NInlineFunction &) = delete;
+
+    ~NInlineFunction()
+    {
+        Reset();
+    }
+
+    R operator()(Args... args) const
+    {
+        return ops_->invoke(const_cast<void *>(static_cast<const void *>(&storage_)), std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const
+    {
+        return ops_ != nullptr;
+    }
+
+    bool operator==(std::nullptr_t) const
+    {
+        return ops_ == nullptr;
+    }
+
+    bool operator!=(std::nullptr_t) const
+    {
+        return ops_ != nullptr;
+    }
+
+private:
+    struct Ops {
+        R (*invoke)(void *storage, Args &&...args);
+        // move construct the callable at dst from src and destroy src
+        void (*relocate)(void *dst, void *src);
+        void (*destroy)(void *storage);
+    };
+
+    template <typename Fn> static constexpr bool IsInline()
+    {
+        return sizeof(Fn) <= Capacity && alignof(Fn) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible_v<Fn>;
+    }
+
+    template <typename Fn> struct InlineOps {
+        static R Invoke(void *storage, Args &&...args)
+        {
+            return (*static_cast<Fn *>(storage))(std::forward<Args>(args)...);
+        }
+        static void Relocate(void *dst, void *src)
+        {
+            new (dst) Fn(std::move(*static_cast<Fn *>(src)));
+            static_cast<Fn *>(src)->~Fn();
+        }
+        static void Destroy(void *storage)
+        {
+            static_cast<Fn *>(storage)->~Fn();
+        }
+        static constexpr Ops OPS = {Invoke, Relocate, Destroy};
+    };
+
+    template <typename Fn> struct HeapOps {
+        static R Invoke(void *storage, Args &&...args)
+        {
+            return (**static_cast<Fn **>(storage))(std::forward<Args>(args)...);
+        }
+        static void Relocate(void *dst, void *src)
+        {
+            *static_cast<Fn **>(dst) = *static_cast<Fn **>(src);
+        }
+        static void Destroy(void *storage)
+        {
+            delete *static_cast<Fn **>(storage);
+        }
+        static constexpr Ops OPS = {Invoke, Relocate, Destroy};
+    };
+
+    void MoveFrom(NInlineFunction &other)
+    {
+        if (other.ops_ != nullptr) {
+            other.ops_->relocate(&storage_, &other.storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    void Reset()
+    {
+        if (ops_ != nullptr) {
+            // clear first, the callable may own the last reference to this function's owner
+            const Ops *ops = ops_;
+            ops_ = nullptr;
+            ops->destroy(&storage_);
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[Capacity];
+    const Ops *ops_ = nullptr;
+};
+} // namespace LibN
+} // namespace UiTest
+} // namespace OHOS
+
+#endif // UITEST_LIBN_N_INLINE_FUNCTION_H
@@ -31,6 +31,8 @@ public:
 
     explicit operator bool() const;
     NVal Deref(napi_env env);
+    // drop the held reference and reference val instead, an empty val leaves the NRef empty
+    void Reset(NVal val = NVal());
 
 private:
     napi_env env_ = nullptr;
@@ -29,6 +29,10 @@
 namespace OHOS {
 namespace UiTest {
 namespace LibN {
+// process wide id of a class name, index of its constructor in the per env tables
+using NClassId = int32_t;
+constexpr NClassId INVALID_CLASS_ID = -1;
+
 class NClass final {
 public:
     NClass(const NClass &) = delete;
@@ -39,6 +43,10 @@ public:
                                                     napi_callback constructor,
                                                     std::vector<napi_property_descriptor> &&properties);
     static bool SaveClass(napi_env env, std::string className, napi_value exClass);
+    // id of className, assigned on first call, takes a lock so resolve it once and keep it
+    static NClassId GetClassId(const std::string& className);
+    static napi_value GetConstructor(napi_env env, NClassId classId);
+    static napi_value InstantiateClass(napi_env env, NClassId classId, const std::vector<napi_value>& args);
     static napi_value InstantiateClass(napi_env env, const std::string& className, const std::vector<napi_value>& args);
 
     template <class T> static T *GetEntityOf(napi_env env, napi_value objStat)
@@ -70,11 +78,19 @@ public:
     }
 
 private:
+    struct EnvClassTable {
+        napi_env env = nullptr;
+        std::vector<napi_ref> constructors;
+    };
+
     NClass() = default;
     ~NClass() = default;
     static NClass &GetInstance();
-    std::map<std::string, napi_ref> exClassMap;
-    std::mutex exClassMapLock;
+    static void RemoveEnv(void *arg);
+    EnvClassTable *FindTable(napi_env env);
+    // the instance is thread_local and an env is only used on its own js thread, so no lock is needed
+    std::vector<EnvClassTable> envClassTables;
+    size_t lastTable = 0;
 };
 } // namespace LibN
 } // namespace UiTest
@@ -45,6 +45,8 @@ enum ErrCodeSuffixOfArkUITest {
     E_ASSERTFAILD = ARKX_TEST_TAG + 3,
     E_DESTROYED = ARKX_TEST_TAG + 4,
     E_NOTSUPPORT = ARKX_TEST_TAG + 5,
+    E_CANCELLED = ARKX_TEST_TAG + 6,
+    E_TIMEOUT = ARKX_TEST_TAG + 7,
 };
 
 static inline std::unordered_map<int, std::pair<int32_t, std::string>> errCodeTable {
@@ -54,6 +56,8 @@ static inline std::unordered_map<int, std::pair<int32_t, std::string>> errCodeTa
     { E_ASSERTFAILD, { E_ASSERTFAILD, "The assertion is failed" } },
     { E_DESTROYED, { E_DESTROYED, "The window is invisible or destroyed" } },
     { E_NOTSUPPORT, { E_NOTSUPPORT, "The action is not supported on this window" } },
+    { E_CANCELLED, { E_CANCELLED, "The operation was aborted by its signal" } },
+    { E_TIMEOUT, { E_TIMEOUT, "The operation did not finish within timeoutMs" } },
 };
 
 class NError {
@@ -33,6 +33,7 @@ enum NARG_CNT {
     THREE = 3,
     FOUR = 4,
     FIVE = 5,
+    SIX = 6,
 };
 
 enum NARG_POS {
@@ -41,6 +42,7 @@ enum NARG_POS {
     THIRD = 2,
     FOURTH = 3,
     FIFTH = 4,
+    SIXTH = 5,
 };
 
 class NFuncArg final {
@@ -50,12 +52,18 @@ public:
 
     bool InitArgs(size_t argc);
     bool InitArgs(size_t minArgc, size_t maxArgc);
+    // as InitArgs, but a trailing { timeoutMs, signal } object after the required arguments is taken
+    // out of the arguments as the options of the call, see GetCallOptions
+    bool InitArgsWithCallOptions(size_t argc);
+    bool InitArgsWithCallOptions(size_t minArgc, size_t maxArgc);
 
     size_t GetArgc() const;
     napi_value GetThisVar() const;
 
     napi_value operator[](size_t idx) const;
     napi_value GetArg(size_t argPos) const;
+    // trailing { timeoutMs, signal } object of the call, nullptr if absent; it is not counted in argc
+    napi_value GetCallOptions() const;
 
 private:
     napi_env env_ = nullptr;
@@ -64,8 +72,12 @@ private:
     size_t argc_ = 0;
     std::unique_ptr<napi_value[]> argv_ = {nullptr};
     napi_value thisVar_ = nullptr;
+    napi_value callOptions_ = nullptr;
 
     bool InitArgs(std::function<bool()> argcChecker);
+    bool InitArgs(std::function<bool()> argcChecker, bool withCallOptions, size_t minArgc);
+    void StripCallOptions(size_t minArgc);
+    bool IsCallOptions(napi_value value) const;
 
     void SetArgc(size_t argc);
     void SetThisVar(napi_value thisVar);
@@ -65,12 +65,21 @@ public:
     static NVal CreateUint8Array(napi_env env, void *buf, size_t bufLen);
     static std::tuple<NVal, void *> CreateArrayBuffer(napi_env env, size_t len);
 
-    template <class T> static NVal CreateArray(napi_env env, std::vector<std::unique_ptr<T>> vec, std::string className)
+    template <class T> static NVal CreateArray(napi_env env, std::vector<std::unique_ptr<T>> vec, NClassId classId)
     {
         napi_value res = nullptr;
         napi_create_array_with_length(env, vec.size(), &res);
+        // resolve the constructor once for the whole array
+        napi_value cons = NClass::GetConstructor(env, classId);
+        if (cons == nullptr) {
+            return {env, res};
+        }
         for (size_t i = 0; i < vec.size(); i++) {
-            napi_value jsClass = NClass::InstantiateClass(env, className, {});
+            napi_value jsClass = nullptr;
+            if (napi_new_instance(env, cons, 0, nullptr, &jsClass) != napi_ok) {
+                HILOG_ERROR("INNER BUG. Cannot instantiate the class %{public}d", classId);
+                break;
+            }
             NClass::SetEntityFor<T>(env, jsClass, move(vec[i]));
             napi_set_element(env, res, i, jsClass);
         }
@@ -78,6 +87,11 @@ public:
         return {env, res};
     }
 
+    template <class T> static NVal CreateArray(napi_env env, std::vector<std::unique_ptr<T>> vec, std::string className)
+    {
+        return CreateArray(env, move(vec), NClass::GetClassId(className));
+    }
+
     /* SHOULD ONLY BE USED FOR OBJECT */
     bool HasProp(std::string propName) const;
     NVal GetProp(std::string propName) const;
@@ -17,6 +17,7 @@
 #define UITEST_LIBN_UITEST_LIBN_H
 
 #include "n_async_work_callback.h"
+#include "n_async_work_ordered.h"
 #include "n_async_work_promise.h"
 #include "n_class.h"
 #include "n_error.h"
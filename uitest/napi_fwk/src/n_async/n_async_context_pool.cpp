@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "n_async_context_pool.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "utils/log.h"
+#include "node_api.h"
+
+namespace OHOS {
+namespace UiTest {
+namespace LibN {
+using namespace std;
+
+// contexts kept per env, enough for the operations a test keeps in flight at once
+static constexpr size_t MAX_POOLED_CONTEXTS = 64;
+
+struct EnvPool {
+    napi_env env = nullptr;
+    vector<NAsyncContextPromise *> contexts;
+};
+
+static thread_local vector<EnvPool *> g_envPools;
+
+static void RemoveEnv(void *arg);
+
+static EnvPool &GetPool(napi_env env)
+{
+    for (auto pool : g_envPools) {
+        if (pool->env == env) {
+            return *pool;
+        }
+    }
+    auto pool = new EnvPool();
+    pool->env = env;
+    pool->contexts.reserve(MAX_POOLED_CONTEXTS);
+    g_envPools.push_back(pool);
+    napi_add_env_cleanup_hook(env, RemoveEnv, env);
+    return *pool;
+}
+
+static void RemoveEnv(void *arg)
+{
+    auto env = static_cast<napi_env>(arg);
+    auto it = find_if(g_envPools.begin(), g_envPools.end(), [env](EnvPool *pool) { return pool->env == env; });
+    if (it == g_envPools.end()) {
+        return;
+    }
+    for (auto ctx : (*it)->contexts) {
+        if (ctx->awork_ != nullptr) {
+            napi_delete_async_work(env, ctx->awork_);
+        }
+        delete ctx;
+    }
+    delete *it;
+    g_envPools.erase(it);
+}
+
+NAsyncContextPromise *NAsyncContextPool::Acquire(napi_env env, NVal thisPtr)
+{
+    auto &pool = GetPool(env);
+    if (pool.contexts.empty()) {
+        return new NAsyncContextPromise(thisPtr);
+    }
+    auto ctx = pool.contexts.back();
+    pool.contexts.pop_back();
+    ctx->thisPtr_.Reset(thisPtr);
+    return ctx;
+}
+
+void NAsyncContextPool::Release(napi_env env, NAsyncContextPromise *ctx)
+{
+    if (ctx == nullptr) {
+        return;
+    }
+    // drop everything captured by the finished call, keep the work handle
+    ctx->cbExec_ = nullptr;
+    ctx->cbComplete_ = nullptr;
+    ctx->guard_.reset();
+    ctx->res_ = NVal();
+    ctx->err_ = NError(ERRNO_NOERR);
+    ctx->thisPtr_.Reset();
+    ctx->deferred_ = nullptr;
+    ctx->env_ = nullptr;
+    ctx->tsfn_ = nullptr;
+    ctx->settled_ = false;
+    auto &pool = GetPool(env);
+    if (pool.contexts.size() < MAX_POOLED_CONTEXTS) {
+        pool.contexts.push_back(ctx);
+        return;
+    }
+    if (ctx->awork_ != nullptr) {
+        napi_delete_async_work(env, ctx->awork_);
+    }
+    delete ctx;
+}
+} // namespace LibN
+} // namespace UiTest
+} // namespace OHOS
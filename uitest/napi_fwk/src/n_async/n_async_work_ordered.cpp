@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "n_async_work_ordered.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "utils/log.h"
+#include "js_native_api.h"
+#include "n_async_context_pool.h"
+#include "n_async_work_promise.h"
+#include "n_error.h"
+#include "node_api.h"
+
+namespace OHOS {
+namespace UiTest {
+namespace LibN {
+using namespace std;
+
+// one threadsafe function per env, referenced only while some work of the env is in flight.
+// every posted task holds an acquire of tsfn until it has called it
+struct CompletionChannel {
+    napi_threadsafe_function tsfn = nullptr;
+    uint32_t pending = 0;
+    // contexts that could not be delivered, freed on the js thread when the env is cleaned up
+    vector<NAsyncContextPromise *> undelivered;
+};
+
+static mutex g_channelLock;
+static map<napi_env, CompletionChannel> g_channels;
+
+// called on the js thread when a work of env is finished with, lets the loop exit once none is left
+static void DropPending(napi_env env)
+{
+    lock_guard<mutex> guard(g_channelLock);
+    auto find = g_channels.find(env);
+    if (find != g_channels.end() && find->second.pending > 0 && --find->second.pending == 0) {
+        napi_unref_threadsafe_function(env, find->second.tsfn);
+    }
+}
+
+static void OrderedOnComplete(napi_env env, napi_value jsCb, void *context, void *data)
+{
+    auto ctx = static_cast<NAsyncContextPromise *>(data);
+    if (ctx == nullptr) {
+        return;
+    }
+    if (env == nullptr) {
+        // the env is torn down, the promise can never settle
+        delete ctx;
+        return;
+    }
+    DropPending(env);
+    ctx->RunComplete(env);
+    napi_status status = napi_ok;
+    if (ctx->settled_) {
+        // rejected early by the guard, the late result has no promise to go to
+    } else if (!ctx->res_.TypeIsError(true)) {
+        status = napi_resolve_deferred(env, ctx->deferred_, ctx->res_.val_);
+    } else {
+        status = napi_reject_deferred(env, ctx->deferred_, ctx->res_.val_);
+    }
+    if (status != napi_ok) {
+        HILOG_ERROR("Internal BUG, cannot settle promise for %{public}d", status);
+    }
+    NAsyncContextPool::Release(env, ctx);
+}
+
+// runs before the cleanup hook of the tsfn itself, which was added first. once the channel is erased
+// no task touches the tsfn any more, so aborting it cannot race with a late call
+static void ReleaseChannel(void *arg)
+{
+    auto env = static_cast<napi_env>(arg);
+    lock_guard<mutex> guard(g_channelLock);
+    auto find = g_channels.find(env);
+    if (find == g_channels.end()) {
+        return;
+    }
+    for (auto ctx : find->second.undelivered) {
+        delete ctx;
+    }
+    napi_release_threadsafe_function(find->second.tsfn, napi_tsfn_abort);
+    g_channels.erase(find);
+}
+
+// called on the js thread, returns the channel of env with one more work in flight
+static napi_threadsafe_function AcquireChannel(napi_env env)
+{
+    lock_guard<mutex> guard(g_channelLock);
+    auto find = g_channels.find(env);
+    if (find == g_channels.end()) {
+        napi_value resource = NVal::CreateUTF8String(env, "UiTestOrderedComplete").val_;
+        napi_threadsafe_function tsfn = nullptr;
+        napi_status status = napi_create_threadsafe_function(env, nullptr, nullptr, resource, 0, 1, nullptr, nullptr,
+            nullptr, OrderedOnComplete, &tsfn);
+        if (status != napi_ok) {
+            HILOG_ERROR("INNER BUG. Cannot create threadsafe function for %{public}d", status);
+            return nullptr;
+        }
+        napi_unref_threadsafe_function(env, tsfn);
+        napi_add_env_cleanup_hook(env, ReleaseChannel, env);
+        find = g_channels.emplace(env, CompletionChannel { tsfn, 0, {} }).first;
+    }
+    napi_status status = napi_acquire_threadsafe_function(find->second.tsfn);
+    if (status != napi_ok) {
+        HILOG_ERROR("Cannot acquire threadsafe function for %{public}d", status);
+        return nullptr;
+    }
+    if (find->second.pending++ == 0) {
+        // keep the loop alive until the result is delivered
+        napi_ref_threadsafe_function(env, find->second.tsfn);
+    }
+    return find->second.tsfn;
+}
+
+// called on the executor thread, hands ctx to the js thread and drops the acquire of the task
+static void DeliverToChannel(napi_env env, napi_threadsafe_function tsfn, NAsyncContextPromise *ctx)
+{
+    lock_guard<mutex> guard(g_channelLock);
+    auto find = g_channels.find(env);
+    if (find == g_channels.end() || find->second.tsfn != tsfn) {
+        // the env is gone, and the references of ctx with it, nothing can release it safely any more
+        HILOG_ERROR("Cannot deliver, the env is cleaned up");
+        return;
+    }
+    napi_status status = napi_call_threadsafe_function(tsfn, ctx, napi_tsfn_nonblocking);
+    if (status != napi_ok) {
+        // only a closing env refuses the call, its loop no longer needs to be kept alive
+        HILOG_ERROR("Cannot deliver %{public}d, the env is closing", status);
+        find->second.undelivered.push_back(ctx);
+        if (find->second.pending > 0) {
+            find->second.pending--;
+        }
+    }
+    napi_release_threadsafe_function(tsfn, napi_tsfn_release);
+}
+
+// the posted step, runs on the poster's thread
+static void RunOrdered(void *arg)
+{
+    auto ctx = static_cast<NAsyncContextPromise *>(arg);
+    ctx->err_ = ctx->RunExec();
+    DeliverToChannel(ctx->env_, ctx->tsfn_, ctx);
+}
+
+NAsyncWorkOrdered::NAsyncWorkOrdered(napi_env env, NVal thisPtr, const NTaskPoster &poster,
+    unique_ptr<NAsyncGuard> guard)
+    : NAsyncWork(env), thisPtr_(thisPtr), poster_(poster), guard_(move(guard))
+{
+}
+
+NVal NAsyncWorkOrdered::Schedule(string procedureName, NContextCBExec cbExec, NContextCBComplete cbComplete)
+{
+    if (!poster_.CanPost()) {
+        return NAsyncWorkPromise(env_, thisPtr_, move(guard_))
+            .Schedule(move(procedureName), move(cbExec), move(cbComplete));
+    }
+    napi_threadsafe_function tsfn = AcquireChannel(env_);
+    if (tsfn == nullptr) {
+        return NAsyncWorkPromise(env_, thisPtr_, move(guard_))
+            .Schedule(move(procedureName), move(cbExec), move(cbComplete));
+    }
+    auto ctx = NAsyncContextPool::Acquire(env_, thisPtr_);
+    ctx->env_ = env_;
+    ctx->tsfn_ = tsfn;
+    ctx->cbExec_ = move(cbExec);
+    ctx->cbComplete_ = move(cbComplete);
+    ctx->guard_ = move(guard_);
+    napi_value result = nullptr;
+    napi_status status = napi_create_promise(env_, &ctx->deferred_, &result);
+    if (status != napi_ok) {
+        HILOG_ERROR("INNER BUG. Cannot create promise for %{public}d", status);
+        NAsyncContextPool::Release(env_, ctx);
+        // nothing is posted, give back what AcquireChannel took for the task
+        DropPending(env_);
+        napi_release_threadsafe_function(tsfn, napi_tsfn_release);
+        return NVal();
+    }
+    // armed before posting, a guard never races the task it guards
+    ctx->ArmGuard(env_);
+    poster_.Post(RunOrdered, ctx, ctx->taskSlot_);
+    return {env_, result};
+}
+} // namespace LibN
+} // namespace UiTest
+} // namespace OHOS
@@ -22,6 +22,7 @@
 
 #include "utils/log.h"
 #include "js_native_api.h"
+#include "n_async_context_pool.h"
 #include "n_error.h"
 #include "node_api.h"
 
@@ -30,16 +31,16 @@ namespace UiTest {
 namespace LibN {
 using namespace std;
 
-NAsyncWorkPromise::NAsyncWorkPromise(napi_env env, NVal thisPtr) : NAsyncWork(env)
+NAsyncWorkPromise::NAsyncWorkPromise(napi_env env, NVal thisPtr, unique_ptr<NAsyncGuard> guard)
+    : NAsyncWork(env), thisPtr_(thisPtr), guard_(move(guard))
 {
-    ctx_ = new NAsyncContextPromise(thisPtr);
 }
 
 static void PromiseOnExec(napi_env env, void *data)
 {
     auto ctx = static_cast<NAsyncContextPromise *>(data);
-    if (ctx != nullptr && ctx->cbExec_ != nullptr) {
-        ctx->err_ = ctx->cbExec_();
+    if (ctx != nullptr) {
+        ctx->err_ = ctx->RunExec();
     }
 }
 
@@ -49,10 +50,10 @@ static void PromiseOnComplete(napi_env env, napi_status status, void *data)
     if (ctx == nullptr) {
         return;
     }
-    if (ctx->cbComplete_ != nullptr) {
-        ctx->res_ = ctx->cbComplete_(env, ctx->err_);
-    }
-    if (!ctx->res_.TypeIsError(true)) {
+    ctx->RunComplete(env);
+    if (ctx->settled_) {
+        // rejected early by the guard
+    } else if (!ctx->res_.TypeIsError(true)) {
         napi_status status = napi_resolve_deferred(env, ctx->deferred_, ctx->res_.val_);
         if (status != napi_ok) {
             HILOG_ERROR("Internal BUG, cannot resolve promise for %{public}d", status);
@@ -63,38 +64,51 @@ static void PromiseOnComplete(napi_env env, napi_status status, void *data)
             HILOG_ERROR("Internal BUG, cannot reject promise for %{public}d", status);
         }
     }
-    ctx->deferred_ = nullptr;
-    napi_delete_async_work(env, ctx->awork_);
-    delete ctx;
+    // the work handle stays with the context and is queued again by the next call
+    NAsyncContextPool::Release(env, ctx);
 }
 
 NVal NAsyncWorkPromise::Schedule(string procedureName, NContextCBExec cbExec, NContextCBComplete cbComplete)
 {
-    ctx_->cbExec_ = move(cbExec);
-    ctx_->cbComplete_ = move(cbComplete);
+    auto ctx = NAsyncContextPool::Acquire(env_, thisPtr_);
+    ctx->cbExec_ = move(cbExec);
+    ctx->cbComplete_ = move(cbComplete);
+    ctx->guard_ = move(guard_);
 
     napi_status status;
     napi_value result = nullptr;
-    status = napi_create_promise(env_, &ctx_->deferred_, &result);
+    status = napi_create_promise(env_, &ctx->deferred_, &result);
     if (status != napi_ok) {
         HILOG_ERROR("INNER BUG. Cannot create promise for %{public}d", status);
+        NAsyncContextPool::Release(env_, ctx);
         return NVal();
     }
 
-    napi_value resource = NVal::CreateUTF8String(env_, procedureName).val_;
-    status = napi_create_async_work(env_, nullptr, resource, PromiseOnExec, PromiseOnComplete, ctx_, &ctx_->awork_);
-    if (status != napi_ok) {
-        HILOG_ERROR("INNER BUG. Failed to create async work for %{public}d", status);
-        return NVal();
+    if (ctx->awork_ == nullptr) {
+        // a pooled context reuses its work, so the resource name is the one of its first procedure
+        napi_value resource = NVal::CreateUTF8String(env_, procedureName).val_;
+        status = napi_create_async_work(env_, nullptr, resource, PromiseOnExec, PromiseOnComplete, ctx, &ctx->awork_);
+        if (status != napi_ok) {
+            HILOG_ERROR("INNER BUG. Failed to create async work for %{public}d", status);
+            ctx->awork_ = nullptr;
+            NAsyncContextPool::Release(env_, ctx);
+            return NVal();
+        }
     }
 
-    status = napi_queue_async_work(env_, ctx_->awork_);
+    ctx->ArmGuard(env_);
+    status = napi_queue_async_work(env_, ctx->awork_);
     if (status != napi_ok) {
         HILOG_ERROR("INNER BUG. Failed to queue async work for %{public}d", status);
-        return NVal();
+        // the promise exists already, settle it rather than leave it pending forever
+        if (!ctx->settled_) {
+            napi_reject_deferred(env_, ctx->deferred_, NError(EIO).GetNapiErr(env_));
+        }
+        if (ctx->guard_ != nullptr) {
+            ctx->guard_->Complete(env_);
+        }
+        NAsyncContextPool::Release(env_, ctx);
     }
-
-    ctx_ = nullptr; // The ownership of ctx_ has been transferred
     return {env_, result};
 }
 } // namespace LibN
@@ -36,6 +36,19 @@ NRef::~NRef()
     }
 }
 
+void NRef::Reset(NVal val)
+{
+    if (ref_) {
+        napi_delete_reference(env_, ref_);
+        ref_ = nullptr;
+    }
+    env_ = nullptr;
+    if (val) {
+        env_ = val.env_;
+        napi_create_reference(val.env_, val.val_, 1, &ref_);
+    }
+}
+
 NRef::operator bool() const
 {
     return ref_ != nullptr;
@@ -15,6 +15,9 @@
 
 #include "n_class.h"
 
+#include <map>
+#include <mutex>
+
 #include "utils/log.h"
 
 namespace OHOS {
@@ -41,52 +44,118 @@ tuple<bool, napi_value> NClass::DefineClass(napi_env env,
     return {stat == napi_ok, classVal};
 }
 
-bool NClass::SaveClass(napi_env env, string className, napi_value exClass)
+static mutex g_classIdLock;
+
+NClassId NClass::GetClassId(const string& className)
+{
+    static map<string, NClassId> classIds;
+    lock_guard<mutex> guard(g_classIdLock);
+    auto it = classIds.find(className);
+    if (it != classIds.end()) {
+        return it->second;
+    }
+    NClassId classId = static_cast<NClassId>(classIds.size());
+    classIds.emplace(className, classId);
+    return classId;
+}
+
+NClass::EnvClassTable *NClass::FindTable(napi_env env)
 {
+    // almost always a single env per js thread, check the last hit first
+    if (lastTable < envClassTables.size() && envClassTables[lastTable].env == env) {
+        return &envClassTables[lastTable];
+    }
+    for (size_t i = 0; i < envClassTables.size(); i++) {
+        if (envClassTables[i].env == env) {
+            lastTable = i;
+            return &envClassTables[i];
+        }
+    }
+    return nullptr;
+}
+
+void NClass::RemoveEnv(void *arg)
+{
+    auto env = static_cast<napi_env>(arg);
     NClass &nClass = NClass::GetInstance();
-    lock_guard<std::mutex>(nClass.exClassMapLock);
+    auto &tables = nClass.envClassTables;
+    for (auto it = tables.begin(); it != tables.end(); it++) {
+        if (it->env == env) {
+            // the env is going away and releases its references itself
+            tables.erase(it);
+            break;
+        }
+    }
+    nClass.lastTable = 0;
+}
 
-    if (nClass.exClassMap.find(className) != nClass.exClassMap.end()) {
+bool NClass::SaveClass(napi_env env, string className, napi_value exClass)
+{
+    NClass &nClass = NClass::GetInstance();
+    NClassId classId = GetClassId(className);
+    auto table = nClass.FindTable(env);
+    if (table == nullptr) {
+        nClass.envClassTables.push_back({env, {}});
+        table = &nClass.envClassTables.back();
+        napi_add_env_cleanup_hook(env, RemoveEnv, env);
+    }
+    auto &constructors = table->constructors;
+    if (static_cast<size_t>(classId) < constructors.size() && constructors[classId] != nullptr) {
         return true;
     }
 
     napi_ref constructor;
     napi_status res = napi_create_reference(env, exClass, 1, &constructor);
     if (res == napi_ok) {
-        nClass.exClassMap.insert( {className, constructor});
-        HILOG_DEBUG("Class %{public}s has been saved", className.c_str());
+        if (static_cast<size_t>(classId) >= constructors.size()) {
+            constructors.resize(classId + 1, nullptr);
+        }
+        constructors[classId] = constructor;
+        HILOG_DEBUG("Class %{public}s has been saved as %{public}d", className.c_str(), classId);
     } else {
         HILOG_ERROR("INNER BUG. Cannot ref class constructor %{public}s because of %{public}d", className.c_str(), res);
     }
     return res == napi_ok;
 }
 
-napi_value NClass::InstantiateClass(napi_env env, const string& className, const vector<napi_value>& args)
+napi_value NClass::GetConstructor(napi_env env, NClassId classId)
 {
-    NClass &nClass = NClass::GetInstance();
-    lock_guard<std::mutex>(nClass.exClassMapLock);
-
-    auto it = nClass.exClassMap.find(className);
-    if (it == nClass.exClassMap.end()) {
-        HILOG_ERROR("Class %{public}s hasn't been saved yet", className.c_str());
+    auto table = NClass::GetInstance().FindTable(env);
+    if (table == nullptr || classId < 0 || static_cast<size_t>(classId) >= table->constructors.size() ||
+        table->constructors[classId] == nullptr) {
+        HILOG_ERROR("Class %{public}d hasn't been saved yet", classId);
         return nullptr;
     }
 
     napi_value cons = nullptr;
-    napi_status status = napi_get_reference_value(env, it->second, &cons);
+    napi_status status = napi_get_reference_value(env, table->constructors[classId], &cons);
     if (status != napi_ok) {
-        HILOG_ERROR("INNER BUG. Cannot deref class %{public}s because of %{public}d", className.c_str(), status);
+        HILOG_ERROR("INNER BUG. Cannot deref class %{public}d because of %{public}d", classId, status);
+        return nullptr;
+    }
+    return cons;
+}
+
+napi_value NClass::InstantiateClass(napi_env env, NClassId classId, const vector<napi_value>& args)
+{
+    napi_value cons = GetConstructor(env, classId);
+    if (cons == nullptr) {
         return nullptr;
     }
 
     napi_value instance = nullptr;
-    status = napi_new_instance(env, cons, args.size(), args.data(), &instance);
+    napi_status status = napi_new_instance(env, cons, args.size(), args.data(), &instance);
     if (status != napi_ok) {
-        HILOG_ERROR("INNER BUG. Cannot instantiate the class %{public}s because of %{public}d", className.c_str(), status);
+        HILOG_ERROR("INNER BUG. Cannot instantiate the class %{public}d because of %{public}d", classId, status);
         return nullptr;
     }
     return instance;
 }
+
+napi_value NClass::InstantiateClass(napi_env env, const string& className, const vector<napi_value>& args)
+{
+    return InstantiateClass(env, GetClassId(className), args);
+}
 } // namespace LibN
 } // namespace UiTest
 } // namespace OHOS
\ No newline at end of file
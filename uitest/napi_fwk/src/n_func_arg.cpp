@@ -15,6 +15,9 @@
 
 #include "n_func_arg.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "n_error.h"
 #include "utils/log.h"
 
@@ -23,6 +26,10 @@ namespace UiTest {
 namespace LibN {
 using namespace std;
 
+static constexpr const char *CALL_OPTION_NAMES[] = { "timeoutMs", "signal" };
+// longer than any call option name, a longer property name is cut and then matches none
+static constexpr size_t CALL_OPTION_NAME_MAX = 16;
+
 NFuncArg::NFuncArg(napi_env env, napi_callback_info info) : env_(env), info_(info) {}
 
 NFuncArg::~NFuncArg() {}
@@ -56,10 +63,64 @@ napi_value NFuncArg::operator[](size_t argPos) const
     return GetArg(argPos);
 }
 
+napi_value NFuncArg::GetCallOptions() const
+{
+    return callOptions_;
+}
+
+// a plain object whose own properties are all call option names, so an argument object that only
+// happens to carry one of them, e.g. runMonkey({ actions, timeoutMs }), stays an argument
+bool NFuncArg::IsCallOptions(napi_value value) const
+{
+    napi_valuetype type = napi_undefined;
+    bool isArray = false;
+    if (napi_typeof(env_, value, &type) != napi_ok || type != napi_object ||
+        napi_is_array(env_, value, &isArray) != napi_ok || isArray) {
+        return false;
+    }
+    napi_value names = nullptr;
+    uint32_t count = 0;
+    if (napi_get_all_property_names(env_, value, napi_key_own_only,
+        static_cast<napi_key_filter>(napi_key_enumerable | napi_key_skip_symbols), napi_key_numbers_to_strings,
+        &names) != napi_ok || napi_get_array_length(env_, names, &count) != napi_ok || count == 0) {
+        return false;
+    }
+    for (uint32_t index = 0; index < count; index++) {
+        napi_value name = nullptr;
+        char buf[CALL_OPTION_NAME_MAX] = { 0 };
+        size_t len = 0;
+        if (napi_get_element(env_, names, index, &name) != napi_ok ||
+            napi_get_value_string_utf8(env_, name, buf, sizeof(buf), &len) != napi_ok) {
+            return false;
+        }
+        auto known = [&buf](const char *option) { return strcmp(buf, option) == 0; };
+        if (!any_of(begin(CALL_OPTION_NAMES), end(CALL_OPTION_NAMES), known)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// only an argument past the required ones can be the call options
+void NFuncArg::StripCallOptions(size_t minArgc)
+{
+    if (argc_ <= minArgc || !IsCallOptions(argv_[argc_ - 1])) {
+        return;
+    }
+    callOptions_ = argv_[argc_ - 1];
+    argc_--;
+}
+
 bool NFuncArg::InitArgs(std::function<bool()> argcChecker)
+{
+    return InitArgs(move(argcChecker), false, 0);
+}
+
+bool NFuncArg::InitArgs(std::function<bool()> argcChecker, bool withCallOptions, size_t minArgc)
 {
     SetArgc(0);
     argv_.reset();
+    callOptions_ = nullptr;
 
     size_t argc;
     napi_value thisVar;
@@ -78,6 +139,9 @@ bool NFuncArg::InitArgs(std::function<bool()> argcChecker)
     }
     SetArgc(argc);
     SetThisVar(thisVar);
+    if (withCallOptions) {
+        StripCallOptions(minArgc);
+    }
 
     return argcChecker();
 }
@@ -105,6 +169,25 @@ bool NFuncArg::InitArgs(size_t minArgc, size_t maxArgc)
         return true;
     });
 }
+
+bool NFuncArg::InitArgsWithCallOptions(size_t argc)
+{
+    return InitArgsWithCallOptions(argc, argc);
+}
+
+bool NFuncArg::InitArgsWithCallOptions(size_t minArgc, size_t maxArgc)
+{
+    auto checker = [minArgc, maxArgc, this]() {
+        size_t realArgc = GetArgc();
+        if (minArgc > realArgc || maxArgc < realArgc) {
+            HILOG_ERROR("Num of args recved eq %zu while expecting %{public}zu ~ %{public}zu",
+                realArgc, minArgc, maxArgc);
+            return false;
+        }
+        return true;
+    };
+    return InitArgs(checker, true, minArgc);
+}
 } // namespace LibN
 } // namespace UiTest
 } // namespace OHOS
@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UITEST_BENCHMARK_HOST_LOG_H
+#define UITEST_BENCHMARK_HOST_LOG_H
+
+// hilog is not available on the host, logging would only disturb the measurement
+#define HILOG_DEBUG(fmt, ...) ((void)0)
+#define HILOG_INFO(fmt, ...) ((void)0)
+#define HILOG_WARN(fmt, ...) ((void)0)
+#define HILOG_ERROR(fmt, ...) ((void)0)
+
+#endif // UITEST_BENCHMARK_HOST_LOG_H
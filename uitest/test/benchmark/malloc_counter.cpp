@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <dlfcn.h>
+
+// preloaded into node, counts the mallocs of the whole process. the addon reads the count through
+// UiTestBenchMallocCount, found with dlsym, so it works with or without the counter loaded
+static std::atomic<uint64_t> g_mallocCount { 0 };
+
+extern "C" uint64_t UiTestBenchMallocCount()
+{
+    return g_mallocCount.load(std::memory_order_relaxed);
+}
+
+extern "C" void *malloc(size_t size)
+{
+    using MallocFunc = void *(*)(size_t);
+    static MallocFunc realMalloc = reinterpret_cast<MallocFunc>(dlsym(RTLD_NEXT, "malloc"));
+    g_mallocCount.fetch_add(1, std::memory_order_relaxed);
+    return realMalloc(size);
+}
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <dlfcn.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "napi_libn_fwk.h"
+#include "n_async_work_ordered.h"
+#include "n_async_work_promise.h"
+#include "ordered_executor.h"
+
+/**
+ * Node-API addon measuring the napi framework of uitest on the host: the async contexts of promise
+ * calls (mallocs per call) and NVal::CreateArray of wrapped objects (time per element).
+ * Built and driven by run.sh, see napi_fwk_benchmark.js for the workloads.
+ **/
+namespace OHOS::UiTest {
+using namespace std;
+using namespace LibN;
+
+static constexpr const char *BENCH_ITEM_CLASS_NAME = "BenchItem";
+static const NClassId BENCH_ITEM_CLASS_ID = NClass::GetClassId(BENCH_ITEM_CLASS_NAME);
+
+struct BenchItem {
+    int32_t value = 0;
+};
+
+// the class registry as NClass kept it before class ids: constructors by name in a map under a mutex,
+// looked up again for every element. the baseline of the createArray workload
+struct LegacyClassRegistry {
+    map<string, napi_ref> classes;
+    mutex lock;
+};
+
+static LegacyClassRegistry &GetLegacyRegistry()
+{
+    static LegacyClassRegistry registry;
+    return registry;
+}
+
+static napi_value LegacyInstantiateClass(napi_env env, const string& className, const vector<napi_value>& args)
+{
+    auto &registry = GetLegacyRegistry();
+    lock_guard<mutex> guard(registry.lock);
+    auto find = registry.classes.find(className);
+    if (find == registry.classes.end()) {
+        return nullptr;
+    }
+    napi_value cons = nullptr;
+    if (napi_get_reference_value(env, find->second, &cons) != napi_ok) {
+        return nullptr;
+    }
+    napi_value instance = nullptr;
+    if (napi_new_instance(env, cons, args.size(), args.data(), &instance) != napi_ok) {
+        return nullptr;
+    }
+    return instance;
+}
+
+// NVal::CreateArray as it was before class ids, the name is taken by value once per array
+template <class T>
+static napi_value LegacyCreateArray(napi_env env, vector<unique_ptr<T>> items, string className)
+{
+    napi_value array = nullptr;
+    napi_create_array_with_length(env, items.size(), &array);
+    for (size_t index = 0; index < items.size(); index++) {
+        napi_value object = LegacyInstantiateClass(env, className, {});
+        NClass::SetEntityFor<T>(env, object, move(items[index]));
+        napi_set_element(env, array, index, object);
+    }
+    return array;
+}
+
+// no-op ops always run on this executor, so the ordered ones never wait for anything but each other
+static shared_ptr<OrderedExecutor> GetExecutor()
+{
+    static auto executor = make_shared<OrderedExecutor>();
+    return executor;
+}
+
+static napi_value MallocCount(napi_env env, napi_callback_info info)
+{
+    using CountFunc = uint64_t (*)();
+    static auto count = reinterpret_cast<CountFunc>(dlsym(RTLD_DEFAULT, "UiTestBenchMallocCount"));
+    // -1 when node runs without the preloaded counter
+    return NVal::CreateInt64(env, count != nullptr ? static_cast<int64_t>(count()) : -1).val_;
+}
+
+// the poster of the ordered exporters, posting into the task slot of the context
+class BenchPoster : public NTaskPoster {
+public:
+    bool CanPost() const override
+    {
+        return true;
+    }
+
+    void Post(NTaskRun run, void *arg, void *slot) const override
+    {
+        auto node = new (slot) MpscQueue::Node();
+        node->run = run;
+        node->arg = arg;
+        GetExecutor()->Post(node);
+    }
+};
+
+// promiseOp(ordered): an empty call through NAsyncWorkOrdered or NAsyncWorkPromise, resolves to undefined
+static napi_value PromiseOp(napi_env env, napi_callback_info info)
+{
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgs(NARG_CNT::ONE)) {
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    auto [succ, ordered] = NVal(env, funcArg[NARG_POS::FIRST]).ToBool();
+    auto cbExec = []() -> NError { return NError(ERRNO_NOERR); };
+    auto cbComplete = [](napi_env env, NError err) -> NVal { return NVal::CreateUndefined(env); };
+    NVal thisVar(env, funcArg.GetThisVar());
+    if (succ && ordered) {
+        return NAsyncWorkOrdered(env, thisVar, BenchPoster()).Schedule("promiseOp", cbExec, cbComplete).val_;
+    }
+    return NAsyncWorkPromise(env, thisVar).Schedule("promiseOp", cbExec, cbComplete).val_;
+}
+
+static vector<unique_ptr<BenchItem>> MakeItems(int32_t count)
+{
+    vector<unique_ptr<BenchItem>> items;
+    items.reserve(count);
+    for (int32_t index = 0; index < count; index++) {
+        auto item = make_unique<BenchItem>();
+        item->value = index;
+        items.push_back(move(item));
+    }
+    return items;
+}
+
+// createArray(count, perElement): ns spent building the array of count wrapped BenchItems,
+// perElement builds it the way CreateArray did before class ids, see LegacyCreateArray
+static napi_value CreateArray(napi_env env, napi_callback_info info)
+{
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgs(NARG_CNT::TWO)) {
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    auto [succCount, count] = NVal(env, funcArg[NARG_POS::FIRST]).ToInt32();
+    auto [succMode, perElement] = NVal(env, funcArg[NARG_POS::SECOND]).ToBool();
+    if (!succCount || !succMode || count < 0) {
+        NError(E_PARAMS).ThrowErr(env);
+        return nullptr;
+    }
+    auto items = MakeItems(count);
+    auto start = chrono::steady_clock::now();
+    if (perElement) {
+        LegacyCreateArray(env, move(items), BENCH_ITEM_CLASS_NAME);
+    } else {
+        NVal::CreateArray(env, move(items), BENCH_ITEM_CLASS_ID);
+    }
+    auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start);
+    return NVal::CreateInt64(env, elapsed.count()).val_;
+}
+
+static napi_value BenchItemInitializer(napi_env env, napi_callback_info info)
+{
+    NFuncArg funcArg(env, info);
+    funcArg.InitArgs(NARG_CNT::ZERO);
+    return funcArg.GetThisVar();
+}
+
+static napi_value Init(napi_env env, napi_value exports)
+{
+    auto [succ, classValue] = NClass::DefineClass(env, BENCH_ITEM_CLASS_NAME, BenchItemInitializer, {});
+    if (!succ || !NClass::SaveClass(env, BENCH_ITEM_CLASS_NAME, classValue)) {
+        NError(EIO).ThrowErr(env);
+        return nullptr;
+    }
+    napi_ref legacyClass = nullptr;
+    if (napi_create_reference(env, classValue, 1, &legacyClass) != napi_ok) {
+        NError(EIO).ThrowErr(env);
+        return nullptr;
+    }
+    GetLegacyRegistry().classes.emplace(BENCH_ITEM_CLASS_NAME, legacyClass);
+    vector<napi_property_descriptor> props = {
+        NVal::DeclareNapiFunction("mallocCount", MallocCount),
+        NVal::DeclareNapiFunction("promiseOp", PromiseOp),
+        NVal::DeclareNapiFunction("createArray", CreateArray),
+    };
+    NVal(env, exports).AddProp(move(props));
+    return exports;
+}
+} // namespace OHOS::UiTest
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, OHOS::UiTest::Init)
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// usage: node napi_fwk_benchmark.js <addon.node>, with malloc_counter preloaded for the malloc figures
+const bench = require(process.argv[2]);
+
+const PROMISE_OPS = 50000;
+const BATCH_SIZE = 50;
+// more ops in flight than the context pool keeps, the surplus is allocated and freed again
+const OVERFLOW_ROUNDS = 200;
+const OVERFLOW_BATCH = 150;
+const ARRAY_SIZES = [1000, 10000];
+const ARRAY_RUNS = 7;
+
+async function mallocsPerOp(name, ordered, batch) {
+  // one round first so the pool, the executor and the lazy V8 state exist before counting
+  await Promise.all(Array.from({ length: batch }, () => bench.promiseOp(ordered)));
+  const before = bench.mallocCount();
+  for (let done = 0; done < PROMISE_OPS; done += batch) {
+    await Promise.all(Array.from({ length: batch }, () => bench.promiseOp(ordered)));
+  }
+  const mallocs = bench.mallocCount() - before;
+  console.log(`${name.padEnd(32)} ${before < 0 ? 'no counter' : (mallocs / PROMISE_OPS).toFixed(2)} mallocs/op`);
+}
+
+async function overflow(ordered) {
+  let resolved = 0;
+  for (let round = 0; round < OVERFLOW_ROUNDS; round++) {
+    const results = await Promise.all(Array.from({ length: OVERFLOW_BATCH }, () => bench.promiseOp(ordered)));
+    resolved += results.length;
+  }
+  console.log(`overflow ${ordered ? 'ordered' : 'promise'}, resolved ${resolved}/${OVERFLOW_ROUNDS * OVERFLOW_BATCH}`);
+}
+
+function createArray(size, perElement) {
+  let best = Infinity;
+  for (let run = 0; run < ARRAY_RUNS; run++) {
+    // the wrapped objects of the previous run are collected outside the measurement
+    if (global.gc) {
+      global.gc();
+    }
+    best = Math.min(best, bench.createArray(size, perElement));
+  }
+  const mode = perElement ? 'lookup by name (old)' : 'CreateArray';
+  console.log(`${`${mode}, N=${size}`.padEnd(32)} ${(best / size).toFixed(0)} ns/el (best of ${ARRAY_RUNS})`);
+}
+
+(async () => {
+  await mallocsPerOp('promise, sequential', false, 1);
+  await mallocsPerOp(`promise, batches of ${BATCH_SIZE}`, false, BATCH_SIZE);
+  await mallocsPerOp('ordered, sequential', true, 1);
+  await mallocsPerOp(`ordered, batches of ${BATCH_SIZE}`, true, BATCH_SIZE);
+  await overflow(false);
+  await overflow(true);
+  for (const size of ARRAY_SIZES) {
+    createArray(size, true);
+    createArray(size, false);
+  }
+})();
@@ -0,0 +1,32 @@
+#!/bin/sh
+# Copyright (c) 2023 Huawei Device Co., Ltd.
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Host benchmark of the napi framework against Node-API, needs g++ and node with its headers.
+# usage: run.sh [node include dir], default /usr/include/node
+# mallocs/op count every malloc of the process, so they include the ones of Node-API itself
+set -e
+BENCH_DIR=$(cd "$(dirname "$0")" && pwd)
+UITEST_DIR=$(cd "$BENCH_DIR/../.." && pwd)
+NODE_INCLUDE=${1:-/usr/include/node}
+OUT_DIR=$(mktemp -d)
+trap 'rm -rf "$OUT_DIR"' EXIT
+
+g++ -std=c++17 -O2 -shared -fPIC -o "$OUT_DIR/malloc_counter.so" "$BENCH_DIR/malloc_counter.cpp" -ldl
+g++ -std=c++17 -O2 -shared -fPIC -pthread -DFILE_SUBSYSTEM_DEBUG_LOCAL -DNODE_GYP_MODULE_NAME=napi_fwk_benchmark \
+    -I"$BENCH_DIR/host" -I"$NODE_INCLUDE" -I"$UITEST_DIR/napi_fwk/include" -I"$UITEST_DIR/napi_fwk/include/n_async" \
+    -I"$UITEST_DIR/core" -o "$OUT_DIR/napi_fwk_benchmark.node" "$BENCH_DIR/napi_fwk_benchmark.cpp" \
+    "$UITEST_DIR"/napi_fwk/src/*.cpp "$UITEST_DIR"/napi_fwk/src/n_async/*.cpp "$UITEST_DIR/core/cancel_token.cpp" \
+    "$UITEST_DIR/core/event_clock.cpp" "$UITEST_DIR/core/ordered_executor.cpp" "$UITEST_DIR/core/ui_metrics.cpp" -ldl
+LD_PRELOAD="$OUT_DIR/malloc_counter.so" node --expose-gc "$BENCH_DIR/napi_fwk_benchmark.js" \
+    "$OUT_DIR/napi_fwk_benchmark.node"
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "core/event/key_event.h"
+#include "driver.h"
+#include "event_clock.h"
+#include "inject_limiter.h"
+#include "mock_ui_content.h"
+#include "ui_metrics.h"
+
+using namespace std;
+using namespace testing::ext;
+
+namespace OHOS::UiTest {
+static constexpr uint32_t TIMEOUT_MS = 200;
+
+class BackpressureTest : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        MockUIContent::GetInstance().Reset();
+        EventClock::GetInstance().SetVirtual(true, 0);
+        UiMetrics::GetInstance().Reset();
+        InjectLimitOptions options;
+        options.backpressure = true;
+        options.backpressureTimeoutMs = TIMEOUT_MS;
+        InjectLimiter::GetInstance().Configure(options);
+    }
+
+    void TearDown() override
+    {
+        InjectLimiter::GetInstance().Configure(InjectLimitOptions());
+        EventClock::GetInstance().SetVirtual(false);
+    }
+
+    static int64_t Waits()
+    {
+        return UiMetrics::GetInstance().Get(METRIC_BACKPRESSURE_WAIT_COUNT);
+    }
+
+    static int64_t Timeouts()
+    {
+        return UiMetrics::GetInstance().Get(METRIC_BACKPRESSURE_TIMEOUT_COUNT);
+    }
+};
+
+/**
+ * @tc.name: GestureIsOneBatch
+ * @tc.desc: a swipe of many timestamp groups is waited for once, after its last event
+ * @tc.type: FUNC
+ */
+HWTEST_F(BackpressureTest, GestureIsOneBatch, TestSize.Level1)
+{
+    MockUIContent::GetInstance().SetReactive(true);
+    Driver driver;
+    driver.Swipe(100, 500, 700, 500, 600);
+    EXPECT_GT(MockUIContent::GetInstance().TakeTouches().size(), 2u);
+    EXPECT_EQ(Waits(), 1);
+    EXPECT_EQ(Timeouts(), 0);
+}
+
+/**
+ * @tc.name: UnchangedTreeTimesOut
+ * @tc.desc: a tap the ui does not react to holds the configured timeout and is counted as one
+ * @tc.type: FUNC
+ */
+HWTEST_F(BackpressureTest, UnchangedTreeTimesOut, TestSize.Level1)
+{
+    Driver driver;
+    driver.Click(100, 100);
+    auto touches = MockUIContent::GetInstance().TakeTouches();
+    ASSERT_FALSE(touches.empty());
+    EXPECT_EQ(Waits(), 1);
+    EXPECT_EQ(Timeouts(), 1);
+    // the tap ended at the UP, the wait then ran the whole timeout
+    auto upUs = chrono::duration_cast<chrono::microseconds>(touches.back().time.time_since_epoch()).count();
+    EXPECT_GE(EventClock::GetInstance().NowUs(), upUs + MsToUs(TIMEOUT_MS));
+}
+
+/**
+ * @tc.name: KeyTextBursts
+ * @tc.desc: typed text is waited for once per key burst, a key press once for its DOWN and UP
+ * @tc.type: FUNC
+ */
+HWTEST_F(BackpressureTest, KeyTextBursts, TestSize.Level1)
+{
+    MockUIContent::GetInstance().SetReactive(true);
+    Driver driver;
+    driver.TriggerKey(static_cast<int32_t>(Ace::KeyCode::KEY_A));
+    EXPECT_EQ(Waits(), 1);
+    MockUIContent::GetInstance().TakeKeys();
+    UiMetrics::GetInstance().Reset();
+    // not in the tree, so clearing does not fall back to deleting the live text key by key
+    Ace::Platform::ComponentInfo field;
+    field.compid = "field";
+    Component component;
+    component.SetComponentInfo(field);
+    // clearing, two bursts of 16 and one of 8 keys, enter
+    component.InputText(string(40, 'x'), false);
+    EXPECT_EQ(MockUIContent::GetInstance().TakeKeys().size(), 4u + 80u + 2u);
+    EXPECT_EQ(Waits(), 5);
+    EXPECT_EQ(Timeouts(), 0);
+}
+
+/**
+ * @tc.name: OffDoesNotWait
+ * @tc.desc: without backpressure nothing is waited for
+ * @tc.type: FUNC
+ */
+HWTEST_F(BackpressureTest, OffDoesNotWait, TestSize.Level1)
+{
+    InjectLimiter::GetInstance().Configure(InjectLimitOptions());
+    Driver driver;
+    driver.Click(100, 100);
+    driver.TriggerKey(static_cast<int32_t>(Ace::KeyCode::KEY_A));
+    EXPECT_EQ(Waits(), 0);
+}
+} // namespace OHOS::UiTest
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "driver.h"
+#include "mock_ui_content.h"
+
+using namespace std;
+using namespace testing::ext;
+
+namespace OHOS::UiTest {
+using Ace::Platform::ComponentInfo;
+
+static ComponentInfo Node(const string& type, const string& text, int left, int top, int width, int height)
+{
+    ComponentInfo info;
+    info.type = type;
+    info.text = text;
+    info.compid = type + "_" + text;
+    info.left = left;
+    info.top = top;
+    info.width = width;
+    info.height = height;
+    info.clickable = type == "Button";
+    return info;
+}
+
+static On MakeOn(const string& type, const string& text = "")
+{
+    On on;
+    if (!type.empty()) {
+        on.Type(type);
+    }
+    if (!text.empty()) {
+        on.Text(text, MatchPattern::EQUALS);
+    }
+    return on;
+}
+
+class ComponentWalkerTest : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        MockUIContent::GetInstance().Reset();
+        auto root = Node("root", "", 0, 0, 1000, 2000);
+        auto list = Node("List", "", 0, 0, 1000, 1000);
+        list.children.push_back(Node("Button", "a", 0, 0, 100, 50));
+        list.children.push_back(Node("Button", "b", 0, 60, 100, 50));
+        // outside of its parent, not listed, its child overlaps it and is
+        auto hidden = Node("Button", "hidden", 2000, 0, 100, 50);
+        hidden.children.push_back(Node("Text", "inner", 2000, 0, 10, 10));
+        list.children.push_back(hidden);
+        list.children.push_back(Node("Text", "t1", 0, 120, 100, 50));
+        auto column = Node("Column", "", 0, 1000, 1000, 1000);
+        column.children.push_back(Node("Button", "c", 0, 1000, 100, 50));
+        column.children.push_back(Node("Button", "a", 0, 1060, 100, 50));
+        column.children.push_back(Node("Text", "t2", 0, 1120, 100, 50));
+        root.children.push_back(list);
+        root.children.push_back(column);
+        MockUIContent::GetInstance().SetTree(root);
+    }
+
+    // the columns must list what FindComponents finds, in the same order
+    static void ExpectSameAsFindComponents(const On& on, size_t expectedCount)
+    {
+        Driver driver;
+        auto components = driver.FindComponents(on);
+        auto columns = driver.FindComponentColumns(on, COLUMN_ALL);
+        ASSERT_EQ(components.size(), expectedCount);
+        ASSERT_EQ(columns.count, expectedCount);
+        ASSERT_EQ(columns.bounds.size(), expectedCount * 4);
+        for (size_t index = 0; index < expectedCount; index++) {
+            auto attributes = components[index]->GetAttributes();
+            EXPECT_EQ(columns.ids[index], attributes.id) << index;
+            EXPECT_EQ(columns.texts[index], attributes.text) << index;
+            EXPECT_EQ(columns.types[index], attributes.type) << index;
+            EXPECT_EQ(columns.bounds[index * 4], attributes.bounds.left) << index;
+            EXPECT_EQ(columns.bounds[index * 4 + 1], attributes.bounds.top) << index;
+            EXPECT_EQ(columns.bounds[index * 4 + 2], attributes.bounds.right) << index;
+            EXPECT_EQ(columns.bounds[index * 4 + 3], attributes.bounds.bottom) << index;
+            EXPECT_EQ((columns.flags[index] & FLAG_CLICKABLE) != 0, attributes.clickable) << index;
+        }
+        ExpectCursorSameAsFindComponents(on, components);
+    }
+
+    // the cursor hands out the same components, a few at a time, and knows it is done after the last one
+    static void ExpectCursorSameAsFindComponents(const On& on, const vector<unique_ptr<Component>>& components)
+    {
+        auto cursor = Driver().FindComponentsCursor(on);
+        vector<unique_ptr<Component>> streamed;
+        while (!cursor->Done()) {
+            auto batch = cursor->Next(2);
+            ASSERT_FALSE(batch.empty());
+            for (auto& component : batch) {
+                streamed.push_back(move(component));
+            }
+        }
+        EXPECT_TRUE(cursor->Next(2).empty());
+        ASSERT_EQ(streamed.size(), components.size());
+        for (size_t index = 0; index < streamed.size(); index++) {
+            auto expected = components[index]->GetComponentInfo();
+            auto actual = streamed[index]->GetComponentInfo();
+            EXPECT_EQ(actual.compid, expected.compid) << index;
+            EXPECT_EQ(actual.text, expected.text) << index;
+            EXPECT_EQ(actual.children.size(), expected.children.size()) << index;
+        }
+    }
+};
+
+/**
+ * @tc.name: PlainSelector
+ * @tc.desc: nodes outside their parent are skipped, their children are still visited, by columns and cursor
+ * @tc.type: FUNC
+ */
+HWTEST_F(ComponentWalkerTest, PlainSelector, TestSize.Level1)
+{
+    ExpectSameAsFindComponents(MakeOn("Button"), 4);
+    ExpectSameAsFindComponents(MakeOn("Text"), 3);
+    ExpectSameAsFindComponents(MakeOn("Button", "a"), 2);
+    ExpectSameAsFindComponents(MakeOn("Image"), 0);
+}
+
+/**
+ * @tc.name: WithInSelector
+ * @tc.desc: only the subtrees of the withIn matches are searched
+ * @tc.type: FUNC
+ */
+HWTEST_F(ComponentWalkerTest, WithInSelector, TestSize.Level1)
+{
+    auto column = MakeOn("Column");
+    auto button = MakeOn("Button");
+    auto on = MakeOn("Button");
+    ExpectSameAsFindComponents(*on.WithIn(&column), 2);
+    auto text = MakeOn("Text");
+    ExpectSameAsFindComponents(*text.WithIn(&button), 1);
+}
+
+/**
+ * @tc.name: RangeSelector
+ * @tc.desc: isBefore ends at its first match, isAfter starts after its last one, the first node is never before
+ * @tc.type: FUNC
+ */
+HWTEST_F(ComponentWalkerTest, RangeSelector, TestSize.Level1)
+{
+    auto textC = MakeOn("", "c");
+    auto textB = MakeOn("", "b");
+    auto textA = MakeOn("", "a");
+    auto root = MakeOn("root");
+    auto before = MakeOn("Button");
+    ExpectSameAsFindComponents(*before.IsBefore(&textC), 3);
+    auto after = MakeOn("Button");
+    ExpectSameAsFindComponents(*after.IsAfter(&textB), 2);
+    auto afterLast = MakeOn("Button");
+    ExpectSameAsFindComponents(*afterLast.IsAfter(&textA), 0);
+    auto beforeFirst = MakeOn("root");
+    ExpectSameAsFindComponents(*beforeFirst.IsBefore(&root), 0);
+    auto between = MakeOn("Button");
+    ExpectSameAsFindComponents(*between.IsAfter(&textB)->IsBefore(&textC), 1);
+}
+} // namespace OHOS::UiTest
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include "core/event/key_event.h"
+#include "driver.h"
+#include "event_clock.h"
+#include "key_script.h"
+#include "mock_ui_content.h"
+
+using namespace std;
+using namespace testing::ext;
+
+namespace OHOS::UiTest {
+static constexpr int64_t START_US = 1000000;
+static constexpr int64_t HOLD_US = MsToUs(100);
+
+static int64_t TimeUs(const Ace::TouchEvent& event)
+{
+    return chrono::duration_cast<chrono::microseconds>(event.time.time_since_epoch()).count();
+}
+
+class EventClockTest : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        MockUIContent::GetInstance().Reset();
+        EventClock::GetInstance().SetVirtual(true, START_US);
+    }
+
+    void TearDown() override
+    {
+        EventClock::GetInstance().SetVirtual(false);
+    }
+};
+
+/**
+ * @tc.name: VirtualClockSleep
+ * @tc.desc: sleeps move the virtual time at once and never backwards
+ * @tc.type: FUNC
+ */
+HWTEST_F(EventClockTest, VirtualClockSleep, TestSize.Level1)
+{
+    auto& clock = EventClock::GetInstance();
+    ASSERT_TRUE(clock.IsVirtual());
+    clock.SleepForUs(250);
+    EXPECT_EQ(clock.NowUs(), START_US + 250);
+    clock.SleepUntilUs(START_US);
+    EXPECT_EQ(clock.NowUs(), START_US + 250);
+    clock.AdvanceUs(750);
+    EXPECT_EQ(clock.NowUs(), START_US + 1000);
+}
+
+/**
+ * @tc.name: TapStream
+ * @tc.desc: a click is DOWN now and UP after the click hold time, dispatched on the virtual clock
+ * @tc.type: FUNC
+ */
+HWTEST_F(EventClockTest, TapStream, TestSize.Level1)
+{
+    Driver driver;
+    driver.Click(10, 20);
+    auto events = MockUIContent::GetInstance().TakeTouches();
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].type, Ace::TouchType::DOWN);
+    EXPECT_EQ(TimeUs(events[0]), START_US);
+    EXPECT_EQ(events[1].type, Ace::TouchType::UP);
+    EXPECT_EQ(TimeUs(events[1]), START_US + HOLD_US);
+    EXPECT_EQ(events[1].x, 10);
+    EXPECT_EQ(events[1].y, 20);
+    EXPECT_EQ(EventClock::GetInstance().NowUs(), START_US + HOLD_US);
+}
+
+/**
+ * @tc.name: DoubleTapStream
+ * @tc.desc: the second tap of a double click starts one double click interval after the first
+ * @tc.type: FUNC
+ */
+HWTEST_F(EventClockTest, DoubleTapStream, TestSize.Level1)
+{
+    Driver driver;
+    driver.DoubleClick(10, 20);
+    auto events = MockUIContent::GetInstance().TakeTouches();
+    const int64_t intervalUs = MsToUs(200);
+    const int64_t expected[] = { START_US, START_US + HOLD_US, START_US + intervalUs, START_US + intervalUs + HOLD_US };
+    ASSERT_EQ(events.size(), sizeof(expected) / sizeof(expected[0]));
+    for (size_t index = 0; index < events.size(); index++) {
+        EXPECT_EQ(TimeUs(events[index]), expected[index]) << "event " << index;
+        EXPECT_EQ(events[index].type, index % 2 == 0 ? Ace::TouchType::DOWN : Ace::TouchType::UP);
+    }
+}
+
+/**
+ * @tc.name: MultiTapStream
+ * @tc.desc: taps keep a gap after each UP, a tap count above MAX_TAPS injects nothing
+ * @tc.type: FUNC
+ */
+HWTEST_F(EventClockTest, MultiTapStream, TestSize.Level1)
+{
+    Driver driver;
+    driver.MultiClick(10, 20, Driver::MAX_TAPS + 1, 1, 0);
+    EXPECT_TRUE(MockUIContent::GetInstance().TakeTouches().empty());
+    // hold 100ms, the 40ms gap makes the period 140ms although the interval asks for 50ms
+    driver.MultiClick(10, 20, 3, 100, 50);
+    auto events = MockUIContent::GetInstance().TakeTouches();
+    ASSERT_EQ(events.size(), 6u);
+    for (size_t tap = 0; tap < 3; tap++) {
+        EXPECT_EQ(TimeUs(events[tap * 2]), START_US + MsToUs(140) * tap);
+        EXPECT_EQ(TimeUs(events[tap * 2 + 1]), START_US + MsToUs(140) * tap + HOLD_US);
+    }
+}
+
+/**
+ * @tc.name: SwipeStream
+ * @tc.desc: a swipe of 600px at 600px/s lasts one second, its MOVEs are evenly spread over it
+ * @tc.type: FUNC
+ */
+HWTEST_F(EventClockTest, SwipeStream, TestSize.Level1)
+{
+    Driver driver;
+    const int64_t durationUs = US_PER_SECOND;
+    const int64_t steps = 50;
+    driver.Swipe(100, 500, 700, 500, 600);
+    auto events = MockUIContent::GetInstance().TakeTouches();
+    ASSERT_EQ(events.size(), static_cast<size_t>(steps + 1));
+    EXPECT_EQ(events.front().type, Ace::TouchType::DOWN);
+    EXPECT_EQ(TimeUs(events.front()), START_US);
+    for (int64_t step = 1; step < steps; step++) {
+        const auto& event = events[step];
+        EXPECT_EQ(event.type, Ace::TouchType::MOVE);
+        EXPECT_EQ(TimeUs(event), START_US + durationUs * step / steps) << "step " << step;
+        EXPECT_EQ(event.x, 100 + 600 * step / steps);
+    }
+    EXPECT_EQ(events.back().type, Ace::TouchType::UP);
+    EXPECT_EQ(TimeUs(events.back()), START_US + durationUs);
+    EXPECT_EQ(events.back().x, 700);
+}
+
+/**
+ * @tc.name: PinchStaysInWindow
+ * @tc.desc: a spread wider than the window stops at its edge, both fingers end as far from the center
+ * @tc.type: FUNC
+ */
+HWTEST_F(EventClockTest, PinchStaysInWindow, TestSize.Level1)
+{
+    Ace::Platform::ComponentInfo window;
+    window.width = 1000;
+    window.height = 2000;
+    MockUIContent::GetInstance().SetTree(window);
+    Ace::Platform::ComponentInfo info;
+    info.left = 500;
+    info.top = 900;
+    info.width = 400;
+    info.height = 200;
+    Component component;
+    component.SetComponentInfo(info);
+    // from 100px to 400px on each side of x 700, cut at x 999
+    component.Pinch(4.0f, 0.0f);
+    auto events = MockUIContent::GetInstance().TakeTouches();
+    ASSERT_FALSE(events.empty());
+    for (const auto& event : events) {
+        EXPECT_GE(event.x, 0);
+        EXPECT_LT(event.x, window.width);
+        EXPECT_EQ(event.y, 1000);
+    }
+    ASSERT_GE(events.size(), 4u);
+    EXPECT_EQ(events[0].x, 600);
+    EXPECT_EQ(events[1].x, 800);
+    EXPECT_EQ(events[events.size() - 2].x, 401);
+    EXPECT_EQ(events.back().x, 999);
+}
+
+/**
+ * @tc.name: MouseScrollClamped
+ * @tc.desc: wheel ticks beyond MAX_WHEEL_TICKS, INT32_MIN included, scroll as MAX_WHEEL_TICKS do
+ * @tc.type: FUNC
+ */
+HWTEST_F(EventClockTest, MouseScrollClamped, TestSize.Level1)
+{
+    Driver driver;
+    driver.MouseScroll(500, 1000, -Driver::MAX_WHEEL_TICKS);
+    auto bounded = MockUIContent::GetInstance().TakeTouches();
+    ASSERT_FALSE(bounded.empty());
+    const int64_t boundedUs = TimeUs(bounded.back()) - TimeUs(bounded.front());
+    driver.MouseScroll(500, 1000, INT32_MIN);
+    auto clamped = MockUIContent::GetInstance().TakeTouches();
+    ASSERT_EQ(clamped.size(), bounded.size());
+    EXPECT_EQ(TimeUs(clamped.back()) - TimeUs(clamped.front()), boundedUs);
+    EXPECT_EQ(clamped.front().sourceType, Ace::SourceType::MOUSE);
+}
+
+/**
+ * @tc.name: KeyScriptStream
+ * @tc.desc: chords go down together, are held 100ms, released in reverse order, 20ms apart from the next one
+ * @tc.type: FUNC
+ */
+HWTEST_F(EventClockTest, KeyScriptStream, TestSize.Level1)
+{
+    Driver driver;
+    ASSERT_TRUE(driver.TriggerKeys("ctrl+a, b"));
+    auto keys = MockUIContent::GetInstance().TakeKeys();
+    const int32_t ctrl = KeyScript::LookupKey("ctrl");
+    const int32_t keyA = KeyScript::LookupKey("a");
+    const int32_t keyB = KeyScript::LookupKey("b");
+    const int32_t down = static_cast<int32_t>(Ace::KeyAction::DOWN);
+    const int32_t up = static_cast<int32_t>(Ace::KeyAction::UP);
+    const RecordedKey expected[] = {
+        { ctrl, down, KEY_CTRL, START_US },
+        { keyA, down, KEY_CTRL, START_US },
+        { keyA, up, KEY_CTRL, START_US + HOLD_US },
+        { ctrl, up, KEY_CTRL, START_US + HOLD_US },
+        { keyB, down, 0, START_US + MsToUs(120) },
+        { keyB, up, 0, START_US + MsToUs(220) },
+    };
+    ASSERT_EQ(keys.size(), sizeof(expected) / sizeof(expected[0]));
+    for (size_t index = 0; index < keys.size(); index++) {
+        EXPECT_EQ(keys[index].keyCode, expected[index].keyCode) << "key " << index;
+        EXPECT_EQ(keys[index].keyAction, expected[index].keyAction) << "key " << index;
+        EXPECT_EQ(keys[index].metaKey, expected[index].metaKey) << "key " << index;
+        EXPECT_EQ(keys[index].timeUs, expected[index].timeUs) << "key " << index;
+    }
+}
+} // namespace OHOS::UiTest
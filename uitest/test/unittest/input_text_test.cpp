@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "core/event/key_event.h"
+#include "driver.h"
+#include "event_clock.h"
+#include "key_script.h"
+#include "mock_ui_content.h"
+
+using namespace std;
+using namespace testing::ext;
+
+namespace OHOS::UiTest {
+// DOWN and UP of the ctrl+a and del presses ClearText sends first
+static constexpr size_t CLEAR_KEY_EVENTS = 4;
+// DOWN and UP of the enter press InputText ends with
+static constexpr size_t ENTER_KEY_EVENTS = 2;
+
+struct TypedKey {
+    int32_t keyCode;
+    int32_t metaKey;
+    string msg;
+};
+
+class InputTextTest : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        MockUIContent::GetInstance().Reset();
+        EventClock::GetInstance().SetVirtual(true, 0);
+    }
+
+    void TearDown() override
+    {
+        EventClock::GetInstance().SetVirtual(false);
+    }
+
+    // the presses InputText sent between clearing and enter, each checked to be a DOWN followed by the same UP
+    static vector<TypedKey> Type(const string& text, bool paste)
+    {
+        Component component;
+        component.InputText(text, paste);
+        auto keys = MockUIContent::GetInstance().TakeKeys();
+        vector<TypedKey> typed;
+        EXPECT_GE(keys.size(), CLEAR_KEY_EVENTS + ENTER_KEY_EVENTS);
+        if (keys.size() < CLEAR_KEY_EVENTS + ENTER_KEY_EVENTS) {
+            return typed;
+        }
+        EXPECT_EQ(keys.back().keyCode, static_cast<int32_t>(Ace::KeyCode::KEY_ENTER));
+        keys.resize(keys.size() - ENTER_KEY_EVENTS);
+        for (size_t index = CLEAR_KEY_EVENTS; index + 1 < keys.size(); index += 2) {
+            const auto& down = keys[index];
+            const auto& up = keys[index + 1];
+            EXPECT_EQ(down.keyAction, static_cast<int32_t>(Ace::KeyAction::DOWN));
+            EXPECT_EQ(up.keyAction, static_cast<int32_t>(Ace::KeyAction::UP));
+            EXPECT_EQ(down.keyCode, up.keyCode);
+            EXPECT_EQ(down.msg, up.msg);
+            typed.push_back({ down.keyCode, down.metaKey, down.msg });
+        }
+        EXPECT_EQ((keys.size() - CLEAR_KEY_EVENTS) % 2, 0u);
+        return typed;
+    }
+
+    static TypedKey Key(char ch)
+    {
+        TypedKey key = { -1, 0, "" };
+        EXPECT_TRUE(KeyScript::LookupChar(ch, key.keyCode, key.metaKey)) << ch;
+        return key;
+    }
+
+    static TypedKey Paste(const string& text)
+    {
+        return { static_cast<int32_t>(Ace::KeyCode::KEY_V), KEY_CTRL, text };
+    }
+
+    static void ExpectTyped(const vector<TypedKey>& typed, const vector<TypedKey>& expected)
+    {
+        ASSERT_EQ(typed.size(), expected.size());
+        for (size_t index = 0; index < typed.size(); index++) {
+            EXPECT_EQ(typed[index].keyCode, expected[index].keyCode) << "press " << index;
+            EXPECT_EQ(typed[index].metaKey, expected[index].metaKey) << "press " << index;
+            EXPECT_EQ(typed[index].msg, expected[index].msg) << "press " << index;
+        }
+    }
+};
+
+/**
+ * @tc.name: AsciiTable
+ * @tc.desc: symbols use the US layout keys, shifted ones with KEY_SHIFT, control characters have no key
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputTextTest, AsciiTable, TestSize.Level1)
+{
+    int32_t keyCode = 0;
+    int32_t metaKey = 0;
+    const struct {
+        char ch;
+        Ace::KeyCode keyCode;
+        int32_t metaKey;
+    } cases[] = {
+        { 'a', Ace::KeyCode::KEY_A, 0 }, { 'Z', Ace::KeyCode::KEY_Z, KEY_SHIFT }, { '7', Ace::KeyCode::KEY_7, 0 },
+        { '#', Ace::KeyCode::KEY_3, KEY_SHIFT }, { '@', Ace::KeyCode::KEY_2, KEY_SHIFT },
+        { '*', Ace::KeyCode::KEY_8, KEY_SHIFT }, { '+', Ace::KeyCode::KEY_EQUALS, KEY_SHIFT },
+        { '=', Ace::KeyCode::KEY_EQUALS, 0 }, { '~', Ace::KeyCode::KEY_GRAVE, KEY_SHIFT },
+        { ' ', Ace::KeyCode::KEY_SPACE, 0 },
+    };
+    for (const auto& item : cases) {
+        ASSERT_TRUE(KeyScript::LookupChar(item.ch, keyCode, metaKey)) << item.ch;
+        EXPECT_EQ(keyCode, static_cast<int32_t>(item.keyCode)) << item.ch;
+        EXPECT_EQ(metaKey, item.metaKey) << item.ch;
+    }
+    EXPECT_FALSE(KeyScript::LookupChar('\x01', keyCode, metaKey));
+    EXPECT_FALSE(KeyScript::LookupChar('\x7f', keyCode, metaKey));
+    EXPECT_FALSE(KeyScript::LookupChar(static_cast<char>(0xe4), keyCode, metaKey));
+}
+
+/**
+ * @tc.name: AsciiOnlyByKeys
+ * @tc.desc: printable ascii text is typed key by key, nothing is pasted
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputTextTest, AsciiOnlyByKeys, TestSize.Level1)
+{
+    ExpectTyped(Type("aB#1", false), { Key('a'), Key('B'), Key('#'), Key('1') });
+}
+
+/**
+ * @tc.name: MixedTextSplitsIntoRuns
+ * @tc.desc: each run of characters without a key is committed by one paste, the ascii around it by keys
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputTextTest, MixedTextSplitsIntoRuns, TestSize.Level1)
+{
+    ExpectTyped(Type("ab中文c#é", false),
+        { Key('a'), Key('b'), Paste("中文"), Key('c'), Key('#'), Paste("é") });
+}
+
+/**
+ * @tc.name: NonAsciiOnlyIsOnePaste
+ * @tc.desc: text without any typeable character is one paste run
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputTextTest, NonAsciiOnlyIsOnePaste, TestSize.Level1)
+{
+    ExpectTyped(Type("你好", false), { Paste("你好") });
+}
+
+/**
+ * @tc.name: PasteModeIsOnePaste
+ * @tc.desc: with paste the whole text is one paste, whatever it contains
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputTextTest, PasteModeIsOnePaste, TestSize.Level1)
+{
+    ExpectTyped(Type("a中#", true), { Paste("a中#") });
+}
+} // namespace OHOS::UiTest
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mock_ui_content.h"
+
+#include "ability_delegator/ability_delegator_registry.h"
+#include "event_clock.h"
+
+namespace OHOS::AppExecFwk {
+// the driver reaches the ui through the delegator, the tests link this one instead of the ability runtime
+std::shared_ptr<AbilityDelegator> AbilityDelegatorRegistry::GetAbilityDelegator()
+{
+    static auto delegator = std::make_shared<AbilityDelegator>();
+    return delegator;
+}
+
+std::shared_ptr<Ability> AbilityDelegator::GetCurrentTopAbility()
+{
+    static auto ability = std::make_shared<Ability>();
+    return ability;
+}
+
+Ace::Platform::UIContent* AbilityDelegator::GetUIContent(int32_t instanceId)
+{
+    return &UiTest::MockUIContent::GetInstance();
+}
+} // namespace OHOS::AppExecFwk
+
+namespace OHOS::UiTest {
+using namespace std;
+
+MockUIContent& MockUIContent::GetInstance()
+{
+    static MockUIContent content;
+    return content;
+}
+
+void MockUIContent::React()
+{
+    if (reactive_) {
+        root_.text = to_string(++reactions_);
+    }
+}
+
+bool MockUIContent::ProcessBackPressed()
+{
+    lock_guard<mutex> guard(lock_);
+    React();
+    return true;
+}
+
+bool MockUIContent::ProcessBasicEvent(const vector<Ace::TouchEvent>& touchEvents)
+{
+    lock_guard<mutex> guard(lock_);
+    touches_.insert(touches_.end(), touchEvents.begin(), touchEvents.end());
+    React();
+    return true;
+}
+
+bool MockUIContent::ProcessKeyEvent(int32_t keyCode, int32_t keyAction, int32_t repeatTime, int64_t timeStamp,
+    int64_t timeStampStart, int32_t metaKey, int32_t sourceDevice, int32_t deviceId, string msg)
+{
+    lock_guard<mutex> guard(lock_);
+    keys_.push_back({ keyCode, keyAction, metaKey, EventClock::GetInstance().NowUs(), move(msg) });
+    React();
+    return true;
+}
+
+void MockUIContent::GetAllComponents(int64_t nodeID, Ace::Platform::ComponentInfo& components)
+{
+    lock_guard<mutex> guard(lock_);
+    components = root_;
+}
+
+void MockUIContent::Reset()
+{
+    lock_guard<mutex> guard(lock_);
+    root_ = Ace::Platform::ComponentInfo();
+    reactive_ = false;
+    reactions_ = 0;
+    touches_.clear();
+    keys_.clear();
+}
+
+void MockUIContent::SetTree(const Ace::Platform::ComponentInfo& root)
+{
+    lock_guard<mutex> guard(lock_);
+    root_ = root;
+}
+
+void MockUIContent::SetReactive(bool reactive)
+{
+    lock_guard<mutex> guard(lock_);
+    reactive_ = reactive;
+}
+
+vector<Ace::TouchEvent> MockUIContent::TakeTouches()
+{
+    lock_guard<mutex> guard(lock_);
+    return move(touches_);
+}
+
+vector<RecordedKey> MockUIContent::TakeKeys()
+{
+    lock_guard<mutex> guard(lock_);
+    return move(keys_);
+}
+} // namespace OHOS::UiTest
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MOCK_UI_CONTENT_H
+#define MOCK_UI_CONTENT_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "core/event/touch_event.h"
+#include "ui_content.h"
+
+namespace OHOS::UiTest {
+struct RecordedKey {
+    int32_t keyCode = 0;
+    int32_t keyAction = 0;
+    int32_t metaKey = 0;
+    // EventClock time of the injection, key events carry no timestamp of their own
+    int64_t timeUs = 0;
+    std::string msg;
+};
+
+/**
+ * UIContent of the top ability in the unit tests, records what the driver injects
+ * and serves a fixed component tree to snapshots.
+ **/
+class MockUIContent : public Ace::Platform::UIContent {
+public:
+    static MockUIContent& GetInstance();
+    bool ProcessBackPressed() override;
+    bool ProcessBasicEvent(const std::vector<Ace::TouchEvent>& touchEvents) override;
+    bool ProcessKeyEvent(int32_t keyCode, int32_t keyAction, int32_t repeatTime, int64_t timeStamp = 0,
+        int64_t timeStampStart = 0, int32_t metaKey = 0, int32_t sourceDevice = 0, int32_t deviceId = 0,
+        std::string msg = "") override;
+    void GetAllComponents(int64_t nodeID, Ace::Platform::ComponentInfo& components) override;
+
+    void Reset();
+    void SetTree(const Ace::Platform::ComponentInfo& root);
+    // every injection changes the served tree, as a ui reacting to its input does
+    void SetReactive(bool reactive);
+    std::vector<Ace::TouchEvent> TakeTouches();
+    std::vector<RecordedKey> TakeKeys();
+
+private:
+    std::mutex lock_;
+    Ace::Platform::ComponentInfo root_;
+    bool reactive_ = false;
+    uint32_t reactions_ = 0;
+    std::vector<Ace::TouchEvent> touches_;
+    std::vector<RecordedKey> keys_;
+
+    void React();
+};
+} // namespace OHOS::UiTest
+
+#endif // MOCK_UI_CONTENT_H